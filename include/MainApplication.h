@@ -2,9 +2,20 @@
 #define MAIN_APPLICATION_HPP
 
 #include <wx/wx.h>
+#include <memory>
+
+class ConfigFileWatcher;
 
 class MainApplication : public wxApp {
 public:
+    MainApplication();
+    ~MainApplication() override;
+
     bool OnInit() override;
+    int OnExit() override;
+    void OnEventLoopEnter(wxEventLoopBase* loop) override;
+
+private:
+    std::unique_ptr<ConfigFileWatcher> m_configWatcher;
 };
 #endif // MAIN_APPLICATION_HPP
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef CONFIG_CACHE_H
+#define CONFIG_CACHE_H
+
+#include "config/ThemeSnapshot.h"
+#include <wx/string.h>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Fully resolved configuration as stored in a ConfigCache file.
+ */
+struct ConfigCacheData {
+    using SectionValues = std::map<std::string, std::string>;
+
+    std::map<std::string, SectionValues> sections;  // Raw entries exactly as wxFileConfig read them
+    std::vector<std::string> themeSections;         // Sections the compiled themes were built from
+    std::map<std::string, ThemeProfile> themes;     // Empty when the themes were not compiled yet
+};
+
+/**
+ * @class ConfigCache
+ * @brief Binary snapshot of config.ini with the theme profiles pre-parsed.
+ * The file lives in the user local data directory and records the INI size,
+ * modification time and FNV-1a hash; Load() rejects it when any of them no
+ * longer match, so a hand-edited INI always wins. A valid snapshot is read
+ * with a single file read and no string parsing beyond the length prefixes.
+ */
+class ConfigCache {
+public:
+    explicit ConfigCache(const std::string& iniPath);
+
+    /**
+     * @brief Loads the snapshot; returns false if it is missing, stale or corrupt.
+     */
+    bool Load(ConfigCacheData& data) const;
+
+    /**
+     * @brief Writes the snapshot for the INI as it currently is on disk.
+     */
+    bool Store(const ConfigCacheData& data) const;
+
+    const wxString& GetCachePath() const { return cachePath; }
+
+private:
+    struct IniStamp {
+        uint64_t size = 0;
+        uint64_t mtimeMs = 0;
+        uint64_t hash = 0;
+    };
+
+    bool ReadIniStamp(IniStamp& stamp, bool withHash) const;
+
+    std::string iniPath;
+    wxString cachePath;
+};
+
+#endif // CONFIG_CACHE_H
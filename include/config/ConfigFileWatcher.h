@@ -0,0 +1,36 @@
+#ifndef CONFIG_FILE_WATCHER_H
+#define CONFIG_FILE_WATCHER_H
+
+#include <wx/event.h>
+#include <wx/filename.h>
+#include <wx/fswatcher.h>
+#include <wx/timer.h>
+#include <memory>
+
+/**
+ * @class ConfigFileWatcher
+ * @brief Reloads config.ini live while it is being edited.
+ * Watches the directory holding the file, since editors often save through a
+ * temporary file and rename. Bursts of events are debounced, then only the
+ * keys that differ are handed to ThemeManager::applyConfigChanges. Saves made
+ * by ConfigManager itself produce an empty diff and are ignored. Must be
+ * started once the event loop runs; UI thread only.
+ */
+class ConfigFileWatcher : public wxEvtHandler {
+public:
+    explicit ConfigFileWatcher(const wxString& configFilePath, int debounceMs = 200);
+    ~ConfigFileWatcher() override;
+
+    bool Start();
+
+private:
+    void OnFileSystemEvent(wxFileSystemWatcherEvent& event);
+    void OnDebounceTimer(wxTimerEvent& event);
+
+    wxFileName m_configFile;
+    std::unique_ptr<wxFileSystemWatcher> m_watcher;
+    wxTimer m_debounceTimer;
+    int m_debounceMs;
+};
+
+#endif // CONFIG_FILE_WATCHER_H
@@ -1,20 +1,39 @@
 #ifndef CONFIG_MANAGER_H
 #define CONFIG_MANAGER_H
 
+#include "config/ConfigCache.h"
+#include "config/DeferredFileWriter.h"
 #include <wx/fileconf.h>
 #include <string>
 #include <memory>
 #include <vector>
 
+// One key that was added, removed or modified by a reload
+struct ConfigChange {
+    std::string section;
+    std::string key;
+};
+
 class ConfigManager {
 private:
     bool initialized;
     std::string configFilePath;
-    std::unique_ptr<wxFileConfig> fileConfig;
+    std::unique_ptr<wxFileConfig> fileConfig;  // Created lazily; reads are served from cache.sections
+    std::unique_ptr<ConfigCache> snapshot;
+    ConfigCacheData cache;
+    bool dirty;          // Values written since the last save
+    bool snapshotStale;  // The on-disk snapshot no longer matches cache
+    std::unique_ptr<DeferredFileWriter> writer;  // Write-behind saves; null when [ConfigManager] SaveDelayMs is 0
 
     ConfigManager();
     ~ConfigManager();
     std::string findConfigFile();
+    wxFileConfig& getFileConfig();
+    void loadValuesFromFile();
+    const std::string* findValue(const std::string& section, const std::string& key) const;
+    bool writeValue(const std::string& section, const std::string& key, const std::string& text);
+    void storeSnapshot();
+    void onWriteCompleted(bool ok);
 
 public:
     static ConfigManager& getInstance();
@@ -28,11 +47,24 @@ public:
     void setInt(const std::string& section, const std::string& key, int value);
     void setDouble(const std::string& section, const std::string& key, double value);
     void setBool(const std::string& section, const std::string& key, bool value);
+    // Queues the INI for a debounced background write when write-behind is enabled
     bool save();
+    // Writes anything still pending and stops the writer thread; later saves are synchronous
+    void shutdown();
     bool reload();
+    // Re-reads the file and returns only the keys that differ from the loaded values.
+    // Returns nothing while a background write is pending; that write triggers the next reload
+    std::vector<ConfigChange> reloadChanges();
     std::string getConfigFilePath() const;
     std::vector<std::string> getSections();
     std::vector<std::string> getKeys(const std::string& section);
+    // All raw entries of a section without copying, or nullptr; invalidated by the next set or reload
+    const ConfigCacheData::SectionValues* getSection(const std::string& section) const;
+
+    // Compiled theme profiles from the config snapshot; false when they must be rebuilt
+    bool getPrecompiledThemes(std::map<std::string, ThemeProfile>& themes) const;
+    // Persists compiled profiles; writing to any of the given sections invalidates them
+    void setPrecompiledThemes(const std::map<std::string, ThemeProfile>& themes, const std::vector<std::string>& sections);
 };
 
 #endif // CONFIG_MANAGER_H
\ No newline at end of file
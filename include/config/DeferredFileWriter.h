@@ -0,0 +1,65 @@
+#ifndef DEFERRED_FILE_WRITER_H
+#define DEFERRED_FILE_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @class DeferredFileWriter
+ * @brief Writes a file on a background thread after a quiet period.
+ * Each Submit() replaces the pending content and restarts the debounce window,
+ * so a burst of changes costs one write. The file is replaced atomically
+ * through a temporary file and a rename. Destruction writes whatever is still
+ * pending. Depends on the standard library only.
+ */
+class DeferredFileWriter {
+public:
+    // Runs on the writer thread after each write attempt, once IsIdle() reflects it
+    using CompletionCallback = std::function<void(bool ok)>;
+
+    DeferredFileWriter(std::string path, std::chrono::milliseconds debounce, CompletionCallback onWritten = nullptr);
+    ~DeferredFileWriter();
+
+    DeferredFileWriter(const DeferredFileWriter&) = delete;
+    DeferredFileWriter& operator=(const DeferredFileWriter&) = delete;
+
+    void Submit(std::string content);
+
+    /**
+     * @brief Writes pending content now and waits for it; returns the result of the last write.
+     */
+    bool Flush();
+
+    // True when nothing is pending or being written
+    bool IsIdle() const;
+    uint64_t GetWriteCount() const;
+
+    static bool WriteAtomically(const std::string& path, const std::string& content);
+
+private:
+    void WorkerLoop();
+
+    std::string m_path;
+    std::chrono::milliseconds m_debounce;
+    CompletionCallback m_onWritten;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_idleCv;
+    std::string m_pending;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_hasPending = false;
+    bool m_writing = false;
+    bool m_flushRequested = false;
+    bool m_stopping = false;
+    bool m_lastResult = true;
+    uint64_t m_writeCount = 0;
+    std::thread m_thread;
+};
+
+#endif // DEFERRED_FILE_WRITER_H
@@ -0,0 +1,76 @@
+#ifndef ICON_ARCHIVE_H
+#define ICON_ARCHIVE_H
+
+#include "config/MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class IconArchive
+ * @brief Read-only view of a packed icon archive (see IconArchiveWriter).
+ * The whole archive is memory-mapped once; payloads are returned as views
+ * into the mapping, so loading every icon costs one open and no copies.
+ * Each entry is an icon name plus a variant: the empty variant holds the
+ * original SVG, a "#rrggbb" variant the markup pre-themed for that colour.
+ * Immutable once opened. Depends on the standard library only.
+ *
+ * Layout (little-endian):
+ *   header  : magic[8] "FLIPAK\0\1", u32 version, u32 entryCount, u64 fileSize
+ *   index   : entryCount x { u32 keyOffset, u16 nameLength, u16 variantLength, u32 dataOffset, u32 dataLength }
+ *   strings : name bytes immediately followed by variant bytes, per entry
+ *   payloads: concatenated SVG markup
+ */
+class IconArchive {
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    struct Entry {
+        std::string_view name;
+        std::string_view variant;
+        std::string_view data;
+    };
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_file.IsOpen(); }
+    const std::string& GetPath() const { return m_path; }
+
+    // Finds the payload for an icon; an empty variant is the unthemed source
+    bool Find(std::string_view name, std::string_view variant, std::string_view& data) const;
+
+    // Entries sorted by name, then variant
+    const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+private:
+    MappedFile m_file;
+    std::string m_path;
+    std::vector<Entry> m_entries;
+};
+
+/**
+ * @class IconArchiveWriter
+ * @brief Builds an IconArchive file; used by the IconPacker tool.
+ */
+class IconArchiveWriter {
+public:
+    void Add(std::string name, std::string variant, std::string data);
+
+    // Writes to a temporary file and renames it over the target
+    bool Write(const std::string& path, std::string* error = nullptr) const;
+
+    size_t GetEntryCount() const { return m_entries.size(); }
+
+private:
+    struct PendingEntry {
+        std::string name;
+        std::string variant;
+        std::string data;
+    };
+
+    std::vector<PendingEntry> m_entries;
+};
+
+#endif // ICON_ARCHIVE_H
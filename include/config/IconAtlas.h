@@ -0,0 +1,98 @@
+#ifndef ICON_ATLAS_H
+#define ICON_ATLAS_H
+
+#include <wx/wx.h>
+#include <memory>
+#include <vector>
+
+class IconAtlas;
+
+/**
+ * @brief Lightweight reference to one icon inside an IconAtlas.
+ * Copying a handle shares the atlas; no per-icon bitmap or GDI object exists.
+ */
+struct IconAtlasHandle {
+    std::shared_ptr<IconAtlas> atlas;
+    wxRect rect;
+
+    bool IsOk() const { return atlas != nullptr && rect.width > 0 && rect.height > 0; }
+    wxSize GetSize() const { return rect.GetSize(); }
+};
+
+/**
+ * @class IconAtlas
+ * @brief Packs many small icons into one shared bitmap surface.
+ * Icons are placed with a shelf packer into a fixed-width page that grows in
+ * height as needed; existing sub-rects never move. Pixels are kept in a
+ * wxImage and the wxBitmap surface is rebuilt lazily on the next draw, so a
+ * burst of additions costs a single bitmap upload. UI thread only.
+ */
+class IconAtlas : public std::enable_shared_from_this<IconAtlas> {
+public:
+    static std::shared_ptr<IconAtlas> Create(int pageWidth = 512, int maxHeight = 4096);
+
+    /**
+     * @brief Copies an icon into the atlas; returns an invalid handle if it does not fit.
+     */
+    IconAtlasHandle Add(const wxImage& image);
+    IconAtlasHandle Add(const wxBitmap& bitmap);
+
+    /**
+     * @brief Reserves a fully transparent slot, e.g. for placeholders.
+     */
+    IconAtlasHandle AddEmpty(const wxSize& size);
+
+    /**
+     * @brief Gets the shared surface, uploading pending additions first.
+     */
+    const wxBitmap& GetSurface();
+
+    size_t GetIconCount() const { return m_iconCount; }
+    wxSize GetSurfaceSize() const { return wxSize(m_width, m_height); }
+
+private:
+    IconAtlas(int pageWidth, int maxHeight);
+
+    struct Shelf {
+        int y;
+        int height;
+        int nextX;
+    };
+
+    bool Allocate(const wxSize& size, wxRect& rect);
+    bool Grow(int requiredHeight);
+
+    int m_width;
+    int m_height = 0;
+    int m_maxHeight;
+    int m_usedHeight = 0;
+    size_t m_iconCount = 0;
+    std::vector<Shelf> m_shelves;
+    wxImage m_pixels;
+    wxBitmap m_surface;
+    bool m_dirty = false;
+};
+
+/**
+ * @class IconAtlasPainter
+ * @brief Blits atlas icons onto a DC for the duration of one paint.
+ * The atlas surface is selected into a memory DC only when the atlas changes
+ * between draws, so a whole ribbon bar costs one selection per atlas.
+ */
+class IconAtlasPainter {
+public:
+    explicit IconAtlasPainter(wxDC& target);
+    ~IconAtlasPainter();
+
+    IconAtlasPainter(const IconAtlasPainter&) = delete;
+    IconAtlasPainter& operator=(const IconAtlasPainter&) = delete;
+
+    void Draw(const IconAtlasHandle& icon, int x, int y);
+
+private:
+    wxDC& m_target;
+    wxMemoryDC m_source;
+    std::shared_ptr<IconAtlas> m_selected;
+};
+
+#endif // ICON_ATLAS_H
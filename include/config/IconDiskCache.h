@@ -0,0 +1,65 @@
+#ifndef ICON_DISK_CACHE_H
+#define ICON_DISK_CACHE_H
+
+#include <wx/wx.h>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class IconDiskCache
+ * @brief Persistent cache of rasterized SVG icons as raw RGBA files.
+ * Entries are keyed by icon name, pixel size, theme tag and display scale, and
+ * stamped with the source SVG's modification time and size; a changed source
+ * is detected on load and the entry is rebuilt. Files are memory-mapped on
+ * load, so warm starts skip SVG parsing and rasterization entirely.
+ */
+class IconDiskCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t stale = 0;
+        uint64_t writes = 0;
+    };
+
+    explicit IconDiskCache(const wxString& dir);
+
+    bool IsAvailable() const { return available; }
+    const wxString& GetDirectory() const { return cacheDir; }
+
+    /**
+     * @brief Loads a cached raster, or returns an invalid bitmap on a miss or stale entry.
+     */
+    wxBitmap Load(const wxString& name, const wxSize& size, const wxString& themeTag, const wxString& sourcePath);
+
+    /**
+     * @brief Stores a raster for the given key, replacing any previous entry.
+     */
+    void Store(const wxString& name, const wxSize& size, const wxString& themeTag, const wxString& sourcePath, const wxBitmap& bitmap);
+
+    /**
+     * @brief Stores an image for the given key; safe to call from raster worker threads.
+     */
+    void Store(const wxString& name, const wxSize& size, const wxString& themeTag, const wxString& sourcePath, const wxImage& image);
+
+    Stats GetStats() const;
+
+private:
+    struct SourceStamp {
+        uint64_t mtimeMs = 0;
+        uint64_t size = 0;
+    };
+
+    wxString GetEntryPath(const wxString& name, const wxSize& size, uint64_t keyHash) const;
+    uint64_t HashKey(const wxString& name, const wxSize& size, const wxString& themeTag) const;
+    static bool GetSourceStamp(const wxString& sourcePath, SourceStamp& stamp);
+
+    wxString cacheDir;
+    double scaleFactor = 1.0;
+    bool available = false;
+    Stats stats; // Load counters, UI thread only
+    std::atomic<uint64_t> writes{0}; // Stores may also come from worker threads
+    std::atomic<unsigned int> tempSerial{0}; // Makes temp file names unique per write
+};
+
+#endif // ICON_DISK_CACHE_H
@@ -12,6 +12,9 @@ public:
 private:
     LoggerConfig() = default;
     void configureLoggerLevels(const std::string& logLevelStr);
+    void configureSinks(ConfigManager& configManager);
+    void configureRotation(ConfigManager& configManager);
+    void configureAsync(ConfigManager& configManager);
 };
 
 #endif // LOGGER_CONFIG_H
\ No newline at end of file
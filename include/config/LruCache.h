@@ -0,0 +1,164 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @class LruCache
+ * @brief Least-recently-used cache bounded by a byte budget.
+ * Each entry carries a cost (bytes) from the cost function or the explicit Put
+ * overload; inserting past the budget evicts from the cold end. The most recent
+ * entry is always kept, even if it alone exceeds the budget. Hit, miss and
+ * eviction counters are kept for runtime inspection. Not thread-safe.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    using CostFunction = std::function<size_t(const Value&)>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t insertions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t budget = 0;
+    };
+
+    explicit LruCache(size_t byteBudget, CostFunction cost = nullptr)
+        : m_budget(byteBudget), m_cost(std::move(cost)) {}
+
+    // Returns the cached value and marks it most recently used, or nullptr on a miss.
+    // The pointer stays valid until the entry is evicted or erased.
+    Value* Find(const Key& key) {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            ++m_misses;
+            return nullptr;
+        }
+        ++m_hits;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->value;
+    }
+
+    // Lookup without touching recency or counters
+    bool Contains(const Key& key) const {
+        return m_index.find(key) != m_index.end();
+    }
+
+    void Put(const Key& key, Value value) {
+        size_t cost = m_cost ? m_cost(value) : 1;
+        Put(key, std::move(value), cost);
+    }
+
+    void Put(const Key& key, Value value, size_t cost) {
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            m_bytes -= it->second->cost;
+            it->second->value = std::move(value);
+            it->second->cost = cost;
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+        } else {
+            m_entries.push_front(Entry{ key, std::move(value), cost });
+            m_index.emplace(key, m_entries.begin());
+        }
+        m_bytes += cost;
+        ++m_insertions;
+        EvictToBudget();
+    }
+
+    bool Erase(const Key& key) {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            return false;
+        }
+        m_bytes -= it->second->cost;
+        m_entries.erase(it->second);
+        m_index.erase(it);
+        return true;
+    }
+
+    // Removes every entry for which pred(key, value) is true; returns the count
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        size_t removed = 0;
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (pred(it->key, it->value)) {
+                m_bytes -= it->cost;
+                m_index.erase(it->key);
+                it = m_entries.erase(it);
+                ++removed;
+            } else {
+                ++it;
+            }
+        }
+        return removed;
+    }
+
+    void Clear() {
+        m_entries.clear();
+        m_index.clear();
+        m_bytes = 0;
+    }
+
+    void SetBudget(size_t byteBudget) {
+        m_budget = byteBudget;
+        EvictToBudget();
+    }
+
+    size_t GetBudget() const { return m_budget; }
+    size_t GetBytes() const { return m_bytes; }
+    size_t Size() const { return m_index.size(); }
+    bool Empty() const { return m_index.empty(); }
+
+    Stats GetStats() const {
+        Stats stats;
+        stats.hits = m_hits;
+        stats.misses = m_misses;
+        stats.evictions = m_evictions;
+        stats.insertions = m_insertions;
+        stats.entries = m_index.size();
+        stats.bytes = m_bytes;
+        stats.budget = m_budget;
+        return stats;
+    }
+
+    void ResetStats() {
+        m_hits = m_misses = m_evictions = m_insertions = 0;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        size_t cost;
+    };
+
+    void EvictToBudget() {
+        while (m_bytes > m_budget && m_entries.size() > 1) {
+            Entry& victim = m_entries.back();
+            m_bytes -= victim.cost;
+            m_index.erase(victim.key);
+            m_entries.pop_back();
+            ++m_evictions;
+        }
+    }
+
+    std::list<Entry> m_entries; // Most recently used first
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> m_index;
+    size_t m_budget;
+    size_t m_bytes = 0;
+    CostFunction m_cost;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    uint64_t m_insertions = 0;
+};
+
+#endif // LRU_CACHE_H
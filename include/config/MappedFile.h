@@ -0,0 +1,46 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ * The mapping stays valid until Close() or destruction. Empty files open
+ * successfully with a null Data(). Depends on the standard library and the
+ * platform mapping API only.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_open; }
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    void MoveFrom(MappedFile& other) noexcept;
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+#ifdef _WIN32
+    void* m_file = nullptr;     // HANDLE
+    void* m_mapping = nullptr;  // HANDLE
+#else
+    int m_fd = -1;
+#endif
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,51 @@
+#ifndef SVG_COLOR_REWRITER_H
+#define SVG_COLOR_REWRITER_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SvgColorRewriter
+ * @brief Single-pass SVG recolouring without std::regex.
+ * Walks the markup once, tokenizing tags and attributes, and in the same scan:
+ *  - replaces non-light fill/stroke attribute colours with the target colour,
+ *  - replaces non-light fill/stroke declarations inside style attributes,
+ *  - adds a default fill to <g> elements that carry neither fill nor stroke,
+ *  - wraps bare top-level <path> content in a filled <g>.
+ * Colour decisions are memoised per distinct value, so icons sharing a palette
+ * only classify each colour once. Depends on the standard library only.
+ */
+class SvgColorRewriter {
+public:
+    explicit SvgColorRewriter(const std::string& targetColour);
+
+    // When colourSlots is given, the output offset of every inserted target colour is appended to it
+    std::string Rewrite(std::string_view svg, std::vector<size_t>* colourSlots = nullptr);
+
+    const std::string& GetTargetColour() const { return m_target; }
+
+    // True for dark/medium colours and unrecognised values, false for light ones and none/transparent
+    static bool ShouldReplaceColour(std::string_view value);
+
+    // Perceived brightness 0-255, or -1 if the value is not a recognised colour
+    static int ColourBrightness(std::string_view value);
+
+private:
+    bool ShouldReplaceCached(std::string_view value);
+    void RewriteTag(std::string_view svg, size_t& pos, std::string& out);
+    void RewriteStyle(std::string_view style, std::string& out);
+    static bool NeedsGroupWrapper(std::string_view svg, size_t innerBegin);
+    void AppendTarget(std::string& out);
+
+    std::string m_target;
+    std::unordered_map<std::string, bool> m_decisions;
+
+    // Per-document state
+    bool m_seenSvgRoot = false;
+    bool m_wrapOpen = false;
+    std::vector<size_t>* m_slots = nullptr;
+};
+
+#endif // SVG_COLOR_REWRITER_H
@@ -0,0 +1,38 @@
+#ifndef SVG_COLOR_TEMPLATE_H
+#define SVG_COLOR_TEMPLATE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class SvgColorTemplate
+ * @brief An SVG icon pre-compiled for recolouring.
+ * Which fills and strokes get replaced only depends on the source colours, so
+ * the markup is scanned once by SvgColorRewriter and kept as literal text with
+ * the colour slots marked. Applying a theme splices the colour into the slots
+ * without any scanning. Immutable after construction, so one template can be
+ * shared across threads. Depends on the standard library only.
+ */
+class SvgColorTemplate {
+public:
+    SvgColorTemplate() = default;
+    explicit SvgColorTemplate(std::string source);
+
+    // Markup with every colour slot filled with the given colour
+    std::string Apply(std::string_view colour) const;
+
+    // Original, unthemed markup
+    const std::string& GetSource() const { return m_source; }
+
+    bool IsEmpty() const { return m_source.empty(); }
+    size_t GetSlotCount() const { return m_slots.size(); }
+    size_t GetMemoryCost() const { return m_source.size() + m_text.size() + m_slots.size() * sizeof(size_t); }
+
+private:
+    std::string m_source;
+    std::string m_text; // Rewritten markup with empty colour slots
+    std::vector<size_t> m_slots; // Ascending offsets into m_text
+};
+
+#endif // SVG_COLOR_TEMPLATE_H
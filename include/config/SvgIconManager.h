@@ -4,8 +4,17 @@
 #include <wx/wx.h>
 #include <wx/dir.h>
 #include <wx/bmpbndl.h>  // Use wxBitmapBundle instead of wxSVG
+#include "config/SvgColorTemplate.h"
+#include "config/IconDiskCache.h"
+#include "config/IconArchive.h"
+#include "config/SvgRasterWorkerPool.h"
+#include "config/IconAtlas.h"
+#include "config/LruCache.h"
+#include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
+#include <vector>
 
 /**
  * @class SvgIconManager
@@ -14,11 +23,48 @@
  * Supports caching and singleton pattern for better performance.
  */
 class SvgIconManager {
+public:
+    using IconReadyCallback = std::function<void(const wxBitmap&)>;
+    using BitmapCache = LruCache<wxString, wxBitmap>;
+    using BundleCache = LruCache<wxString, wxBitmapBundle>;
+    using TextCache = LruCache<wxString, wxString>;
+
+    struct CacheStats {
+        BitmapCache::Stats bitmaps;
+        BundleCache::Stats bundles;
+        TextCache::Stats themedSvg;
+    };
+
 private:
-    std::map<wxString, wxString> iconMap; // Maps icon names to file paths
-    std::map<wxString, wxBitmap> iconCache; // Cache for rendered bitmaps
-    std::map<wxString, wxBitmapBundle> bundleCache; // Cache for bitmap bundles
-    std::map<wxString, wxString> themedSvgCache; // Cache for theme-processed SVG content
+    /**
+     * @brief Everything that depends on the theme's icon colouring.
+     * One set is active; sets prewarmed for other themes are swapped in whole on a switch.
+     */
+    struct ThemedIconSet {
+        ThemedIconSet();
+
+        std::string themeName;
+        wxString tag; // Identifies the icon colouring in disk cache keys; empty until resolved
+        BitmapCache iconCache; // Rendered bitmaps, cost = width * height * 4
+        BundleCache bundleCache; // Bitmap bundles, cost = SVG source length
+        TextCache themedSvgCache; // Theme-processed SVG content, cost = text length
+        std::map<wxString, std::shared_ptr<IconAtlas>> iconAtlases; // Themed SVG icons, one atlas per size
+        std::map<wxString, IconAtlasHandle> atlasEntries; // Packed SVG icons and placeholders by cache key
+        size_t pendingWarmJobs = 0; // Prewarm rasterizations still in flight
+        std::chrono::steady_clock::time_point warmStarted;
+    };
+
+    std::map<wxString, wxString> iconMap; // Maps icon names to file paths (the archive path for packed icons)
+    IconArchive iconArchive; // Memory-mapped icons.pack, open when present next to the icon directory
+    std::shared_ptr<ThemedIconSet> themed; // Caches for the current theme
+    std::map<std::string, std::shared_ptr<ThemedIconSet>> warmThemes; // Prewarmed or recently used sets by theme name
+    std::map<wxString, std::pair<wxString, wxSize>> iconUsage; // Icons rendered so far by cache key, i.e. what to prewarm
+    std::map<wxString, std::shared_ptr<const SvgColorTemplate>> svgTemplates; // Parsed SVG per icon, shared by all themes
+    std::unique_ptr<IconDiskCache> diskCache; // Persistent rasters, null when disabled
+    std::unique_ptr<SvgRasterWorkerPool> rasterPool; // Created on the first async request
+    std::map<wxString, std::vector<IconReadyCallback>> pendingRequests; // In-flight rasterizations by cache key
+    std::shared_ptr<IconAtlas> bitmapAtlas; // Theme-independent bitmaps packed for controls
+    unsigned int themeGeneration = 0; // Bumped when themed content is invalidated
     wxString iconDir; // Directory containing SVG files
     static std::unique_ptr<SvgIconManager> instance;
     static wxString defaultIconDir;
@@ -34,85 +80,70 @@ private:
     wxString GetCacheKey(const wxString& name, const wxSize& size) const;
 
     /**
-     * @brief Gets or creates a bitmap bundle for the specified icon.
+     * @brief Gets the tag identifying the current theme's icon colouring for disk cache keys.
      */
-    wxBitmapBundle GetBitmapBundle(const wxString& name);
+    const wxString& GetThemeCacheTag();
 
     /**
-     * @brief Applies theme colors to SVG content.
-     * @param svgContent The original SVG content string.
-     * @return Theme-processed SVG content string.
+     * @brief Packs an image into the set's atlas for its size, starting a new page when full.
      */
-    wxString ApplyThemeToSvg(const wxString& svgContent);
+    static IconAtlasHandle PackIntoSizeAtlas(ThemedIconSet& set, const wxImage& image);
 
     /**
-     * @brief Reads SVG file content as string.
-     * @param filePath Path to the SVG file.
-     * @return SVG content as string, or empty string if failed.
+     * @brief Gets the raster pool, creating it on first use.
      */
-    wxString ReadSvgFile(const wxString& filePath);
+    SvgRasterWorkerPool& GetRasterPool();
 
     /**
-     * @brief Gets theme-processed SVG content.
-     * @param name Icon name.
-     * @return Theme-processed SVG content, or empty string if failed.
+     * @brief Stores a prewarmed icon in its set (UI thread).
      */
-    wxString GetThemedSvgContent(const wxString& name);
+    void OnPrewarmDone(const std::shared_ptr<ThemedIconSet>& set, const wxString& name, const wxSize& size, const wxImage& image);
 
     /**
-     * @brief Applies direct theme colors to SVG content without analyzing original colors.
-     * @param svgContent The original SVG content.
-     * @param primaryIconColor Primary icon color for fills and strokes.
-     * @param backgroundIconColor Background color for light elements.
-     * @return Theme-processed SVG content.
+     * @brief Gets or creates a bitmap bundle for the specified icon.
      */
-    wxString ApplyDirectThemeColors(const wxString& svgContent, const wxString& primaryIconColor, const wxString& backgroundIconColor);
+    wxBitmapBundle GetBitmapBundle(const wxString& name);
 
     /**
-     * @brief Adds default fill color to SVG elements without color attributes.
-     * @param svgContent The SVG content to process.
-     * @param defaultColor The default color to apply.
-     * @return SVG content with default colors applied.
+     * @brief Applies theme colors to a parsed SVG icon.
+     * @param svg The compiled SVG template.
+     * @return Theme-processed SVG content string.
      */
-    wxString AddDefaultFillToElements(const wxString& svgContent, const wxString& defaultColor);
+    wxString ApplyThemeToSvg(const SvgColorTemplate& svg);
 
     /**
-     * @brief Normalizes the SVG structure.
-     * @param svgContent The original SVG content string.
-     * @return Normalized SVG content string.
+     * @brief Reads SVG file content as raw UTF-8 bytes.
+     * @param filePath Path to the SVG file.
+     * @return SVG content, or empty string if failed.
      */
-    wxString NormalizeSvgStructure(const wxString& svgContent);
+    std::string ReadSvgFile(const wxString& filePath);
 
     /**
-     * @brief Replaces non-light colors in specified attributes with theme color.
-     * @param content SVG content to process.
-     * @param attribute Attribute name (fill, stroke, etc.).
-     * @param targetColor Theme color to replace with.
-     * @return SVG content with non-light colors replaced.
+     * @brief Gets the parsed SVG for an icon, reading and compiling the file on first use.
+     * @return Shared immutable template, or null if the icon cannot be read.
      */
-    wxString ReplaceNonLightColors(const wxString& content, const wxString& attribute, const wxString& targetColor);
+    std::shared_ptr<const SvgColorTemplate> GetSvgTemplate(const wxString& name);
 
     /**
-     * @brief Replaces non-light colors in CSS style attributes.
-     * @param content SVG content to process.
-     * @param targetColor Theme color to replace with.
-     * @return SVG content with non-light colors in styles replaced.
+     * @brief Gets theme-processed SVG content.
+     * @param name Icon name.
+     * @return Theme-processed SVG content, or empty string if failed.
      */
-    wxString ReplaceNonLightColorsInStyles(const wxString& content, const wxString& targetColor);
+    wxString GetThemedSvgContent(const wxString& name);
 
     /**
-     * @brief Determines if a color should be replaced based on brightness.
-     * @param colorValue Color value to analyze.
-     * @return True if color should be replaced (dark/medium), false if light.
+     * @brief Fills the colour slots of a parsed SVG (see SvgColorTemplate).
+     * @param svg The compiled SVG template.
+     * @param primaryIconColor Primary icon color for fills and strokes.
+     * @param backgroundIconColor Background color for light elements.
+     * @return Theme-processed SVG content.
      */
-    bool ShouldReplaceColor(const wxString& colorValue);
+    wxString ApplyDirectThemeColors(const SvgColorTemplate& svg, const wxString& primaryIconColor, const wxString& backgroundIconColor);
 
     /**
-     * @brief Calculates the perceived brightness of a color.
-     * @param colorValue Color value in any supported format.
-     * @return Brightness value (0-255) or -1 if invalid.
+     * @brief Caches a finished background rasterization and notifies waiting callers (UI thread).
      */
-    int CalculateColorBrightness(const wxString& colorValue);
+    void OnAsyncRasterDone(const wxString& name, const wxSize& size, unsigned int generation, const wxImage& image);
 
 public:
     /**
@@ -126,6 +157,11 @@ public:
      */
     static SvgIconManager& GetInstance();
 
+    /**
+     * @brief Gets the singleton instance without creating it, or nullptr.
+     */
+    static SvgIconManager* GetExistingInstance();
+
     /**
      * @brief Sets the default icon directory for the singleton instance.
      */
@@ -140,6 +176,33 @@ public:
      */
     wxBitmap GetIconBitmap(const wxString& name, const wxSize& size, bool useCache = true);
 
+    /**
+     * @brief Requests an icon without blocking the UI thread on rasterization.
+     * Cached icons are delivered before this returns; otherwise the SVG is
+     * rasterized on a worker thread and the callback runs later on the UI thread.
+     * Concurrent requests for the same icon and size share one rasterization.
+     * @param name The name of the icon (without .svg extension).
+     * @param size The desired size of the bitmap.
+     * @param callback Receives the bitmap, or an invalid bitmap if the icon cannot be loaded.
+     */
+    void RequestIconAsync(const wxString& name, const wxSize& size, IconReadyCallback callback);
+
+    /**
+     * @brief Gets an icon packed into the shared atlas for its size and the current theme.
+     * @return Handle to blit with IconAtlasPainter, or an invalid handle if the icon cannot be loaded.
+     */
+    IconAtlasHandle GetAtlasIcon(const wxString& name, const wxSize& size);
+
+    /**
+     * @brief Gets a transparent atlas slot to show while an async icon is pending.
+     */
+    IconAtlasHandle GetAtlasPlaceholder(const wxSize& size);
+
+    /**
+     * @brief Packs an arbitrary (non-themed) bitmap into a shared atlas.
+     */
+    IconAtlasHandle PackBitmap(const wxBitmap& bitmap);
+
     /**
      * @brief Gets a wxBitmap with fallback to default icon if not found.
      * @param name The name of the icon (without .svg extension).
@@ -169,6 +232,16 @@ public:
      */
     wxArrayString GetAvailableIcons() const;
 
+    /**
+     * @brief Gets size, budget and hit/miss/eviction counters of the in-memory caches.
+     */
+    CacheStats GetCacheStats() const;
+
+    /**
+     * @brief Logs the in-memory cache statistics.
+     */
+    void LogCacheStats() const;
+
     /**
      * @brief Clears all caches (bitmap, bundle, and themed SVG).
      */
@@ -179,6 +252,20 @@ public:
      */
     void ClearThemeCache();
 
+    /**
+     * @brief Recolours and rasterizes every icon used so far for another theme on worker threads.
+     * The result is kept aside and swapped in by ActivateTheme when that theme is selected.
+     * @return False if the theme is unknown or already current.
+     */
+    bool PrewarmTheme(const std::string& themeName);
+
+    /**
+     * @brief Switches icon caches to the now-current theme (called by ThemeManager).
+     * Swaps in a prewarmed set when its colouring matches, otherwise starts empty.
+     * @return True if a prewarmed set was used.
+     */
+    bool ActivateTheme(const std::string& themeName);
+
     /**
      * @brief Preloads commonly used icons into cache.
      */
@@ -0,0 +1,65 @@
+#ifndef SVG_RASTER_WORKER_POOL_H
+#define SVG_RASTER_WORKER_POOL_H
+
+#include <wx/wx.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class SvgRasterWorkerPool
+ * @brief Rasterizes SVG markup into wxImage on background threads.
+ * Uses NanoSVG directly, so no wxBitmap/GDI objects are touched off the UI
+ * thread. Completion callbacks are marshalled back to the UI thread with
+ * wxTheApp->CallAfter; jobs still queued at shutdown are discarded.
+ */
+class SvgRasterWorkerPool {
+public:
+    using CompletionCallback = std::function<void(const wxImage&)>;
+    using RasterTask = std::function<wxImage()>;
+
+    explicit SvgRasterWorkerPool(size_t threadCount = 0);
+    ~SvgRasterWorkerPool();
+
+    SvgRasterWorkerPool(const SvgRasterWorkerPool&) = delete;
+    SvgRasterWorkerPool& operator=(const SvgRasterWorkerPool&) = delete;
+
+    /**
+     * @brief Queues UTF-8 SVG markup for rasterization at the given pixel size.
+     * The callback runs on the UI thread; the image is invalid if parsing failed.
+     */
+    void Submit(std::string svgUtf8, const wxSize& size, CompletionCallback callback);
+
+    /**
+     * @brief Queues arbitrary image-producing work, e.g. read + recolour + rasterize.
+     * The task runs on a worker thread and must not touch GUI objects or theme state.
+     */
+    void SubmitTask(RasterTask task, CompletionCallback callback);
+
+    /**
+     * @brief Rasterizes synchronously on the calling thread, scaled to fit and centred like wxBitmapBundle::FromSVG.
+     */
+    static wxImage Rasterize(const std::string& svgUtf8, const wxSize& size);
+
+    size_t GetThreadCount() const { return m_threads.size(); }
+
+private:
+    struct Job {
+        RasterTask task;
+        CompletionCallback callback;
+    };
+
+    void WorkerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::deque<Job> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopping = false;
+};
+
+#endif // SVG_RASTER_WORKER_POOL_H
@@ -0,0 +1,62 @@
+#ifndef THEME_KEY_H
+#define THEME_KEY_H
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+/**
+ * @class ThemeKey
+ * @brief Interned handle for a theme configuration key.
+ * The key name is resolved once into a dense index; lookups then read the
+ * per-theme colour/int tables directly without building a std::string.
+ */
+class ThemeKey {
+public:
+    static constexpr uint32_t InvalidId = 0xFFFFFFFFu;
+
+    ThemeKey() : m_id(InvalidId) {}
+    explicit ThemeKey(const char* name);
+    explicit ThemeKey(const std::string& name);
+
+    uint32_t id() const { return m_id; }
+    bool isValid() const { return m_id != InvalidId; }
+    const std::string& name() const;
+
+    bool operator==(const ThemeKey& other) const { return m_id == other.m_id; }
+    bool operator!=(const ThemeKey& other) const { return m_id != other.m_id; }
+    bool operator<(const ThemeKey& other) const { return m_id < other.m_id; }
+
+private:
+    uint32_t m_id;
+};
+
+/**
+ * @class ThemeKeyRegistry
+ * @brief Process-wide table mapping key names to dense ids.
+ * Ids are never recycled, so a handle stays valid for the lifetime of the process.
+ */
+class ThemeKeyRegistry {
+public:
+    static ThemeKeyRegistry& getInstance();
+
+    uint32_t intern(const std::string& name);
+    const std::string& name(uint32_t id) const;
+    size_t size() const;
+
+private:
+    ThemeKeyRegistry() = default;
+    ThemeKeyRegistry(const ThemeKeyRegistry&) = delete;
+    ThemeKeyRegistry& operator=(const ThemeKeyRegistry&) = delete;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, uint32_t> m_ids;
+    std::deque<std::string> m_names; // deque keeps element references stable on growth
+};
+
+// Resolves a literal key once per call site and reuses the cached handle afterwards
+#define THEME_KEY(key) ([]() -> const ThemeKey& { static const ThemeKey cachedKey(key); return cachedKey; }())
+
+#endif // THEME_KEY_H
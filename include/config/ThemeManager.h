@@ -2,30 +2,38 @@
 #define THEME_MANAGER_H
 
 #include "config/ConfigManager.h"
+#include "config/ThemeKey.h"
+#include "config/ThemeSnapshot.h"
 #include <wx/colour.h>
 #include <wx/font.h>
 #include <string>
+#include <string_view>
 #include <map>
 #include <vector>
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
 
 // Theme configuration macros - unified across all files
-#define CFG_COLOUR(key) ThemeManager::getInstance().getColour(key)
-#define CFG_INT(key) ThemeManager::getInstance().getInt(key)
+// Colour and int keys are literals, so they compile down to cached ThemeKey handles
+#define CFG_COLOUR(key) ThemeManager::getInstance().getColour(THEME_KEY(key))
+#define CFG_INT(key) ThemeManager::getInstance().getInt(THEME_KEY(key))
+#define CFG_PEN(key) ThemeManager::getInstance().getPen(THEME_KEY(key))
+#define CFG_BRUSH(key) ThemeManager::getInstance().getBrush(THEME_KEY(key))
 #define CFG_STRING(key) ThemeManager::getInstance().getString(key)
 #define CFG_FONT() ThemeManager::getInstance().getDefaultFont()
 #define CFG_FONTNAME() ThemeManager::getInstance().getDefaultFont().GetFaceName()
 #define CFG_DEFAULTFONT() ThemeManager::getInstance().getDefaultFont()
 
-struct ThemeProfile {
-    std::string name;
-    std::string displayName;
-    std::map<std::string, wxColour> colours;
-    std::map<std::string, int> integers;
-    std::map<std::string, std::string> strings;
-    wxFont defaultFont;
-};
-
 class ThemeManager {
+    struct Listener {
+        bool everyChange = false;
+        std::vector<uint32_t> keyIds;  // Sorted
+        std::function<void()> callback;
+    };
+
 public:
     static ThemeManager& getInstance();
     
@@ -37,21 +45,38 @@ public:
     std::string getCurrentTheme() const;
     bool setCurrentTheme(const std::string& themeName);
     
-    // Configuration access
+    // Configuration access (UI thread; other threads should hold a snapshot)
+    wxColour getColour(const ThemeKey& key) const;
+    int getInt(const ThemeKey& key) const;
     wxColour getColour(const std::string& key) const;
     int getInt(const std::string& key) const;
+    const wxPen& getPen(const ThemeKey& key) const;
+    const wxBrush& getBrush(const ThemeKey& key) const;
     std::string getString(const std::string& key) const;
     wxFont getDefaultFont() const;
     
+    // Immutable compiled themes. The current snapshot is replaced in one step on a theme switch.
+    ThemeSnapshotPtr getCurrentSnapshot() const;
+    ThemeSnapshotPtr getSnapshot(const std::string& themeName) const;
+    uint64_t getThemeGeneration() const;
+    
     // Theme creation and management
     bool createTheme(const std::string& themeName, const ThemeProfile& profile);
     bool saveCurrentTheme();
     bool reloadThemes();
     
-    // Notification system for theme changes
+    // Notification system for theme changes. Callbacks run in one deferred pass
+    // per event loop turn, however many changes arrive before it.
     void addThemeChangeListener(void* listener, std::function<void()> callback);
+    // Called on theme switches and only on edits that change one of the given keys
+    void addThemeChangeListener(void* listener, std::vector<ThemeKey> keys, std::function<void()> callback);
+    // Adds dependencies to a keyed listener, e.g. keys recorded while it painted
+    void addListenerKeys(void* listener, const std::vector<uint32_t>& keyIds);
     void removeThemeChangeListener(void* listener);
     
+    // Applies keys changed on disk (see ConfigManager::reloadChanges) without a full theme switch
+    void applyConfigChanges(const std::vector<ConfigChange>& changes);
+    
 private:
     ThemeManager();
     ~ThemeManager();
@@ -60,17 +85,63 @@ private:
     
     void loadBuiltinThemes();
     void notifyThemeChange();
-    wxColour parseColour(const std::string& value) const;
+    void notifyListeners(const std::vector<uint32_t>* changedKeys);
+    void flushListeners();
+    void indexListenerKeys(void* listener, Listener& entry, const std::vector<uint32_t>& keyIds);
+    std::vector<uint32_t> diffProfiles(const ThemeProfile& before, const ThemeProfile& after) const;
+    wxColour parseColour(std::string_view value) const;
     ThemeProfile loadThemeFromConfig(const std::string& themeName);
-    std::vector<std::string> splitString(const std::string& str, char delimiter);
-    void loadSizeConfigurations(ThemeProfile& theme);
+    void applyThemeColours(const std::string& key, std::string_view value, ThemeProfile* const profiles[3]) const;
+    std::map<std::string, int> loadSizeConfigurations() const;
     wxFont loadFont();
+    void compileAllThemes();
+    void publishSnapshot(const ThemeSnapshotPtr& snapshot);
     
     ConfigManager* m_configManager;
     std::string m_currentTheme;
     std::map<std::string, ThemeProfile> m_themes;
-    std::map<void*, std::function<void()>> m_listeners;
+    std::map<std::string, ThemeSnapshotPtr> m_snapshots;
+    ThemeSnapshotPtr m_activeSnapshot;                 // accessed with std::atomic_load/atomic_store
+    std::atomic<const ThemeSnapshot*> m_activeRaw;    // borrowed from m_activeSnapshot for the hot getters
+    uint64_t m_nextGeneration;
+    std::map<void*, Listener> m_listeners;
+    std::unordered_map<uint32_t, std::vector<void*>> m_keySubscribers;  // ThemeKey id -> keyed listeners
+    std::set<void*> m_pendingListeners;
+    bool m_flushScheduled;
+    std::string m_switchingTheme;                       // Set by setCurrentTheme until its listener flush ran
+    std::chrono::steady_clock::time_point m_switchStart;
     bool m_initialized;
 };
 
+/**
+ * @class ThemeSubscription
+ * @brief Theme change subscription owned by one control.
+ * Besides keys declared up front, every CFG_* lookup made while a Recorder is
+ * alive on the same thread is added to the subscription, so a control that
+ * records its paint handler is only notified about edits to keys it draws
+ * with. Theme switches notify every subscription. UI thread only.
+ */
+class ThemeSubscription {
+public:
+    explicit ThemeSubscription(std::function<void()> callback, std::vector<ThemeKey> keys = {});
+    ~ThemeSubscription();
+
+    ThemeSubscription(const ThemeSubscription&) = delete;
+    ThemeSubscription& operator=(const ThemeSubscription&) = delete;
+
+    class Recorder {
+    public:
+        explicit Recorder(ThemeSubscription& subscription);
+        ~Recorder();
+
+        Recorder(const Recorder&) = delete;
+        Recorder& operator=(const Recorder&) = delete;
+
+    private:
+        ThemeSubscription& m_subscription;
+        std::vector<uint32_t> m_keyIds;
+        std::vector<uint32_t>* m_outer;
+    };
+};
+
 #endif // THEME_MANAGER_H 
\ No newline at end of file
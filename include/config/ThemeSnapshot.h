@@ -0,0 +1,66 @@
+#ifndef THEME_SNAPSHOT_H
+#define THEME_SNAPSHOT_H
+
+#include "config/ThemeKey.h"
+#include <wx/colour.h>
+#include <wx/font.h>
+#include <wx/pen.h>
+#include <wx/brush.h>
+#include <string>
+#include <map>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+struct ThemeProfile {
+    std::string name;
+    std::string displayName;
+    std::map<std::string, wxColour> colours;
+    std::map<std::string, int> integers;
+    std::map<std::string, std::string> strings;
+    wxFont defaultFont;
+};
+
+/**
+ * @class ThemeSnapshot
+ * @brief Immutable, compiled form of a ThemeProfile.
+ * Colours and ints live in flat tables indexed by ThemeKey id, and a solid pen
+ * and brush are prebuilt for every colour key. Snapshots are never modified
+ * after Build(), so controls may hold a pointer to one across paints.
+ */
+class ThemeSnapshot {
+public:
+    static std::shared_ptr<const ThemeSnapshot> Build(const ThemeProfile& profile, uint64_t generation);
+
+    const std::string& GetName() const { return m_name; }
+    const std::string& GetDisplayName() const { return m_displayName; }
+    uint64_t GetGeneration() const { return m_generation; }
+
+    // Lookups return nullptr when the key is not defined by this theme
+    const wxColour* FindColour(const ThemeKey& key) const;
+    const int* FindInt(const ThemeKey& key) const;
+    const wxPen* FindPen(const ThemeKey& key) const;
+    const wxBrush* FindBrush(const ThemeKey& key) const;
+    const std::string* FindString(const std::string& key) const;
+
+    const wxFont& GetDefaultFont() const { return m_defaultFont; }
+
+private:
+    ThemeSnapshot() : m_generation(0) {}
+
+    std::string m_name;
+    std::string m_displayName;
+    uint64_t m_generation;
+    std::vector<wxColour> m_colours;
+    std::vector<wxPen> m_pens;
+    std::vector<wxBrush> m_brushes;
+    std::vector<unsigned char> m_hasColour;
+    std::vector<int> m_integers;
+    std::vector<unsigned char> m_hasInteger;
+    std::map<std::string, std::string> m_strings;
+    wxFont m_defaultFont;
+};
+
+using ThemeSnapshotPtr = std::shared_ptr<const ThemeSnapshot>;
+
+#endif // THEME_SNAPSHOT_H
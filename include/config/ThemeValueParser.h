@@ -0,0 +1,38 @@
+#ifndef THEME_VALUE_PARSER_H
+#define THEME_VALUE_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Allocation-free parsing of config.ini theme values.
+ * Works on string_views into the caller's buffer, so loading hundreds of
+ * "r,g,b;r,g,b;r,g,b" entries does not create a stream or token string per
+ * entry. Accepts exactly what the istringstream based ThemeManager parsing
+ * accepted. Depends on the standard library only.
+ */
+namespace ThemeValueParser {
+
+struct Rgb {
+    uint8_t r = 0;
+    uint8_t g = 0;
+    uint8_t b = 0;
+};
+
+// Strips spaces and tabs from both ends
+std::string_view Trim(std::string_view text);
+
+// Splits on the delimiter into at most maxFields trimmed views and returns the
+// number of fields found; a trailing delimiter does not start an empty field
+size_t Split(std::string_view text, char delimiter, std::string_view* fields, size_t maxFields);
+
+// Whole-string base-10 integer with optional sign and surrounding whitespace
+bool ParseInt(std::string_view text, int& value);
+
+// "r,g,b" with components in 0..255; any single character separates components
+bool ParseRgb(std::string_view text, Rgb& rgb);
+
+} // namespace ThemeValueParser
+
+#endif // THEME_VALUE_PARSER_H
@@ -96,6 +96,7 @@ protected:
     void DrawDropDownButton(wxDC& dc);
     void DrawDropDownIcon(wxDC& dc, const wxRect& buttonRect);
     void DrawLeftIcon(wxDC& dc);
+    void RequestLeftIcon();
     wxRect GetDropDownButtonRect() const;
     wxRect GetTextRect() const;
     wxRect GetLeftIconRect() const;
@@ -131,6 +132,7 @@ private:
     CustomDropDownStyle m_style;
     wxString m_leftIconName;
     wxSize m_leftIconSize;
+    wxBitmap m_leftIconBitmap; // Empty until the async icon request completes
 
     // State
     bool m_isDropDownShown;
@@ -23,6 +23,7 @@
 #include <wx/artprov.h>
 #include <vector>
 #include <memory>
+#include "config/ThemeManager.h"
 
 // Forward declarations of the new component classes
 class FlatUIPage; 
@@ -335,6 +336,7 @@ private:
 
     size_t m_visibleTabsCount; // Number of tabs that fit in the current layout
 
+    ThemeSubscription m_themeSubscription; // Repaints only on edits to keys read in OnPaint
 };
 
 #endif // FLATUIBAR_H 
\ No newline at end of file
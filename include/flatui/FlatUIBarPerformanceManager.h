@@ -5,6 +5,9 @@
 #include <wx/graphics.h>
 #include <wx/bitmap.h>
 #include <wx/dcmemory.h>
+#include <wx/weakref.h>
+#include "config/LruCache.h"
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 
@@ -45,9 +48,29 @@ inline PerformanceOptimization operator&(PerformanceOptimization a, PerformanceO
 class FlatUIBarPerformanceManager
 {
 public:
+    // Paint cost counters; one frame is one paint event of an instrumented control
+    struct RepaintStats {
+        uint64_t frames = 0;
+        uint64_t pixelsRepainted = 0;   // Area of the update regions
+        uint64_t pixelsFullRepaint = 0; // Client area of the same windows, i.e. the cost without dirty regions
+        uint64_t lastFramePixels = 0;
+        uint64_t itemsDrawn = 0;
+        uint64_t itemsSkipped = 0;
+    };
+
     FlatUIBarPerformanceManager(FlatUIBar* bar);
     ~FlatUIBarPerformanceManager();
 
+    // Manager of the FlatUIBar that contains the window, or nullptr (e.g. floating panels)
+    static FlatUIBarPerformanceManager* FromWindow(wxWindow* window);
+
+    /**
+     * @brief Repaints only the given client rect of a window inside the bar.
+     * The rect is recorded as an invalid region until the window paints it.
+     * Falls back to a full Refresh when dirty region tracking is disabled.
+     */
+    static void RefreshWindowRect(wxWindow* window, const wxRect& rect);
+
     // DPI Management
     double GetCurrentDPIScale() const;
     void OnDPIChanged();
@@ -74,6 +97,11 @@ public:
     bool HasInvalidRegions() const;
     std::vector<wxRect> GetInvalidRegions() const;
     void ClearInvalidRegions();
+    void InvalidateRegion(wxWindow* window, const wxRect& rect);
+    // Called from OnPaint with the window's update region; subtracts it from that window's damage
+    void RecordRepaint(wxWindow* window, const wxRegion& damage, size_t itemsDrawn, size_t itemsSkipped);
+    RepaintStats GetRepaintStats() const { return m_repaintStats; }
+    void ResetRepaintStats() { m_repaintStats = RepaintStats(); }
     
     // Batch painting optimization
     void BeginBatchPaint();
@@ -85,6 +113,8 @@ public:
     void StartPerformanceTimer(const wxString& operation);
     void EndPerformanceTimer(const wxString& operation);
     void LogPerformanceStats() const;
+    // Process-wide caches shared by all bars; logged once from MainApplication::OnExit
+    static void LogSharedStats();
     
     // Optimization control
     void SetOptimizationFlags(PerformanceOptimization flags);
@@ -107,14 +137,20 @@ private:
     bool m_batchPainting;
     PerformanceOptimization m_optimizationFlags;
     
-    // Resource caches
-    mutable std::unordered_map<wxString, DPIAwareResource> m_bitmapCache;
-    mutable std::unordered_map<wxString, DPIAwareResource> m_fontCache;
-    mutable std::unordered_map<wxString, DPIAwareResource> m_valueCache;
+    // Resource caches, bounded by byte budget with LRU eviction
+    using ResourceCache = LruCache<wxString, DPIAwareResource>;
+    mutable ResourceCache m_bitmapCache;
+    mutable ResourceCache m_fontCache;
+    mutable ResourceCache m_valueCache;
     
-    // Dirty region tracking
-    std::vector<wxRect> m_invalidRegions;
-    bool m_hasInvalidRegions;
+    // Dirty region tracking, per control in its own client coordinates so that each
+    // paint can consume exactly what it covered
+    struct WindowDamage {
+        wxWeakRef<wxWindow> window;
+        wxRegion damage;
+    };
+    std::vector<WindowDamage> m_windowDamage;
+    RepaintStats m_repaintStats;
     
     // Batch operations
     std::vector<std::function<void(wxGraphicsContext*)>> m_queuedOperations;
@@ -125,6 +161,7 @@ private:
     
     // Helper methods
     void UpdateDPIScale();
+    wxPoint GetOffsetInBar(wxWindow* window) const;
     wxString GenerateCacheKey(const wxString& baseKey, double scaleFactor) const;
     void CleanupExpiredCacheEntries();
     bool IsOptimizationEnabled(PerformanceOptimization opt) const;
@@ -7,6 +7,11 @@
 #include <wx/menu.h>
 #include <wx/dcbuffer.h>
 #include "logger/Logger.h"
+#include "config/IconAtlas.h"
+#include "config/LruCache.h"
+#include "config/ThemeManager.h"
+#include "flatui/FlatUIDisplayList.h"
+#include "flatui/FlatUILayoutEngine.h"
 
 class FlatUIPanel;
 
@@ -17,7 +22,7 @@ enum class ButtonDisplayStyle {
     ICON_TEXT_BELOW
 };
 
-class FlatUIButtonBar : public wxControl
+class FlatUIButtonBar : public wxControl, public FlatUILayoutNode
 {
 public:
     enum class ButtonStyle {
@@ -40,6 +45,8 @@ public:
     virtual ~FlatUIButtonBar();
 
     void AddButton(int id, const wxString& label, const wxBitmap& bitmap = wxNullBitmap, wxMenu* menu = nullptr);
+    // Shows a placeholder and swaps in the SVG icon once it is rasterized in the background
+    void AddButton(int id, const wxString& label, const wxString& iconName, wxMenu* menu = nullptr);
     size_t GetButtonCount() const { return m_buttons.size(); }
 
     void SetDisplayStyle(ButtonDisplayStyle style);
@@ -95,12 +102,16 @@ public:
 
 protected:
     wxSize DoGetBestSize() const override;
+    wxSize MeasureOverride() const override;
+    // Places the buttons; their rects only depend on the measured widths
+    void ArrangeOverride(const wxSize& measured) override;
 
 private:
     struct ButtonInfo {
         int id;
         wxString label;
-        wxBitmap icon;
+        IconAtlasHandle icon; // Slot in a shared icon atlas
+        wxString iconName; // SVG icon name when loaded asynchronously
         wxRect rect;
         wxMenu* menu = nullptr;
         bool isDropDown = false;
@@ -109,6 +120,32 @@ private:
         wxSize textSize; // Cached text extent
     };
     wxVector<ButtonInfo> m_buttons;
+
+    enum class ButtonState : uint8_t {
+        NORMAL,
+        HOVER,
+        PRESSED
+    };
+
+    // Everything a pre-rendered button state depends on besides the bar's own colours
+    struct StateBitmapKey {
+        int id;
+        size_t labelHash;
+        wxSize size;
+        uint64_t themeGeneration;
+        int dpiPercent;
+        ButtonDisplayStyle displayStyle;
+        ButtonStyle buttonStyle;
+        ButtonBorderStyle borderStyle;
+        ButtonState state;
+
+        bool operator==(const StateBitmapKey& other) const;
+    };
+
+    struct StateBitmapKeyHash {
+        size_t operator()(const StateBitmapKey& key) const;
+    };
+
     ButtonDisplayStyle m_displayStyle;
     ButtonStyle m_buttonStyle;
     ButtonBorderStyle m_buttonBorderStyle;
@@ -133,21 +170,40 @@ private:
     int m_btnBarHorizontalMargin;
     bool m_hoverEffectsEnabled;
     int m_hoveredButtonIndex = -1;
+    FlatUIDisplayList m_displayList; // One segment per button, rebuilt in OnPaint when invalidated
+    LruCache<StateBitmapKey, wxBitmap, StateBitmapKeyHash> m_stateBitmaps; // Opaque, on the bar background
+    bool m_stateBitmapsEnabled;
 
+    void AppendButton(ButtonInfo& button);
+    // Re-measures every label and queues a layout pass
     void RecalculateLayout();
-    int CalculateButtonWidth(const ButtonInfo& button, wxDC& dc) const;
-    void DrawButton(wxDC& dc, const ButtonInfo& button, int index);
-    void DrawButtonBackground(wxDC& dc, const wxRect& rect, bool isHovered, bool isPressed);
-    void DrawButtonBorder(wxDC& dc, const wxRect& rect, bool isHovered, bool isPressed);
-    void DrawButtonIcon(wxDC& dc, const ButtonInfo& button, const wxRect& rect);
-    void DrawButtonText(wxDC& dc, const ButtonInfo& button, const wxRect& rect);
-    void DrawButtonDropdownArrow(wxDC& dc, const ButtonInfo& button, const wxRect& rect);
-    void DrawButtonSeparator(wxDC& dc, const ButtonInfo& button, const wxRect& rect); // New method
-
+    // Reads the cached colours and metrics from the current theme
+    void LoadThemeValues();
+    void OnButtonIconReady(int id, const wxString& iconName, const wxBitmap& bitmap);
+    // Uses the cached textSize, so no DC is needed
+    int CalculateButtonWidth(const ButtonInfo& button) const;
+    // Marks every button for regeneration, for layout, style and colour changes
+    void RefreshButtons();
+    // Repaints only the area of one button, through the bar's dirty region tracking
+    void RefreshButton(int index);
+    // Drops pre-rendered states after style and colour changes, then repaints
+    void InvalidateButtonBitmaps();
+    StateBitmapKey MakeStateBitmapKey(const ButtonInfo& button, ButtonState state) const;
+    void RenderStateBitmaps(const ButtonInfo& button);
+    void BuildButton(FlatUIDisplayList::Builder& out, const ButtonInfo& button, int index);
+    void BuildButtonPrimitives(FlatUIDisplayList::Builder& out, const ButtonInfo& button, bool isHovered, bool isPressed);
+    void BuildButtonBackground(FlatUIDisplayList::Builder& out, const wxRect& rect, bool isHovered, bool isPressed);
+    void BuildButtonBorder(FlatUIDisplayList::Builder& out, const wxRect& rect, bool isHovered, bool isPressed);
+    void BuildButtonIcon(FlatUIDisplayList::Builder& out, const ButtonInfo& button, const wxRect& rect);
+    void BuildButtonText(FlatUIDisplayList::Builder& out, const ButtonInfo& button, const wxRect& rect);
+    void BuildButtonDropdownArrow(FlatUIDisplayList::Builder& out, const ButtonInfo& button, const wxRect& rect);
+    void BuildButtonSeparator(FlatUIDisplayList::Builder& out, const ButtonInfo& button, const wxRect& rect);
 
     void OnMouseMove(wxMouseEvent& evt);
     void OnMouseLeave(wxMouseEvent& evt);
     void OnSize(wxSizeEvent& evt);
+    ThemeSubscription m_themeSubscription; // Repaints on edits to keys read in LoadThemeValues() or OnPaint
+    mutable ThemeSubscription m_layoutSubscription; // Re-measures on edits to keys read by the layout passes
 };
 
 #endif // FLATUIBUTTONBAR_H
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef FLATUIDISPLAYLIST_H
+#define FLATUIDISPLAYLIST_H
+
+#include <wx/wx.h>
+#include <cstdint>
+#include <vector>
+#include "config/IconAtlas.h"
+
+/**
+ * @class FlatUIDisplayList
+ * @brief Retained draw commands for controls made of many similar items.
+ * Commands are grouped into one segment per item. A segment is rebuilt only
+ * after Invalidate(), so a hover change regenerates the two affected items
+ * while paint just replays the stored commands. Pens and brushes come from
+ * FlatUIResourcePool at replay time; the DC font is left to the caller.
+ * UI thread only.
+ */
+class FlatUIDisplayList
+{
+public:
+    struct Command {
+        enum class Type : uint8_t {
+            FILL_RECT,
+            STROKE_RECT,
+            LINE,
+            TRIANGLE,
+            TEXT,
+            ICON,
+            BITMAP
+        };
+
+        Type type;
+        wxRect rect;           // Rect commands, or the origin of text and icons
+        wxPoint points[3];     // Line end points and triangle corners
+        wxColour colour;
+        int width = 1;
+        int radius = 0;        // Rounded corners when > 0
+        wxPenStyle penStyle = wxPENSTYLE_SOLID;
+        wxString text;
+        IconAtlasHandle icon;
+        wxBitmap bitmap;
+    };
+
+    // Appends to one segment and grows its bounds as commands are added
+    class Builder
+    {
+    public:
+        void FillRect(const wxRect& rect, const wxColour& colour, int radius = 0);
+        void StrokeRect(const wxRect& rect, const wxColour& colour, int width = 1,
+                        wxPenStyle style = wxPENSTYLE_SOLID, int radius = 0);
+        void Line(const wxPoint& from, const wxPoint& to, const wxColour& colour, int width = 1);
+        void Triangle(const wxPoint& a, const wxPoint& b, const wxPoint& c, const wxColour& colour);
+        void Text(const wxString& text, const wxPoint& origin, const wxSize& extent, const wxColour& colour);
+        void Icon(const IconAtlasHandle& icon, const wxPoint& origin);
+        void Bitmap(const wxBitmap& bitmap, const wxPoint& origin);
+
+    private:
+        friend class FlatUIDisplayList;
+        Builder(std::vector<Command>& commands, wxRect& bounds) : m_commands(commands), m_bounds(bounds) {}
+
+        Command& Append(Command::Type type, const wxRect& area);
+
+        std::vector<Command>& m_commands;
+        wxRect& m_bounds;
+    };
+
+    // Drops all commands and makes every segment dirty
+    void Reset(size_t segmentCount);
+    size_t GetSegmentCount() const { return m_segments.size(); }
+
+    void Invalidate();
+    void Invalidate(size_t segment);
+    bool IsDirty(size_t segment) const;
+
+    /**
+     * @brief Clears a segment and returns a builder for its new commands.
+     * The builder must not outlive the next Reset().
+     */
+    Builder Rebuild(size_t segment);
+
+    // Area covered by a segment's commands, empty when it draws nothing
+    wxRect GetSegmentBounds(size_t segment) const;
+
+    void Replay(wxDC& dc, IconAtlasPainter& icons) const;
+    // Replays only segments touching the damaged area; returns how many were drawn
+    size_t Replay(wxDC& dc, IconAtlasPainter& icons, const wxRegion& damage) const;
+
+    size_t GetCommandCount() const;
+    uint64_t GetRebuildCount() const { return m_rebuildCount; }
+
+private:
+    struct Segment {
+        std::vector<Command> commands;
+        wxRect bounds;
+        bool dirty = true;
+    };
+
+    static void ReplayCommand(wxDC& dc, IconAtlasPainter& icons, const Command& command);
+
+    std::vector<Segment> m_segments;
+    uint64_t m_rebuildCount = 0;
+};
+
+#endif // FLATUIDISPLAYLIST_H
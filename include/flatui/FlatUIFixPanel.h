@@ -3,12 +3,13 @@
 
 #include <wx/wx.h>
 #include <wx/vector.h>
+#include "flatui/FlatUILayoutEngine.h"
 
 // Forward declarations
 class FlatUIPage;
 class FlatUIUnpinButton;
 
-class FlatUIFixPanel : public wxPanel
+class FlatUIFixPanel : public wxPanel, public FlatUILayoutNode
 {
 public:
     FlatUIFixPanel(wxWindow* parent, wxWindowID id = wxID_ANY);
@@ -25,6 +26,7 @@ public:
     
     // Layout management
     void UpdateLayout();
+    // Queues a layout pass; the minimum size follows the largest page
     void RecalculateSize();
     
     // Unpin button management
@@ -47,6 +49,10 @@ public:
     virtual wxSize DoGetBestSize() const override;
 
 protected:
+    wxSize MeasureOverride() const override;
+    void ArrangeOverride(const wxSize& measured) override;
+    void GetLayoutChildren(std::vector<FlatUILayoutNode*>& children) const override;
+
     void OnSize(wxSizeEvent& event);
     void OnPaint(wxPaintEvent& event);
     void OnScrollLeft(wxCommandEvent& event);
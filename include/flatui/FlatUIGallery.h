@@ -3,11 +3,15 @@
 
 #include <wx/wx.h>
 #include <wx/vector.h>
+#include "config/IconAtlas.h"
+#include "config/ThemeManager.h"
+#include "flatui/FlatUIDisplayList.h"
+#include "flatui/FlatUILayoutEngine.h"
 
 // Forward declaration
 class FlatUIPanel;
 
-class FlatUIGallery : public wxControl
+class FlatUIGallery : public wxControl, public FlatUILayoutNode
 {
 public:
     // Gallery Item Style
@@ -108,11 +112,13 @@ public:
 
 protected:
     wxSize DoGetBestSize() const override;
+    wxSize MeasureOverride() const override;
+    void ArrangeOverride(const wxSize& measured) override;
 
 private:
     struct ItemInfo
     {
-        wxBitmap bitmap;
+        IconAtlasHandle icon; // Slot in a shared icon atlas
         int id;
         wxRect rect;
         bool hovered = false;
@@ -142,10 +148,20 @@ private:
     bool m_selectionEnabled;
     bool m_hasDropdown;
     
+    FlatUIDisplayList m_displayList; // One segment per item, rebuilt in OnPaint when invalidated
+
     void RecalculateLayout();
-    void DrawItem(wxDC& dc, const ItemInfo& item, int index);
-    void DrawItemBackground(wxDC& dc, const wxRect& rect, bool isHovered, bool isSelected);
-    void DrawItemBorder(wxDC& dc, const wxRect& rect, bool isHovered, bool isSelected);
+    // Reads the cached colours and metrics from the current theme
+    void LoadThemeValues();
+    // Marks every item for regeneration, for layout, style and colour changes
+    void RefreshItems();
+    // Repaints only the area of one item, through the bar's dirty region tracking
+    void RefreshItem(int index);
+    void BuildItem(FlatUIDisplayList::Builder& out, const ItemInfo& item, int index);
+    void BuildItemBackground(FlatUIDisplayList::Builder& out, const wxRect& rect, bool isHovered, bool isSelected);
+    void BuildItemBorder(FlatUIDisplayList::Builder& out, const wxRect& rect, bool isHovered, bool isSelected);
+    ThemeSubscription m_themeSubscription; // Repaints on edits to keys read in LoadThemeValues() or OnPaint
+    mutable ThemeSubscription m_layoutSubscription; // Re-measures on edits to keys read by the layout passes
 };
 
 #endif // FLATUIGALLERY_H 
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define FLATUI_HOME_SPACE_H
 
 #include <wx/wx.h>
+#include "config/ThemeManager.h"
 
 class FlatUIHomeMenu; // Forward declaration
 
@@ -36,6 +37,7 @@ private:
     int m_buttonWidth;
     FlatUIHomeMenu* m_activeHomeMenu; // Pointer to the active menu
 
+    ThemeSubscription m_themeSubscription; // Repaints only on edits to keys read in OnPaint
 };
 
 #endif // FLATUI_HOME_SPACE_H 
\ No newline at end of file
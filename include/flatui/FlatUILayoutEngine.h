@@ -0,0 +1,91 @@
+#ifndef FLATUILAYOUTENGINE_H
+#define FLATUILAYOUTENGINE_H
+
+#include <wx/wx.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class FlatUILayoutNode
+ * @brief Participant in the measure/arrange pass over the ribbon tree
+ * (fix panel, page, panel, button bar and gallery).
+ * Measure() returns a cached desired size computed from the children's
+ * cached sizes and never touches windows. InvalidateMeasure() marks the node
+ * and its ancestors dirty and stops at the first ancestor that already is,
+ * so adding N buttons costs N cheap invalidations and a single pass.
+ */
+class FlatUILayoutNode
+{
+public:
+    virtual ~FlatUILayoutNode();
+
+    wxSize Measure() const;
+    void InvalidateMeasure();
+    bool IsLayoutDirty() const { return m_layoutDirty; }
+
+    // Runs the pending pass now when this node has one, e.g. before hit testing
+    void EnsureArranged();
+
+protected:
+    explicit FlatUILayoutNode(wxWindow* window) : m_window(window) {}
+
+    // Desired size from the children's Measure(); must not change any window
+    virtual wxSize MeasureOverride() const = 0;
+    // Applies the measured size and places the content; children are already arranged
+    virtual void ArrangeOverride(const wxSize& measured) = 0;
+    // Lets a root hand the result to a host window that is not a layout node
+    virtual void OnLayoutRootArranged() {}
+
+    virtual FlatUILayoutNode* GetLayoutParent() const;
+    virtual void GetLayoutChildren(std::vector<FlatUILayoutNode*>& children) const;
+
+private:
+    friend class FlatUILayoutEngine;
+
+    void Arrange();
+
+    wxWindow* m_window;
+    mutable wxSize m_measured;
+    mutable bool m_measureValid = false;
+    bool m_layoutDirty = false;
+};
+
+/**
+ * @class FlatUILayoutEngine
+ * @brief Runs one coalesced measure/arrange pass per event loop turn.
+ * Dirty roots are queued and arranged children first, so a panel's sizer
+ * only runs after every changed child has its final minimum size. UI thread only.
+ */
+class FlatUILayoutEngine
+{
+public:
+    struct Stats {
+        uint64_t passes = 0;
+        uint64_t measures = 0;
+        uint64_t arranges = 0;
+    };
+
+    static FlatUILayoutEngine& GetInstance();
+
+    void Schedule(FlatUILayoutNode* root);
+    void Cancel(FlatUILayoutNode* node);
+    void Flush();
+
+    const Stats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = Stats(); }
+    void LogStats() const;
+
+private:
+    friend class FlatUILayoutNode;
+
+    FlatUILayoutEngine() = default;
+    FlatUILayoutEngine(const FlatUILayoutEngine&) = delete;
+    FlatUILayoutEngine& operator=(const FlatUILayoutEngine&) = delete;
+
+    std::vector<FlatUILayoutNode*> m_pending;
+    bool m_flushPosted = false;
+    bool m_flushing = false;
+    Stats m_stats;
+};
+
+#endif // FLATUILAYOUTENGINE_H
@@ -5,12 +5,14 @@
 #include <wx/wx.h>
 #include <wx/vector.h>
 #include <string>
+#include "config/ThemeManager.h"
+#include "flatui/FlatUILayoutEngine.h"
 
 // Forward declarations
 class FlatUIBar;
 class FlatUIPanel;
 
-class FlatUIPage : public wxControl
+class FlatUIPage : public wxControl, public FlatUILayoutNode
 {
 public:
     // Constructor takes a wxWindow* parent 
@@ -28,13 +30,21 @@ public:
 
     void SetActive(bool active) { m_isActive = active; }
     bool IsActive() const { return m_isActive; }
-    void RecalculatePageHeight(); // Declare the method
+    // Queues a layout pass for the page and its host
+    void RecalculatePageHeight();
 
     void OnPaint(wxPaintEvent& evt);
     void OnSize(wxSizeEvent& evt);
 
     void UpdateLayout();
 
+protected:
+    wxSize MeasureOverride() const override;
+    void ArrangeOverride(const wxSize& measured) override;
+    void OnLayoutRootArranged() override;
+    // Pages live in the fix panel's scroll container, not directly in the fix panel
+    FlatUILayoutNode* GetLayoutParent() const override;
+
 private:
 
     wxString m_label;
@@ -42,6 +52,7 @@ private:
     wxBoxSizer* m_sizer;
     bool m_isActive; 
 
+    ThemeSubscription m_themeSubscription; // Repaints only on edits to keys read in OnPaint
 };
 
 #endif // FLATUIPAGE_H 
\ No newline at end of file
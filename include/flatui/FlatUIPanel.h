@@ -5,6 +5,8 @@
 #include <wx/vector.h>
 #include <wx/timer.h>
 #include <string>
+#include "config/ThemeManager.h"
+#include "flatui/FlatUILayoutEngine.h"
 
 
 // Forward declarations
@@ -30,7 +32,7 @@ enum class PanelHeaderStyle {
     BOTTOM_CENTERED // Header at the bottom, text centered
 };
 
-class FlatUIPanel : public wxControl
+class FlatUIPanel : public wxControl, public FlatUILayoutNode
 {
 public:
     FlatUIPanel(FlatUIPage* parent, const wxString& label, int orientation = wxVERTICAL);
@@ -70,7 +72,7 @@ public:
     
     void SetLabel(const wxString& label);
     
-    // Force recalculation of panel size based on child controls
+    // Queues recalculation of the panel size based on child controls
     void UpdatePanelSize();
 
     void OnPaint(wxPaintEvent& evt); // Keep if specific OnPaint is needed, otherwise wxControl default
@@ -78,15 +80,20 @@ public:
     // Timer event handler
     void OnTimer(wxTimerEvent& event);
 
+protected:
+    // Best size from the cached sizes of the button bars and galleries
+    wxSize MeasureOverride() const override;
+    void ArrangeOverride(const wxSize& measured) override;
+
 private:
     void DrawWithDC(wxDC& dc, const wxSize& size);
+
+    // Reads the cached colours from the current theme
+    void LoadThemeValues();
     
     // Resize child controls to fit within the panel dimensions
     void ResizeChildControls(int width, int height);
     
-    // Recalculate the best size based on child controls
-    void RecalculateBestSize();
-    
     wxString m_label;
     wxVector<FlatUIButtonBar*> m_buttonBars;
     wxVector<FlatUIGallery*> m_galleries;
@@ -116,6 +123,8 @@ private:
     
     // Class level timer for size updates
     wxTimer m_resizeTimer;
+    ThemeSubscription m_themeSubscription; // Repaints on edits to keys read in LoadThemeValues() or OnPaint
+    mutable ThemeSubscription m_layoutSubscription; // Re-measures on edits to keys read by the layout passes
 };
 
 #endif // FLATUIPANEL_H 
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define FLATUI_PROFILE_SPACE_H
 
 #include <wx/wx.h>
+#include "config/ThemeManager.h"
 
 class FlatUIProfileSpace : public wxControl // Inherit from wxPanel
 {
@@ -22,6 +23,7 @@ protected:
 private:
     wxWindow* m_childControl;
     int m_spaceWidth;
+    ThemeSubscription m_themeSubscription; // Repaints only on edits to keys read in OnPaint
 };
 
 #endif // FLATUI_PROFILE_SPACE_H 
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef FLATUIRESOURCEPOOL_H
+#define FLATUIRESOURCEPOOL_H
+
+#include <wx/wx.h>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @class FlatUIResourcePool
+ * @brief Process-wide pool of pens, brushes and fonts shared by the paint routines.
+ * Entries are keyed by (colour, width, style) so repeated draws reuse the same
+ * ref-counted GDI object instead of constructing a new one per call. The pool is
+ * flushed whenever the theme changes. Returned references stay valid until the
+ * next Clear(); paint code should use them immediately and not store them.
+ * UI thread only.
+ */
+class FlatUIResourcePool
+{
+public:
+    struct Stats {
+        uint64_t penHits = 0;
+        uint64_t penMisses = 0;
+        uint64_t brushHits = 0;
+        uint64_t brushMisses = 0;
+        uint64_t fontHits = 0;
+        uint64_t fontMisses = 0;
+        size_t penCount = 0;
+        size_t brushCount = 0;
+        size_t fontCount = 0;
+    };
+
+    static FlatUIResourcePool& GetInstance();
+
+    const wxPen& GetPen(const wxColour& colour, int width = 1, wxPenStyle style = wxPENSTYLE_SOLID);
+    const wxBrush& GetBrush(const wxColour& colour, wxBrushStyle style = wxBRUSHSTYLE_SOLID);
+    const wxFont& GetFont(int pointSize, wxFontFamily family = wxFONTFAMILY_DEFAULT,
+                          wxFontStyle style = wxFONTSTYLE_NORMAL,
+                          wxFontWeight weight = wxFONTWEIGHT_NORMAL,
+                          const wxString& faceName = wxEmptyString);
+
+    void Clear();
+
+    Stats GetStats() const;
+    void ResetStats();
+    void LogStats() const;
+
+private:
+    FlatUIResourcePool();
+    ~FlatUIResourcePool();
+    FlatUIResourcePool(const FlatUIResourcePool&) = delete;
+    FlatUIResourcePool& operator=(const FlatUIResourcePool&) = delete;
+
+    static uint64_t MakeKey(const wxColour& colour, int width, int style);
+    static uint64_t MakeFontKey(int pointSize, wxFontFamily family, wxFontStyle style, wxFontWeight weight);
+
+    // Fonts sharing the packed numeric attributes, told apart by face name (usually just one)
+    struct FontEntry {
+        wxString faceName;
+        wxFont font;
+    };
+
+    std::unordered_map<uint64_t, wxPen> m_pens;
+    std::unordered_map<uint64_t, wxBrush> m_brushes;
+    std::unordered_map<uint64_t, std::vector<FontEntry>> m_fonts;
+    Stats m_stats;
+};
+
+#endif // FLATUIRESOURCEPOOL_H
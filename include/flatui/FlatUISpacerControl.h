@@ -2,6 +2,7 @@
 #define FLATUI_SPACER_CONTROL_H
 
 #include <wx/wx.h>
+#include "config/ThemeManager.h"
 class FlatUISpacerControl : public wxControl
 {
 public:
@@ -43,6 +44,7 @@ private:
     bool m_showDragFlag;
     bool m_dragging;       
     wxPoint m_dragStartPos; 
+    ThemeSubscription m_themeSubscription; // Repaints only on edits to keys read in OnPaint
 };
 
 #endif // FLATUI_SPACER_CONTROL_H 
\ No newline at end of file
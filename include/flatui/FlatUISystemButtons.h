@@ -2,6 +2,7 @@
 #define FLATUI_SYSTEM_BUTTONS_H
 
 #include <wx/wx.h>
+#include "config/ThemeManager.h"
 
 class FlatUISystemButtons : public wxControl
 {
@@ -43,6 +44,7 @@ private:
     void PaintButton(wxDC& dc, const wxRect& rect, const wxString& symbol, bool hover, bool isClose = false, bool isMaximized = false);
     void PaintSvgButton(wxDC& dc, const wxRect& rect, const wxString& iconName, bool hover, bool isClose = false);
 
+    ThemeSubscription m_themeSubscription; // Repaints only on edits to keys read in OnPaint
 };
 
 #endif // FLATUI_SYSTEM_BUTTONS_H 
\ No newline at end of file
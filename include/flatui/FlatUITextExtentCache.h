@@ -0,0 +1,67 @@
+#ifndef FLATUITEXTEXTENTCACHE_H
+#define FLATUITEXTEXTENTCACHE_H
+
+#include <wx/wx.h>
+#include <cstdint>
+#include "config/LruCache.h"
+
+/**
+ * @class FlatUITextExtentCache
+ * @brief Process-wide cache of text extents shared by the FlatUI controls.
+ * Entries are keyed by the identity of the DC font (its native description
+ * plus the DC resolution) and the string, bounded by an LRU entry count.
+ * The cache is cleared on theme changes and DPI changes; a font that changes
+ * otherwise simply gets a new identity. UI thread only.
+ */
+class FlatUITextExtentCache
+{
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t capacity = 0;
+
+        double HitRatio() const { return hits + misses > 0 ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
+    static FlatUITextExtentCache& GetInstance();
+
+    // Extent of the text in the DC's current font; measured with the DC on a miss
+    wxSize GetTextExtent(wxDC& dc, const wxString& text);
+
+    void Clear();
+
+    Stats GetStats() const;
+    void ResetStats();
+    void LogStats() const;
+
+private:
+    FlatUITextExtentCache();
+    ~FlatUITextExtentCache();
+    FlatUITextExtentCache(const FlatUITextExtentCache&) = delete;
+    FlatUITextExtentCache& operator=(const FlatUITextExtentCache&) = delete;
+
+    struct Key {
+        uint64_t font;
+        wxString text;
+
+        bool operator==(const Key& other) const { return font == other.font && text == other.text; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    uint64_t GetFontIdentity(const wxFont& font, const wxSize& ppi);
+
+    LruCache<Key, wxSize, KeyHash> m_extents;
+
+    // The last font is kept alive, so its ref data can never be reused by another font
+    wxFont m_lastFont;
+    wxSize m_lastPpi;
+    uint64_t m_lastFontId = 0;
+};
+
+#endif // FLATUITEXTEXTENTCACHE_H
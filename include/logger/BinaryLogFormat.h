@@ -0,0 +1,119 @@
+#ifndef BINARY_LOG_FORMAT_H
+#define BINARY_LOG_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * On-disk layout of the binary log sink, shared by Logger and the LogDecoder tool.
+ *
+ * A file starts with the 8-byte magic and a u32 version, followed by a stream of
+ * entries, each introduced by a RecordType byte. All integers are little-endian.
+ *
+ *   SessionStart  : (no payload) - clears the context/site tables
+ *   ContextDef    : u32 id, u32 length, bytes
+ *   SiteDef       : u32 id, u32 line, u32 length, file name bytes
+ *   Entry         : u64 timestamp (ns since epoch), u8 level, u32 context id,
+ *                   u32 site id, u32 length, message bytes
+ *
+ * Contexts and call sites are interned: their definition is written once per
+ * session, and every later Entry refers to it by id.
+ */
+namespace BinaryLog {
+
+    static const char Magic[8] = { 'F', 'L', 'B', 'L', 'O', 'G', '\0', '\1' };
+    static const uint32_t Version = 1;
+    static const uint32_t NoId = 0xFFFFFFFFu;
+
+    enum class RecordType : uint8_t {
+        SessionStart = 0x00,
+        ContextDef = 0x01,
+        SiteDef = 0x02,
+        Entry = 0x03
+    };
+
+    inline void PutU8(std::string& out, uint8_t v) {
+        out.push_back(static_cast<char>(v));
+    }
+
+    inline void PutU32(std::string& out, uint32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+        }
+    }
+
+    inline void PutU64(std::string& out, uint64_t v) {
+        for (int i = 0; i < 8; ++i) {
+            out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+        }
+    }
+
+    inline void PutBytes(std::string& out, const std::string& bytes) {
+        PutU32(out, static_cast<uint32_t>(bytes.size()));
+        out.append(bytes);
+    }
+
+    // Bounds-checked cursor over an in-memory buffer; every Read* returns false on truncation
+    class Reader {
+    public:
+        Reader(const char* data, size_t size) : m_data(data), m_size(size), m_pos(0) {}
+
+        bool AtEnd() const { return m_pos >= m_size; }
+        size_t Position() const { return m_pos; }
+
+        bool ReadU8(uint8_t& v) {
+            if (m_size - m_pos < 1) return false;
+            v = static_cast<uint8_t>(m_data[m_pos++]);
+            return true;
+        }
+
+        bool ReadU32(uint32_t& v) {
+            if (m_size - m_pos < 4) return false;
+            v = 0;
+            for (int i = 0; i < 4; ++i) {
+                v |= static_cast<uint32_t>(static_cast<uint8_t>(m_data[m_pos + i])) << (8 * i);
+            }
+            m_pos += 4;
+            return true;
+        }
+
+        bool ReadU64(uint64_t& v) {
+            if (m_size - m_pos < 8) return false;
+            v = 0;
+            for (int i = 0; i < 8; ++i) {
+                v |= static_cast<uint64_t>(static_cast<uint8_t>(m_data[m_pos + i])) << (8 * i);
+            }
+            m_pos += 8;
+            return true;
+        }
+
+        bool ReadBytes(std::string& v) {
+            uint32_t length = 0;
+            if (!ReadU32(length) || m_size - m_pos < length) return false;
+            v.assign(m_data + m_pos, length);
+            m_pos += length;
+            return true;
+        }
+
+        bool ReadMagic() {
+            if (m_size - m_pos < sizeof(Magic) || std::memcmp(m_data + m_pos, Magic, sizeof(Magic)) != 0) {
+                return false;
+            }
+            m_pos += sizeof(Magic);
+            return true;
+        }
+
+    private:
+        const char* m_data;
+        size_t m_size;
+        size_t m_pos;
+    };
+
+    inline const char* LevelName(uint8_t level) {
+        static const char* names[] = { "INF", "DBG", "WRN", "ERR" };
+        return level < 4 ? names[level] : "???";
+    }
+}
+
+#endif // BINARY_LOG_FORMAT_H
@@ -0,0 +1,43 @@
+#ifndef BINARY_LOG_WRITER_H
+#define BINARY_LOG_WRITER_H
+
+#include "logger/BinaryLogFormat.h"
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class BinaryLogWriter
+ * @brief Encodes log records into the BinaryLog format.
+ * Contexts and file/line sites are interned per session so each record only
+ * carries the timestamp, level, two ids and the message. Not thread-safe; the
+ * Logger serialises access under its write mutex.
+ */
+class BinaryLogWriter {
+public:
+    BinaryLogWriter() = default;
+    ~BinaryLogWriter();
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_out.is_open(); }
+    const std::string& GetPath() const { return m_path; }
+    uint64_t GetBytesWritten() const { return m_bytesWritten; } // Current file size, including buffered bytes
+
+    void Write(uint8_t level, uint64_t timestampNs, const std::string& context,
+               const std::string& file, int line, const std::string& message);
+    void Flush();
+
+private:
+    uint32_t InternContext(const std::string& context);
+    uint32_t InternSite(const std::string& file, int line);
+
+    std::ofstream m_out;
+    std::string m_path;
+    std::string m_buffer;
+    uint64_t m_bytesWritten = 0;
+    std::unordered_map<std::string, uint32_t> m_contextIds;
+    std::unordered_map<std::string, uint32_t> m_siteIds;
+};
+
+#endif // BINARY_LOG_WRITER_H
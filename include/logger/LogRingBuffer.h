@@ -0,0 +1,99 @@
+#ifndef LOG_RING_BUFFER_H
+#define LOG_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @class LogRingBuffer
+ * @brief Bounded lock-free multi-producer / single-consumer queue.
+ * Each slot carries a sequence number that tells producers and the consumer
+ * whether it is free or filled, so neither side ever takes a lock. Capacity is
+ * rounded up to a power of two. TryPush fails instead of blocking when full.
+ */
+template <typename T>
+class LogRingBuffer {
+public:
+    explicit LogRingBuffer(size_t capacity)
+        : m_capacity(RoundUpPow2(capacity < 2 ? 2 : capacity)),
+          m_mask(m_capacity - 1),
+          m_cells(new Cell[m_capacity]),
+          m_enqueuePos(0),
+          m_dequeuePos(0) {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LogRingBuffer(const LogRingBuffer&) = delete;
+    LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+    // Safe to call from any number of threads
+    bool TryPush(T&& value) {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return false; // full
+            }
+            else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; must only be called from a single thread
+    bool TryPop(T& out) {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell = &m_cells[pos & m_mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false; // empty
+        }
+        out = std::move(cell->value);
+        cell->sequence.store(pos + m_capacity, std::memory_order_release);
+        m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool IsEmpty() const {
+        return m_enqueuePos.load(std::memory_order_acquire) == m_dequeuePos.load(std::memory_order_acquire);
+    }
+
+    size_t Capacity() const { return m_capacity; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t RoundUpPow2(size_t v) {
+        size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    const size_t m_capacity;
+    const size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    // Keep producer and consumer cursors on separate cache lines
+    alignas(64) std::atomic<size_t> m_enqueuePos;
+    alignas(64) std::atomic<size_t> m_dequeuePos;
+};
+
+#endif // LOG_RING_BUFFER_H
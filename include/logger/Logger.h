@@ -5,10 +5,20 @@
 #include <fstream>
 #include <string>
 #include <set>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <ctime>
+#include "logger/LogRingBuffer.h"
+#include "logger/BinaryLogWriter.h"
 
 class Logger {
 public:
     enum class LogLevel { INF, DBG, WRN, ERR };
+    enum class OverflowPolicy { Drop, Block }; // What producers do when the async queue is full
 
     static Logger& getLogger();
     void SetOutputCtrl(wxTextCtrl* ctrl);
@@ -24,29 +34,133 @@ public:
     void SetLogLevels(const std::set<LogLevel>& levels, bool isSingleLevel); // Set allowed log levels
     bool ShouldLog(LogLevel level) const; // Check if a level should be logged
 
+    // Lock-free check used by the LOG_* macros before the message is built
+    static bool IsLevelEnabled(LogLevel level) {
+        return (levelMask.load(std::memory_order_relaxed) >> static_cast<unsigned>(level)) & 1u;
+    }
+
+    // Async mode: Log() only enqueues, a background thread formats and writes in batches.
+    // Shutdown() drains whatever is still queued.
+    void EnableAsync(size_t queueCapacity, int flushIntervalMs, OverflowPolicy policy);
+    bool IsAsync() const { return asyncRunning.load(std::memory_order_acquire); }
+
+    // Optional binary sink (see logger/BinaryLogFormat.h); keepTextLog=false stops writing app.log
+    bool EnableBinarySink(const std::string& path, bool keepTextLog);
+
+    // Segmented logs: the active file is renamed to <name>-<timestamp><ext> once it exceeds
+    // maxSegmentBytes or is older than intervalHours (0 disables either limit), and only the
+    // newest maxSegments archives are kept. The age of an existing file counts from its
+    // creation time. Rollover runs on the writer thread in async mode and on a helper thread
+    // in sync mode; old segments are deleted on a background thread.
+    void EnableRotation(uint64_t maxSegmentBytes, int maxSegments, int intervalHours);
+
 private:
+    struct LogRecord {
+        LogLevel level = LogLevel::INF;
+        std::time_t time = 0;
+        uint64_t timestampNs = 0;
+        std::string message;
+        std::string context;
+        std::string file;
+        int line = 0;
+    };
+
     Logger();
     ~Logger();
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
+    std::string FormatRecord(const LogRecord& record);
+    void WriteSync(const LogRecord& record);
+    bool EnqueueAsync(LogRecord& record);
+    void WriteBinary(const LogRecord& record);
+    bool EnsureTextLogOpen();
+    bool RotationDue() const;
+    void StartBackgroundRollover();
+    void RollOver();
+    static void PruneSegments(const std::string& activePath, int keep);
+    void WriterLoop();
+    void StopAsync();
+    void AppendToCtrl(const std::string& text);
+
     std::ofstream logFile;
     wxTextCtrl* logCtrl;
-    bool isShuttingDown = false;
+    std::atomic<bool> isShuttingDown{ false };
     std::set<LogLevel> allowedLogLevels; // Set of allowed log levels
+    inline static std::atomic<uint32_t> levelMask{ 0xFu }; // One bit per LogLevel, mirrors allowedLogLevels
     bool isSingleLevelMode = false; // True for single-level mode (log level and above)
+
+    // Guards logFile and the timestamp cache; held by the writer thread per batch
+    std::mutex writeMutex;
+    std::time_t cachedSecond = -1;
+    char cachedTimestamp[20] = {};
+    std::string logFilePath = "app.log";
+    bool textLogEnabled = true;
+    bool textLogOpenFailed = false; // Stops retrying the open on every call until the next rollover
+    BinaryLogWriter binaryWriter;
+
+    // Rotation state, guarded by writeMutex
+    bool rotationEnabled = false;
+    uint64_t maxSegmentBytes = 0;
+    int maxSegments = 0;
+    std::chrono::hours rotateInterval{ 0 };
+    uint64_t segmentBytes = 0;
+    std::chrono::system_clock::time_point segmentOpenedAt; // Wall clock, comparable with file times
+    bool rolloverPending = false; // A sync-mode rollover is queued on rolloverThread
+    std::thread rolloverThread;
+    std::thread pruneThread;
+
+    // Async state
+    std::unique_ptr<LogRingBuffer<LogRecord>> asyncQueue;
+    std::thread writerThread;
+    std::atomic<bool> asyncRunning{ false };
+    std::atomic<bool> writerIdle{ false };
+    std::atomic<uint64_t> droppedCount{ 0 };
+    std::atomic<int> asyncProducers{ 0 };     // Log() calls between the asyncRunning check and the push
+    std::atomic<uint64_t> popGeneration{ 0 }; // Bumped by the writer after each batch, Block policy only
+    std::mutex spaceMutex;
+    std::condition_variable spaceCv;          // Signalled with popGeneration for blocked producers
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+    std::chrono::milliseconds flushInterval{ 200 };
+    OverflowPolicy overflowPolicy = OverflowPolicy::Drop;
 };
 
+// Lowest level compiled into the binary, by LogLevel value (INF=0, DBG=1, WRN=2, ERR=3).
+// Call sites below it are discarded at compile time; release builds set it to 2.
+#ifndef FLATUI_MIN_LOG_LEVEL
+#define FLATUI_MIN_LOG_LEVEL 0
+#endif
+
+// The message and context expressions are only evaluated when the level is enabled
+#define FLATUI_LOG_IMPL(level, message, context) \
+    do { \
+        if constexpr (static_cast<int>(level) >= FLATUI_MIN_LOG_LEVEL) { \
+            if (Logger::IsLevelEnabled(level)) { \
+                Logger::getLogger().Log(level, std::string(message), std::string(context), __FILE__, __LINE__); \
+            } \
+        } \
+    } while (0)
+
+#define FLATUI_LOG_WX_IMPL(level, message, context) \
+    do { \
+        if constexpr (static_cast<int>(level) >= FLATUI_MIN_LOG_LEVEL) { \
+            if (Logger::IsLevelEnabled(level)) { \
+                Logger::getLogger().LogWx(level, message, context, __FILE__, __LINE__); \
+            } \
+        } \
+    } while (0)
+
 // Macros that explicitly use std::string conversion
-#define LOG_INF(message, context) Logger::getLogger().Log(Logger::LogLevel::INF, std::string(message), std::string(context), __FILE__, __LINE__)
-#define LOG_DBG(message, context) Logger::getLogger().Log(Logger::LogLevel::DBG, std::string(message), std::string(context), __FILE__, __LINE__)
-#define LOG_WRN(message, context) Logger::getLogger().Log(Logger::LogLevel::WRN, std::string(message), std::string(context), __FILE__, __LINE__)
-#define LOG_ERR(message, context) Logger::getLogger().Log(Logger::LogLevel::ERR, std::string(message), std::string(context), __FILE__, __LINE__)
+#define LOG_INF(message, context) FLATUI_LOG_IMPL(Logger::LogLevel::INF, message, context)
+#define LOG_DBG(message, context) FLATUI_LOG_IMPL(Logger::LogLevel::DBG, message, context)
+#define LOG_WRN(message, context) FLATUI_LOG_IMPL(Logger::LogLevel::WRN, message, context)
+#define LOG_ERR(message, context) FLATUI_LOG_IMPL(Logger::LogLevel::ERR, message, context)
 
 // Additional macros for wxString
-#define LOG_INF_WX(message, context) Logger::getLogger().LogWx(Logger::LogLevel::INF, message, context, __FILE__, __LINE__)
-#define LOG_DBG_WX(message, context) Logger::getLogger().LogWx(Logger::LogLevel::DBG, message, context, __FILE__, __LINE__)
-#define LOG_WRN_WX(message, context) Logger::getLogger().LogWx(Logger::LogLevel::WRN, message, context, __FILE__, __LINE__)
-#define LOG_ERR_WX(message, context) Logger::getLogger().LogWx(Logger::LogLevel::ERR, message, context, __FILE__, __LINE__)
+#define LOG_INF_WX(message, context) FLATUI_LOG_WX_IMPL(Logger::LogLevel::INF, message, context)
+#define LOG_DBG_WX(message, context) FLATUI_LOG_WX_IMPL(Logger::LogLevel::DBG, message, context)
+#define LOG_WRN_WX(message, context) FLATUI_LOG_WX_IMPL(Logger::LogLevel::WRN, message, context)
+#define LOG_ERR_WX(message, context) FLATUI_LOG_WX_IMPL(Logger::LogLevel::ERR, message, context)
 
 #endif
\ No newline at end of file
@@ -198,8 +198,8 @@ void FlatFrame::InitializeUI(const wxSize& size)
     FlatUIButtonBar* buttonBar1 = new FlatUIButtonBar(panel1);
 	buttonBar1->SetDisplayStyle(ButtonDisplayStyle::ICON_ONLY);
     wxBitmap fileMenuBmp("IDP_FILEMENU", wxBITMAP_TYPE_PNG_RESOURCE); 
-    buttonBar1->AddButton(wxID_OPEN, "Open", SVG_ICON("open", wxSize(16, 16)));
-    buttonBar1->AddButton(wxID_SAVE, "Save", SVG_ICON("save", wxSize(16, 16)));
+    buttonBar1->AddButton(wxID_OPEN, "Open", "open");
+    buttonBar1->AddButton(wxID_SAVE, "Save", "save");
     wxMenu* fileMenu = new wxMenu;
     fileMenu->Append(ID_Menu_NewProject_MainFrame, "&New Project...\tCtrl-N");
     fileMenu->Append(ID_Menu_OpenProject_MainFrame, "&Open Project...\tCtrl-O");
@@ -207,7 +207,7 @@ void FlatFrame::InitializeUI(const wxSize& size)
     recentFilesMenu->Append(wxID_ANY, "File2.cpp");
     fileMenu->AppendSubMenu(recentFilesMenu, "Recent &Files");
     fileMenu->AppendSeparator();
-    buttonBar1->AddButton(wxID_ANY, "File Menu", SVG_ICON("filemenu", wxSize(16, 16)), fileMenu);
+    buttonBar1->AddButton(wxID_ANY, "File Menu", "filemenu", fileMenu);
     panel1->AddButtonBar(buttonBar1, 0, wxEXPAND | wxALL, 5);
     FlatUIGallery* gallery1 = new FlatUIGallery(panel1);
     gallery1->AddItem(wxArtProvider::GetBitmap(wxART_FOLDER, wxART_OTHER, wxSize(16, 16)), wxID_ANY);
@@ -224,8 +224,8 @@ void FlatFrame::InitializeUI(const wxSize& size)
     panel2->SetHeaderTextColour(CFG_COLOUR("PanelHeaderTextColour"));
     panel2->SetHeaderBorderWidths(0, 0, 0, 0);
     FlatUIButtonBar* buttonBar2 = new FlatUIButtonBar(panel2);
-    buttonBar2->AddButton(wxID_HELP, "Help", SVG_ICON("help", wxSize(16, 16)));
-    buttonBar2->AddButton(wxID_INFO, "Info", SVG_ICON("info", wxSize(16, 16)));
+    buttonBar2->AddButton(wxID_HELP, "Help", "help");
+    buttonBar2->AddButton(wxID_INFO, "Info", "info");
     panel2->AddButtonBar(buttonBar2, 0, wxEXPAND | wxALL, 5);
     FlatUIButtonBar* toggleBar = new FlatUIButtonBar(panel2);
     toggleBar->SetDisplayStyle(ButtonDisplayStyle::TEXT_ONLY);
@@ -238,8 +238,8 @@ void FlatFrame::InitializeUI(const wxSize& size)
     FlatUIPage* page3 = new FlatUIPage(m_ribbon, "Edit");
     FlatUIPanel* panel3 = new FlatUIPanel(page3, "EditPanel", wxHORIZONTAL);
     FlatUIButtonBar* buttonBar3 = new FlatUIButtonBar(panel3);
-    buttonBar3->AddButton(wxID_COPY, "Pencil", SVG_ICON("pencil", wxSize(16, 16)));
-    buttonBar3->AddButton(wxID_PASTE, "Palette", SVG_ICON("palette", wxSize(16, 16)));
+    buttonBar3->AddButton(wxID_COPY, "Pencil", "pencil");
+    buttonBar3->AddButton(wxID_PASTE, "Palette", "palette");
     panel3->AddButtonBar(buttonBar3);
     page3->AddPanel(panel3);
     m_ribbon->AddPage(page3);
@@ -248,8 +248,8 @@ void FlatFrame::InitializeUI(const wxSize& size)
     FlatUIPanel* panel4 = new FlatUIPanel(page4, "ViewPanel", wxHORIZONTAL);
     panel4->SetFont(defaultFont);
     FlatUIButtonBar* buttonBar4 = new FlatUIButtonBar(panel4);
-    buttonBar4->AddButton(wxID_FIND, "Find", SVG_ICON("find", wxSize(16, 16)));
-    buttonBar4->AddButton(wxID_SELECTALL, "Select", SVG_ICON("select", wxSize(16, 16)));
+    buttonBar4->AddButton(wxID_FIND, "Find", "find");
+    buttonBar4->AddButton(wxID_SELECTALL, "Select", "select");
     panel4->AddButtonBar(buttonBar4);
     page4->AddPanel(panel4);
     m_ribbon->AddPage(page4);
@@ -258,8 +258,8 @@ void FlatFrame::InitializeUI(const wxSize& size)
     FlatUIPanel* panel5 = new FlatUIPanel(page5, "HelpPanel", wxVERTICAL);
     panel5->SetFont(defaultFont);
     FlatUIButtonBar* buttonBar5 = new FlatUIButtonBar(panel5);
-    buttonBar5->AddButton(wxID_ABOUT, "About", SVG_ICON("about", wxSize(16, 16)));
-    buttonBar5->AddButton(wxID_STOP, "Ban", SVG_ICON("ban", wxSize(16, 16)));
+    buttonBar5->AddButton(wxID_ABOUT, "About", "about");
+    buttonBar5->AddButton(wxID_STOP, "Ban", "ban");
     panel5->AddButtonBar(buttonBar5);
     page5->AddPanel(panel5); 
     m_ribbon->AddPage(page5);
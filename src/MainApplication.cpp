@@ -5,9 +5,15 @@
 #include "config/ConfigManager.h"
 #include "config/LoggerConfig.h"
 #include "config/ConstantsConfig.h"
+#include "config/ConfigFileWatcher.h"
 #include "logger/Logger.h"
+#include "flatui/FlatUIBarPerformanceManager.h"
 #include "FlatFrame.h"
 
+MainApplication::MainApplication() = default;
+
+MainApplication::~MainApplication() = default;
+
 bool MainApplication::OnInit()
 {
     ConfigManager& cm = ConfigManager::getInstance();
@@ -43,4 +49,30 @@ bool MainApplication::OnInit()
     return true;
 }
 
+void MainApplication::OnEventLoopEnter(wxEventLoopBase* loop)
+{
+    wxApp::OnEventLoopEnter(loop);
+
+    // wxFileSystemWatcher needs a running event loop, so it cannot be created in OnInit
+    if (!m_configWatcher && loop && loop->IsMain() &&
+        ConfigManager::getInstance().getBool("Theme", "WatchConfigFile", false)) {
+        m_configWatcher = std::make_unique<ConfigFileWatcher>(ConfigManager::getInstance().getConfigFilePath());
+        if (!m_configWatcher->Start()) {
+            m_configWatcher.reset();
+        }
+    }
+}
+
+int MainApplication::OnExit()
+{
+    LOG_INF("Exiting application", "MainApplication");
+    FlatUIBarPerformanceManager::LogSharedStats();
+    m_configWatcher.reset();
+    // Write-behind config saves still pending must hit the disk before exit
+    ConfigManager::getInstance().shutdown();
+    // Drain the async log queue before static destructors run
+    Logger::getLogger().Shutdown();
+    return wxApp::OnExit();
+}
+
 wxIMPLEMENT_APP(MainApplication);
\ No newline at end of file
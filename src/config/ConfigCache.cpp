@@ -0,0 +1,333 @@
+#include "config/ConfigCache.h"
+#include "config/MappedFile.h"
+#include "logger/Logger.h"
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/settings.h>
+#include <wx/stdpaths.h>
+#include <cstring>
+
+namespace {
+    // Bump whenever the layout below or the meaning of a ThemeProfile field changes
+    const uint32_t kCacheVersion = 1;
+    const char kCacheMagic[8] = { 'F', 'L', 'C', 'F', 'G', '\0', '\0', '\1' };
+
+    // Native-endian header; the body is a sequence of u32 counts and length-prefixed strings
+    struct CacheHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t iniSize;
+        uint64_t iniMtimeMs;
+        uint64_t iniHash;
+    };
+
+    uint64_t Fnv1a(const void* data, size_t len, uint64_t hash = 1469598103934665603ULL) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    class Writer {
+    public:
+        void PutU32(uint32_t value) { Put(&value, sizeof(value)); }
+        void PutI32(int32_t value) { Put(&value, sizeof(value)); }
+
+        void PutString(const std::string& value) {
+            PutU32(static_cast<uint32_t>(value.size()));
+            Put(value.data(), value.size());
+        }
+
+        void Put(const void* data, size_t len) {
+            buffer.append(static_cast<const char*>(data), len);
+        }
+
+        std::string buffer;
+    };
+
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : cursor(data), end(data + size) {}
+
+        bool GetU32(uint32_t& value) { return Get(&value, sizeof(value)); }
+        bool GetI32(int32_t& value) { return Get(&value, sizeof(value)); }
+
+        bool GetString(std::string& value) {
+            uint32_t len = 0;
+            if (!GetU32(len) || static_cast<size_t>(end - cursor) < len) {
+                return false;
+            }
+            value.assign(reinterpret_cast<const char*>(cursor), len);
+            cursor += len;
+            return true;
+        }
+
+        bool Get(void* out, size_t len) {
+            if (static_cast<size_t>(end - cursor) < len) {
+                return false;
+            }
+            std::memcpy(out, cursor, len);
+            cursor += len;
+            return true;
+        }
+
+        bool AtEnd() const { return cursor == end; }
+
+    private:
+        const uint8_t* cursor;
+        const uint8_t* end;
+    };
+
+    void WriteProfile(Writer& out, const ThemeProfile& profile) {
+        out.PutString(profile.name);
+        out.PutString(profile.displayName);
+
+        out.PutU32(static_cast<uint32_t>(profile.colours.size()));
+        for (const auto& pair : profile.colours) {
+            out.PutString(pair.first);
+            uint8_t rgba[4] = { pair.second.Red(), pair.second.Green(), pair.second.Blue(), pair.second.Alpha() };
+            out.Put(rgba, sizeof(rgba));
+        }
+
+        out.PutU32(static_cast<uint32_t>(profile.integers.size()));
+        for (const auto& pair : profile.integers) {
+            out.PutString(pair.first);
+            out.PutI32(pair.second);
+        }
+
+        out.PutU32(static_cast<uint32_t>(profile.strings.size()));
+        for (const auto& pair : profile.strings) {
+            out.PutString(pair.first);
+            out.PutString(pair.second);
+        }
+
+        // Only the configured inputs are stored; the rest comes from the system font as in loadFont
+        out.PutI32(profile.defaultFont.IsOk() ? profile.defaultFont.GetPointSize() : 0);
+        out.PutString(profile.defaultFont.IsOk() ? std::string(profile.defaultFont.GetFaceName().utf8_str()) : std::string());
+    }
+
+    bool ReadProfile(Reader& in, ThemeProfile& profile) {
+        uint32_t count = 0;
+        if (!in.GetString(profile.name) || !in.GetString(profile.displayName) || !in.GetU32(count)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string key;
+            uint8_t rgba[4];
+            if (!in.GetString(key) || !in.Get(rgba, sizeof(rgba))) {
+                return false;
+            }
+            profile.colours[key] = wxColour(rgba[0], rgba[1], rgba[2], rgba[3]);
+        }
+
+        if (!in.GetU32(count)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string key;
+            int32_t value = 0;
+            if (!in.GetString(key) || !in.GetI32(value)) {
+                return false;
+            }
+            profile.integers[key] = value;
+        }
+
+        if (!in.GetU32(count)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string key;
+            std::string value;
+            if (!in.GetString(key) || !in.GetString(value)) {
+                return false;
+            }
+            profile.strings[key] = value;
+        }
+
+        int32_t pointSize = 0;
+        std::string faceName;
+        if (!in.GetI32(pointSize) || !in.GetString(faceName)) {
+            return false;
+        }
+        profile.defaultFont = wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT);
+        if (pointSize > 0) {
+            profile.defaultFont.SetPointSize(pointSize);
+        }
+        if (!faceName.empty()) {
+            profile.defaultFont.SetFaceName(wxString::FromUTF8(faceName));
+        }
+        return true;
+    }
+}
+
+ConfigCache::ConfigCache(const std::string& iniPath)
+    : iniPath(iniPath)
+{
+    // One snapshot per INI location, so portable and per-user configs never collide
+    wxString cacheDir = wxStandardPaths::Get().GetUserLocalDataDir() + wxFILE_SEP_PATH + "ConfigCache";
+    cachePath = wxString::Format("%s%sconfig_%016llx.bin", cacheDir, wxFILE_SEP_PATH,
+                                 static_cast<unsigned long long>(Fnv1a(iniPath.data(), iniPath.size())));
+}
+
+bool ConfigCache::ReadIniStamp(IniStamp& stamp, bool withHash) const
+{
+    wxString iniFile(iniPath);
+    wxFileName ini(iniFile);
+    wxDateTime modified = ini.GetModificationTime();
+    wxULongLong size = ini.GetSize();
+    if (!modified.IsValid() || size == wxInvalidSize) {
+        return false;
+    }
+    stamp.mtimeMs = static_cast<uint64_t>(modified.GetValue().GetValue());
+    stamp.size = size.GetValue();
+    stamp.hash = 0;
+
+    if (withHash) {
+        MappedFile mapped;
+        if (!mapped.Open(iniPath) || mapped.Size() != stamp.size) {
+            return false;
+        }
+        stamp.hash = Fnv1a(mapped.Data(), mapped.Size());
+    }
+    return true;
+}
+
+bool ConfigCache::Load(ConfigCacheData& data) const
+{
+    MappedFile mapped;
+    if (!mapped.Open(std::string(cachePath.utf8_str())) || mapped.Size() < sizeof(CacheHeader)) {
+        return false;
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, mapped.Data(), sizeof(header));
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || header.version != kCacheVersion) {
+        return false;
+    }
+
+    // Size and mtime reject most edits cheaply; the hash catches same-size edits within the mtime resolution
+    IniStamp stamp;
+    if (!ReadIniStamp(stamp, false) || stamp.size != header.iniSize || stamp.mtimeMs != header.iniMtimeMs) {
+        return false;
+    }
+    if (!ReadIniStamp(stamp, true) || stamp.hash != header.iniHash) {
+        return false;
+    }
+
+    ConfigCacheData loaded;
+    Reader in(mapped.Data() + sizeof(header), mapped.Size() - sizeof(header));
+
+    uint32_t sectionCount = 0;
+    if (!in.GetU32(sectionCount)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < sectionCount; ++i) {
+        std::string section;
+        uint32_t keyCount = 0;
+        if (!in.GetString(section) || !in.GetU32(keyCount)) {
+            return false;
+        }
+        ConfigCacheData::SectionValues& values = loaded.sections[section];
+        for (uint32_t k = 0; k < keyCount; ++k) {
+            std::string key;
+            std::string value;
+            if (!in.GetString(key) || !in.GetString(value)) {
+                return false;
+            }
+            values[key] = value;
+        }
+    }
+
+    uint32_t count = 0;
+    if (!in.GetU32(count)) {
+        return false;
+    }
+    loaded.themeSections.resize(count);
+    for (auto& section : loaded.themeSections) {
+        if (!in.GetString(section)) {
+            return false;
+        }
+    }
+
+    if (!in.GetU32(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        ThemeProfile profile;
+        if (!ReadProfile(in, profile)) {
+            return false;
+        }
+        loaded.themes[profile.name] = profile;
+    }
+
+    if (!in.AtEnd()) {
+        return false;
+    }
+
+    data = std::move(loaded);
+    return true;
+}
+
+bool ConfigCache::Store(const ConfigCacheData& data) const
+{
+    IniStamp stamp;
+    if (!ReadIniStamp(stamp, true)) {
+        return false;
+    }
+
+    CacheHeader header;
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kCacheVersion;
+    header.reserved = 0;
+    header.iniSize = stamp.size;
+    header.iniMtimeMs = stamp.mtimeMs;
+    header.iniHash = stamp.hash;
+
+    Writer out;
+    out.Put(&header, sizeof(header));
+    out.PutU32(static_cast<uint32_t>(data.sections.size()));
+    for (const auto& section : data.sections) {
+        out.PutString(section.first);
+        out.PutU32(static_cast<uint32_t>(section.second.size()));
+        for (const auto& entry : section.second) {
+            out.PutString(entry.first);
+            out.PutString(entry.second);
+        }
+    }
+
+    out.PutU32(static_cast<uint32_t>(data.themeSections.size()));
+    for (const auto& section : data.themeSections) {
+        out.PutString(section);
+    }
+
+    out.PutU32(static_cast<uint32_t>(data.themes.size()));
+    for (const auto& pair : data.themes) {
+        WriteProfile(out, pair.second);
+    }
+
+    wxString cacheDir = wxFileName(cachePath).GetPath();
+    if (!wxFileName::DirExists(cacheDir) && !wxFileName::Mkdir(cacheDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+        LOG_WRN(wxString::Format("ConfigCache: Could not create cache directory '%s'", cacheDir), "ConfigCache");
+        return false;
+    }
+
+    // Write to a temporary file and rename so a crash never leaves a torn snapshot
+    wxString tempPath = cachePath + ".tmp";
+    {
+        wxFile file;
+        if (!file.Create(tempPath, true) || file.Write(out.buffer.data(), out.buffer.size()) != out.buffer.size()) {
+            LOG_WRN(wxString::Format("ConfigCache: Failed to write snapshot '%s'", tempPath), "ConfigCache");
+            file.Close();
+            wxRemoveFile(tempPath);
+            return false;
+        }
+    }
+    if (!wxRenameFile(tempPath, cachePath, true)) {
+        wxRemoveFile(tempPath);
+        return false;
+    }
+    return true;
+}
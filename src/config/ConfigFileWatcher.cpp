@@ -0,0 +1,61 @@
+#include "config/ConfigFileWatcher.h"
+#include "config/ConfigManager.h"
+#include "config/ThemeManager.h"
+#include "logger/Logger.h"
+
+ConfigFileWatcher::ConfigFileWatcher(const wxString& configFilePath, int debounceMs)
+    : m_configFile(configFilePath), m_debounceTimer(this), m_debounceMs(debounceMs)
+{
+    m_configFile.MakeAbsolute();
+    Bind(wxEVT_FSWATCHER, &ConfigFileWatcher::OnFileSystemEvent, this);
+    Bind(wxEVT_TIMER, &ConfigFileWatcher::OnDebounceTimer, this, m_debounceTimer.GetId());
+}
+
+ConfigFileWatcher::~ConfigFileWatcher()
+{
+    m_debounceTimer.Stop();
+    if (m_watcher) {
+        m_watcher->RemoveAll();
+    }
+}
+
+bool ConfigFileWatcher::Start()
+{
+    if (m_watcher) {
+        return true;
+    }
+
+    m_watcher = std::make_unique<wxFileSystemWatcher>();
+    m_watcher->SetOwner(this);
+    wxFileName dir = wxFileName::DirName(m_configFile.GetPath());
+    if (!m_watcher->Add(dir, wxFSW_EVENT_CREATE | wxFSW_EVENT_MODIFY | wxFSW_EVENT_RENAME)) {
+        LOG_WRN("ConfigFileWatcher: Could not watch " + dir.GetFullPath().ToStdString(), "ConfigFileWatcher");
+        m_watcher.reset();
+        return false;
+    }
+
+    LOG_INF("ConfigFileWatcher: Watching " + m_configFile.GetFullPath().ToStdString(), "ConfigFileWatcher");
+    return true;
+}
+
+void ConfigFileWatcher::OnFileSystemEvent(wxFileSystemWatcherEvent& event)
+{
+    // A rename reports the config file as the new path when an editor replaces it
+    bool affected = event.GetPath().SameAs(m_configFile) ||
+        (event.GetChangeType() == wxFSW_EVENT_RENAME && event.GetNewPath().SameAs(m_configFile));
+    if (affected) {
+        m_debounceTimer.StartOnce(m_debounceMs);
+    }
+}
+
+void ConfigFileWatcher::OnDebounceTimer(wxTimerEvent& WXUNUSED(event))
+{
+    if (!m_configFile.FileExists()) {
+        return; // Mid-save; the create or rename that follows restarts the timer
+    }
+
+    std::vector<ConfigChange> changes = ConfigManager::getInstance().reloadChanges();
+    if (!changes.empty()) {
+        ThemeManager::getInstance().applyConfigChanges(changes);
+    }
+}
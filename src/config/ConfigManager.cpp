@@ -6,11 +6,73 @@
 #include <wx/stdpaths.h>
 #include <wx/filename.h>
 #include <wx/ffile.h>
+#include <wx/app.h>
+#include <wx/mstream.h>
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+    // Mirrors wxString::ToLong as used by wxFileConfig: trailing whitespace is ignored, nothing else is
+    bool parseLong(const std::string& text, long& value) {
+        size_t last = text.find_last_not_of(" \t\r\n\v\f");
+        if (last == std::string::npos) {
+            return false;
+        }
+        std::string trimmed = text.substr(0, last + 1);
+        char* end = nullptr;
+        errno = 0;
+        long parsed = std::strtol(trimmed.c_str(), &end, 10);
+        if (end != trimmed.c_str() + trimmed.size() || errno != 0) {
+            return false;
+        }
+        value = parsed;
+        return true;
+    }
 
-ConfigManager::ConfigManager() : initialized(false) {
+    // config.ini spells most switches as true/false, which wxFileConfig would only read as 1/0
+    bool parseBoolWord(const std::string& text, bool& value) {
+        std::string word;
+        for (char c : text) {
+            if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+                word += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+        }
+        if (word == "true" || word == "yes" || word == "on") {
+            value = true;
+            return true;
+        }
+        if (word == "false" || word == "no" || word == "off") {
+            value = false;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseDouble(const std::string& text, double& value) {
+        if (text.empty()) {
+            return false;
+        }
+        char* end = nullptr;
+        errno = 0;
+        double parsed = std::strtod(text.c_str(), &end);
+        if (end != text.c_str() + text.size() || errno != 0) {
+            return false;
+        }
+        value = parsed;
+        return true;
+    }
+}
+
+ConfigManager::ConfigManager() : initialized(false), dirty(false), snapshotStale(false) {
 }
 
 ConfigManager::~ConfigManager() {
+    // Normally done from MainApplication::OnExit while logging still works
+    writer.reset();
 }
 
 ConfigManager& ConfigManager::getInstance() {
@@ -71,12 +133,33 @@ bool ConfigManager::initialize(const std::string& configFilePath) {
         file.Close();
     }
 
-    // Initialize configuration object
-    fileConfig = std::make_unique<wxFileConfig>(wxEmptyString, wxEmptyString,
-        wxString(this->configFilePath), wxEmptyString,
-        wxCONFIG_USE_LOCAL_FILE);
+    // Prefer the binary snapshot; wxFileConfig is only created when the INI must be parsed or written
+    auto loadStart = std::chrono::steady_clock::now();
+    snapshot = std::make_unique<ConfigCache>(this->configFilePath);
+    bool fromSnapshot = snapshot->Load(cache);
+    if (!fromSnapshot) {
+        loadValuesFromFile();
+    }
+    snapshotStale = !fromSnapshot;
+    auto loadMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count();
+    LOG_INF(std::string(fromSnapshot ? "Loaded config snapshot" : "Parsed config file") + " in " +
+        std::to_string(loadMicros / 1000.0) + " ms", "ConfigManager");
 
     initialized = true;
+
+    int saveDelayMs = getInt("ConfigManager", "SaveDelayMs", 500);
+    if (saveDelayMs > 0) {
+        writer = std::make_unique<DeferredFileWriter>(this->configFilePath, std::chrono::milliseconds(saveDelayMs),
+            [this](bool ok) {
+                if (wxTheApp) {
+                    wxTheApp->CallAfter([this, ok]() { onWriteCompleted(ok); });
+                }
+            });
+        if (fileConfig) {
+            fileConfig->DisableAutoSave();
+        }
+    }
+
     LOG_INF("Configuration manager initialized successfully, config file: " + this->configFilePath, "ConfigManager");
 
     // Initialize Logger configuration
@@ -89,6 +172,11 @@ bool ConfigManager::initialize(const std::string& configFilePath) {
     // as it depends on other configurations being loaded first
     ThemeManager::getInstance().initialize(*this);
 
+    // Usually already written by ThemeManager together with the compiled themes
+    if (snapshotStale) {
+        storeSnapshot();
+    }
+
     return true;
 }
 
@@ -118,17 +206,102 @@ std::string ConfigManager::findConfigFile() {
     return "";
 }
 
+wxFileConfig& ConfigManager::getFileConfig() {
+    if (!fileConfig) {
+        fileConfig = std::make_unique<wxFileConfig>(wxEmptyString, wxEmptyString,
+            wxString(configFilePath), wxEmptyString,
+            wxCONFIG_USE_LOCAL_FILE);
+        // The writer owns the file; a destructor flush could race with a background write
+        if (writer) {
+            fileConfig->DisableAutoSave();
+        }
+    }
+    return *fileConfig;
+}
+
+void ConfigManager::loadValuesFromFile() {
+    wxFileConfig& config = getFileConfig();
+    cache.sections.clear();
+
+    // Collect groups first, SetPath resets the enumeration
+    std::vector<wxString> groups;
+    wxString group;
+    long groupIndex;
+    config.SetPath("/");
+    for (bool more = config.GetFirstGroup(group, groupIndex); more; more = config.GetNextGroup(group, groupIndex)) {
+        groups.push_back(group);
+    }
+
+    for (const auto& name : groups) {
+        config.SetPath("/" + name);
+        ConfigCacheData::SectionValues& values = cache.sections[name.ToStdString()];
+        wxString entry;
+        long entryIndex;
+        for (bool more = config.GetFirstEntry(entry, entryIndex); more; more = config.GetNextEntry(entry, entryIndex)) {
+            wxString value;
+            config.Read(entry, &value);
+            values[entry.ToStdString()] = value.ToStdString();
+        }
+    }
+}
+
+const std::string* ConfigManager::findValue(const std::string& section, const std::string& key) const {
+    auto sectionIt = cache.sections.find(section);
+    if (sectionIt == cache.sections.end()) {
+        return nullptr;
+    }
+    auto it = sectionIt->second.find(key);
+    return it != sectionIt->second.end() ? &it->second : nullptr;
+}
+
+bool ConfigManager::writeValue(const std::string& section, const std::string& key, const std::string& text) {
+    const std::string* current = findValue(section, key);
+    if (current && *current == text) {
+        return false;
+    }
+
+    cache.sections[section][key] = text;
+    dirty = true;
+    snapshotStale = true;
+
+    // Compiled themes depend on these sections; rebuild them on the next load
+    if (std::find(cache.themeSections.begin(), cache.themeSections.end(), section) != cache.themeSections.end()) {
+        cache.themes.clear();
+        cache.themeSections.clear();
+    }
+    return true;
+}
+
+void ConfigManager::storeSnapshot() {
+    // The snapshot is stamped with the INI on disk, so unsaved or unwritten values must not leak into it
+    if (!snapshot || dirty || (writer && !writer->IsIdle())) {
+        return;
+    }
+    if (snapshot->Store(cache)) {
+        snapshotStale = false;
+    }
+    else {
+        LOG_WRN("Failed to write config snapshot: " + snapshot->GetCachePath().ToStdString(), "ConfigManager");
+    }
+}
+
+void ConfigManager::onWriteCompleted(bool ok) {
+    if (!ok) {
+        LOG_ERR("Failed to write config file: " + configFilePath, "ConfigManager");
+        return;
+    }
+    // Skipped while a newer save is still queued; its own completion stores the snapshot
+    storeSnapshot();
+}
+
 std::string ConfigManager::getString(const std::string& section, const std::string& key, const std::string& defaultValue) {
     if (!initialized) {
         LOG_ERR("Configuration manager not initialized", "ConfigManager"); 
         return defaultValue;
     }
 
-    wxString value;
-    fileConfig->SetPath("/" + wxString(section));
-    bool success = fileConfig->Read(wxString(key), &value, wxString(defaultValue));
-    //LOG_INF("Reading config [" + section + "][" + key + "]: " + (success ? value.ToStdString() : "default: " + defaultValue), "ConfigManager");
-    return value.ToStdString();
+    const std::string* value = findValue(section, key);
+    return value ? *value : defaultValue;
 }
 
 int ConfigManager::getInt(const std::string& section, const std::string& key, int defaultValue) {
@@ -137,10 +310,12 @@ int ConfigManager::getInt(const std::string& section, const std::string& key, in
         return defaultValue;
     }
 
-    int value;
-    fileConfig->SetPath("/" + wxString(section));
-    fileConfig->Read(wxString(key), &value, defaultValue);
-    return value;
+    const std::string* text = findValue(section, key);
+    long value;
+    if (!text || !parseLong(*text, value) || value < INT_MIN || value > INT_MAX) {
+        return defaultValue;
+    }
+    return static_cast<int>(value);
 }
 
 double ConfigManager::getDouble(const std::string& section, const std::string& key, double defaultValue) {
@@ -149,9 +324,11 @@ double ConfigManager::getDouble(const std::string& section, const std::string& k
         return defaultValue;
     }
 
+    const std::string* text = findValue(section, key);
     double value;
-    fileConfig->SetPath("/" + wxString(section));
-    fileConfig->Read(wxString(key), &value, defaultValue);
+    if (!text || !parseDouble(*text, value)) {
+        return defaultValue;
+    }
     return value;
 }
 
@@ -161,10 +338,16 @@ bool ConfigManager::getBool(const std::string& section, const std::string& key,
         return defaultValue;
     }
 
-    bool value;
-    fileConfig->SetPath("/" + wxString(section));
-    fileConfig->Read(wxString(key), &value, defaultValue);
-    return value;
+    const std::string* text = findValue(section, key);
+    if (!text) {
+        return defaultValue;
+    }
+    long value;
+    if (parseLong(*text, value)) {
+        return value != 0;
+    }
+    bool flag;
+    return parseBoolWord(*text, flag) ? flag : defaultValue;
 }
 
 void ConfigManager::setString(const std::string& section, const std::string& key, const std::string& value) {
@@ -173,8 +356,12 @@ void ConfigManager::setString(const std::string& section, const std::string& key
         return;
     }
 
-    fileConfig->SetPath("/" + wxString(section));
-    fileConfig->Write(wxString(key), wxString(value));
+    if (!writeValue(section, key, value)) {
+        return;
+    }
+    wxFileConfig& config = getFileConfig();
+    config.SetPath("/" + wxString(section));
+    config.Write(wxString(key), wxString(value));
 }
 
 void ConfigManager::setInt(const std::string& section, const std::string& key, int value) {
@@ -183,8 +370,12 @@ void ConfigManager::setInt(const std::string& section, const std::string& key, i
         return;
     }
 
-    fileConfig->SetPath("/" + wxString(section));
-    fileConfig->Write(wxString(key), value);
+    if (!writeValue(section, key, std::to_string(value))) {
+        return;
+    }
+    wxFileConfig& config = getFileConfig();
+    config.SetPath("/" + wxString(section));
+    config.Write(wxString(key), value);
 }
 
 void ConfigManager::setDouble(const std::string& section, const std::string& key, double value) {
@@ -193,8 +384,13 @@ void ConfigManager::setDouble(const std::string& section, const std::string& key
         return;
     }
 
-    fileConfig->SetPath("/" + wxString(section));
-    fileConfig->Write(wxString(key), value);
+    // Same text wxConfigBase writes for doubles
+    if (!writeValue(section, key, wxString::FromCDouble(value).ToStdString())) {
+        return;
+    }
+    wxFileConfig& config = getFileConfig();
+    config.SetPath("/" + wxString(section));
+    config.Write(wxString(key), value);
 }
 
 void ConfigManager::setBool(const std::string& section, const std::string& key, bool value) {
@@ -203,8 +399,13 @@ void ConfigManager::setBool(const std::string& section, const std::string& key,
         return;
     }
 
-    fileConfig->SetPath("/" + wxString(section));
-    fileConfig->Write(wxString(key), value);
+    // wxConfigBase stores bools as 1/0
+    if (!writeValue(section, key, value ? "1" : "0")) {
+        return;
+    }
+    wxFileConfig& config = getFileConfig();
+    config.SetPath("/" + wxString(section));
+    config.Write(wxString(key), value);
 }
 
 bool ConfigManager::save() {
@@ -213,7 +414,45 @@ bool ConfigManager::save() {
         return false;
     }
 
-    return fileConfig->Flush();
+    if (!dirty) {
+        return true;
+    }
+
+    if (writer) {
+        // Serializing into memory keeps comments and order and takes microseconds; the disk I/O is deferred
+        wxMemoryOutputStream stream;
+        if (!getFileConfig().Save(stream)) {
+            return false;
+        }
+        std::string content(stream.GetLength(), '\0');
+        stream.CopyTo(&content[0], content.size());
+        writer->Submit(std::move(content));
+        dirty = false;
+        return true;
+    }
+
+    if (!getFileConfig().Flush()) {
+        return false;
+    }
+    dirty = false;
+    storeSnapshot();
+    return true;
+}
+
+void ConfigManager::shutdown() {
+    if (!initialized || !writer) {
+        return;
+    }
+
+    save();
+    if (!writer->Flush()) {
+        LOG_ERR("Failed to write config file on shutdown: " + configFilePath, "ConfigManager");
+    }
+    writer.reset();
+    if (fileConfig) {
+        fileConfig->EnableAutoSave();
+    }
+    storeSnapshot();
 }
 
 bool ConfigManager::reload() {
@@ -222,12 +461,80 @@ bool ConfigManager::reload() {
         return false;
     }
 
-    fileConfig = std::make_unique<wxFileConfig>(wxEmptyString, wxEmptyString,
-        wxString(configFilePath), wxEmptyString,
-        wxCONFIG_USE_LOCAL_FILE);
+    reloadChanges();
     return true;
 }
 
+std::vector<ConfigChange> ConfigManager::reloadChanges() {
+    std::vector<ConfigChange> changes;
+
+    if (!initialized) {
+        LOG_ERR("Configuration manager not initialized", "ConfigManager");
+        return changes;
+    }
+
+    // Pending writes must reach the file first, so they are not reported as changes. Waiting
+    // for them would block the UI thread on disk; the rename they end with fires the file
+    // watcher again, and the reload runs then
+    if (writer) {
+        save();
+        if (!writer->IsIdle()) {
+            LOG_DBG("Config reload deferred until the pending write lands", "ConfigManager");
+            return changes;
+        }
+    }
+    fileConfig.reset();
+    std::map<std::string, ConfigCacheData::SectionValues> previous = std::move(cache.sections);
+    loadValuesFromFile();
+    dirty = false;
+
+    for (const auto& section : previous) {
+        auto current = cache.sections.find(section.first);
+        for (const auto& entry : section.second) {
+            if (current == cache.sections.end()) {
+                changes.push_back({ section.first, entry.first });
+                continue;
+            }
+            auto it = current->second.find(entry.first);
+            if (it == current->second.end() || it->second != entry.second) {
+                changes.push_back({ section.first, entry.first });
+            }
+        }
+    }
+    for (const auto& section : cache.sections) {
+        auto old = previous.find(section.first);
+        for (const auto& entry : section.second) {
+            if (old == previous.end() || old->second.find(entry.first) == old->second.end()) {
+                changes.push_back({ section.first, entry.first });
+            }
+        }
+    }
+
+    if (changes.empty()) {
+        return changes;
+    }
+
+    bool themesChanged = false;
+    for (const auto& change : changes) {
+        if (std::find(cache.themeSections.begin(), cache.themeSections.end(), change.section) != cache.themeSections.end()) {
+            themesChanged = true;
+            break;
+        }
+    }
+    snapshotStale = true;
+    if (themesChanged) {
+        // ThemeManager stores the snapshot again once it has rebuilt the profiles
+        cache.themes.clear();
+        cache.themeSections.clear();
+    }
+    else {
+        storeSnapshot();
+    }
+
+    LOG_INF("Reloaded config file, " + std::to_string(changes.size()) + " key(s) changed", "ConfigManager");
+    return changes;
+}
+
 std::string ConfigManager::getConfigFilePath() const {
     return configFilePath;
 }
@@ -240,12 +547,8 @@ std::vector<std::string> ConfigManager::getSections() {
         return sections;
     }
 
-    wxString str;
-    long index;
-    bool cont = fileConfig->GetFirstGroup(str, index);
-    while (cont) {
-        sections.push_back(str.ToStdString());
-        cont = fileConfig->GetNextGroup(str, index);
+    for (const auto& pair : cache.sections) {
+        sections.push_back(pair.first);
     }
 
     return sections;
@@ -259,15 +562,37 @@ std::vector<std::string> ConfigManager::getKeys(const std::string& section) {
         return keys;
     }
 
-    fileConfig->SetPath("/" + wxString(section));
-
-    wxString str;
-    long index;
-    bool cont = fileConfig->GetFirstEntry(str, index);
-    while (cont) {
-        keys.push_back(str.ToStdString());
-        cont = fileConfig->GetNextEntry(str, index);
+    auto it = cache.sections.find(section);
+    if (it != cache.sections.end()) {
+        for (const auto& pair : it->second) {
+            keys.push_back(pair.first);
+        }
     }
 
     return keys;
-}
\ No newline at end of file
+}
+
+const ConfigCacheData::SectionValues* ConfigManager::getSection(const std::string& section) const {
+    if (!initialized) {
+        LOG_ERR("Configuration manager not initialized", "ConfigManager");
+        return nullptr;
+    }
+
+    auto it = cache.sections.find(section);
+    return it != cache.sections.end() ? &it->second : nullptr;
+}
+
+bool ConfigManager::getPrecompiledThemes(std::map<std::string, ThemeProfile>& themes) const {
+    if (cache.themes.empty()) {
+        return false;
+    }
+    themes = cache.themes;
+    return true;
+}
+
+void ConfigManager::setPrecompiledThemes(const std::map<std::string, ThemeProfile>& themes, const std::vector<std::string>& sections) {
+    cache.themes = themes;
+    cache.themeSections = sections;
+    snapshotStale = true;
+    storeSnapshot();
+}
@@ -0,0 +1,117 @@
+#include "config/DeferredFileWriter.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+DeferredFileWriter::DeferredFileWriter(std::string path, std::chrono::milliseconds debounce, CompletionCallback onWritten)
+    : m_path(std::move(path)), m_debounce(debounce), m_onWritten(std::move(onWritten)) {
+    m_thread = std::thread(&DeferredFileWriter::WorkerLoop, this);
+}
+
+DeferredFileWriter::~DeferredFileWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void DeferredFileWriter::Submit(std::string content) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = std::move(content);
+        m_hasPending = true;
+        m_deadline = std::chrono::steady_clock::now() + m_debounce;
+    }
+    m_cv.notify_all();
+}
+
+bool DeferredFileWriter::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_hasPending && !m_writing) {
+        return m_lastResult;
+    }
+    m_flushRequested = true;
+    m_cv.notify_all();
+    m_idleCv.wait(lock, [this]() { return !m_hasPending && !m_writing; });
+    return m_lastResult;
+}
+
+bool DeferredFileWriter::IsIdle() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_hasPending && !m_writing;
+}
+
+uint64_t DeferredFileWriter::GetWriteCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_writeCount;
+}
+
+void DeferredFileWriter::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_cv.wait(lock, [this]() { return m_stopping || m_hasPending; });
+        if (!m_hasPending) {
+            return;
+        }
+
+        // Submit() pushes the deadline back, so keep waiting until the burst is over
+        while (!m_stopping && !m_flushRequested && std::chrono::steady_clock::now() < m_deadline) {
+            m_cv.wait_until(lock, m_deadline);
+        }
+
+        std::string content = std::move(m_pending);
+        m_pending.clear();
+        m_hasPending = false;
+        m_writing = true;
+        lock.unlock();
+
+        bool ok = WriteAtomically(m_path, content);
+
+        lock.lock();
+        m_writing = false;
+        m_lastResult = ok;
+        ++m_writeCount;
+        if (!m_hasPending) {
+            m_flushRequested = false;
+        }
+        m_idleCv.notify_all();
+
+        // Runs after the state update, so IsIdle() already reports this write as done
+        if (m_onWritten) {
+            lock.unlock();
+            m_onWritten(ok);
+            lock.lock();
+        }
+    }
+}
+
+bool DeferredFileWriter::WriteAtomically(const std::string& path, const std::string& content) {
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(content.data(), static_cast<std::streamsize>(content.size()))) {
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+        file.close();
+        if (!file) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    // Replaces an existing target on every platform, unlike std::rename on Windows
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,185 @@
+#include "config/IconArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+
+namespace {
+    const char kMagic[8] = { 'F', 'L', 'I', 'P', 'A', 'K', '\0', '\1' };
+    const size_t kHeaderSize = 24;
+    const size_t kIndexEntrySize = 16;
+
+    uint16_t ReadU16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t ReadU32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+            (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    uint64_t ReadU64(const uint8_t* p) {
+        return static_cast<uint64_t>(ReadU32(p)) | (static_cast<uint64_t>(ReadU32(p + 4)) << 32);
+    }
+
+    void WriteU16(std::string& out, uint16_t value) {
+        out += static_cast<char>(value & 0xFF);
+        out += static_cast<char>((value >> 8) & 0xFF);
+    }
+
+    void WriteU32(std::string& out, uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            out += static_cast<char>((value >> shift) & 0xFF);
+        }
+    }
+
+    void WriteU64(std::string& out, uint64_t value) {
+        WriteU32(out, static_cast<uint32_t>(value));
+        WriteU32(out, static_cast<uint32_t>(value >> 32));
+    }
+
+    bool EntryLess(std::string_view aName, std::string_view aVariant, std::string_view bName, std::string_view bVariant) {
+        return std::tie(aName, aVariant) < std::tie(bName, bVariant);
+    }
+}
+
+bool IconArchive::Open(const std::string& path) {
+    Close();
+    if (!m_file.Open(path)) {
+        return false;
+    }
+
+    const uint8_t* base = m_file.Data();
+    const size_t size = m_file.Size();
+    if (size < kHeaderSize || std::memcmp(base, kMagic, sizeof(kMagic)) != 0 ||
+        ReadU32(base + 8) != kVersion || ReadU64(base + 16) != size) {
+        Close();
+        return false;
+    }
+
+    const uint32_t count = ReadU32(base + 12);
+    if (count > (size - kHeaderSize) / kIndexEntrySize) {
+        Close();
+        return false;
+    }
+
+    // Validate every span once so lookups can trust the index
+    const char* chars = reinterpret_cast<const char*>(base);
+    m_entries.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint8_t* record = base + kHeaderSize + static_cast<size_t>(i) * kIndexEntrySize;
+        uint64_t keyOffset = ReadU32(record);
+        uint64_t nameLength = ReadU16(record + 4);
+        uint64_t variantLength = ReadU16(record + 6);
+        uint64_t dataOffset = ReadU32(record + 8);
+        uint64_t dataLength = ReadU32(record + 12);
+        if (keyOffset + nameLength + variantLength > size || dataOffset + dataLength > size) {
+            Close();
+            return false;
+        }
+        Entry entry;
+        entry.name = std::string_view(chars + keyOffset, nameLength);
+        entry.variant = std::string_view(chars + keyOffset + nameLength, variantLength);
+        entry.data = std::string_view(chars + dataOffset, dataLength);
+        m_entries.push_back(entry);
+    }
+
+    std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) {
+        return EntryLess(a.name, a.variant, b.name, b.variant);
+    });
+    m_path = path;
+    return true;
+}
+
+void IconArchive::Close() {
+    m_entries.clear();
+    m_path.clear();
+    m_file.Close();
+}
+
+bool IconArchive::Find(std::string_view name, std::string_view variant, std::string_view& data) const {
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), std::make_pair(name, variant),
+        [](const Entry& entry, const std::pair<std::string_view, std::string_view>& key) {
+            return EntryLess(entry.name, entry.variant, key.first, key.second);
+        });
+    if (it == m_entries.end() || it->name != name || it->variant != variant) {
+        return false;
+    }
+    data = it->data;
+    return true;
+}
+
+void IconArchiveWriter::Add(std::string name, std::string variant, std::string data) {
+    m_entries.push_back({ std::move(name), std::move(variant), std::move(data) });
+}
+
+bool IconArchiveWriter::Write(const std::string& path, std::string* error) const {
+    auto fail = [error](const std::string& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    const size_t count = m_entries.size();
+    uint64_t stringsSize = 0;
+    uint64_t payloadSize = 0;
+    for (const PendingEntry& entry : m_entries) {
+        if (entry.name.size() > 0xFFFF || entry.variant.size() > 0xFFFF) {
+            return fail("icon name or variant too long: " + entry.name);
+        }
+        stringsSize += entry.name.size() + entry.variant.size();
+        payloadSize += entry.data.size();
+    }
+
+    const uint64_t indexEnd = kHeaderSize + static_cast<uint64_t>(count) * kIndexEntrySize;
+    const uint64_t fileSize = indexEnd + stringsSize + payloadSize;
+    if (fileSize > 0xFFFFFFFFull) {
+        return fail("archive exceeds 4 GB");
+    }
+
+    std::string out;
+    out.reserve(static_cast<size_t>(fileSize));
+    out.append(kMagic, sizeof(kMagic));
+    WriteU32(out, IconArchive::kVersion);
+    WriteU32(out, static_cast<uint32_t>(count));
+    WriteU64(out, fileSize);
+
+    uint64_t keyOffset = indexEnd;
+    uint64_t dataOffset = indexEnd + stringsSize;
+    for (const PendingEntry& entry : m_entries) {
+        WriteU32(out, static_cast<uint32_t>(keyOffset));
+        WriteU16(out, static_cast<uint16_t>(entry.name.size()));
+        WriteU16(out, static_cast<uint16_t>(entry.variant.size()));
+        WriteU32(out, static_cast<uint32_t>(dataOffset));
+        WriteU32(out, static_cast<uint32_t>(entry.data.size()));
+        keyOffset += entry.name.size() + entry.variant.size();
+        dataOffset += entry.data.size();
+    }
+    for (const PendingEntry& entry : m_entries) {
+        out += entry.name;
+        out += entry.variant;
+    }
+    for (const PendingEntry& entry : m_entries) {
+        out += entry.data;
+    }
+
+    std::filesystem::path target = std::filesystem::u8path(path);
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+            return fail("cannot write " + temp.u8string());
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return fail("cannot replace " + path);
+    }
+    return true;
+}
@@ -0,0 +1,158 @@
+#include "config/IconAtlas.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    const int kInitialHeight = 64;
+}
+
+std::shared_ptr<IconAtlas> IconAtlas::Create(int pageWidth, int maxHeight)
+{
+    return std::shared_ptr<IconAtlas>(new IconAtlas(pageWidth, maxHeight));
+}
+
+IconAtlas::IconAtlas(int pageWidth, int maxHeight)
+    : m_width(pageWidth), m_maxHeight(maxHeight)
+{
+}
+
+bool IconAtlas::Grow(int requiredHeight)
+{
+    int newHeight = std::max(m_height, kInitialHeight);
+    while (newHeight < requiredHeight) {
+        newHeight *= 2;
+    }
+    newHeight = std::min(newHeight, m_maxHeight);
+    if (newHeight < requiredHeight) {
+        return false;
+    }
+    if (newHeight == m_height) {
+        return true;
+    }
+
+    // Keep existing rows in place so handed-out rects stay valid
+    wxImage grown(m_width, newHeight, true);
+    grown.InitAlpha();
+    std::memset(grown.GetAlpha(), 0, static_cast<size_t>(m_width) * newHeight);
+    if (m_pixels.IsOk()) {
+        std::memcpy(grown.GetData(), m_pixels.GetData(), static_cast<size_t>(m_width) * m_height * 3);
+        std::memcpy(grown.GetAlpha(), m_pixels.GetAlpha(), static_cast<size_t>(m_width) * m_height);
+    }
+    m_pixels = grown;
+    m_height = newHeight;
+    m_dirty = true;
+    return true;
+}
+
+bool IconAtlas::Allocate(const wxSize& size, wxRect& rect)
+{
+    if (size.GetWidth() <= 0 || size.GetHeight() <= 0 || size.GetWidth() > m_width) {
+        return false;
+    }
+
+    // Best-fit shelf: the shortest one that is tall enough and has room left
+    Shelf* best = nullptr;
+    for (auto& shelf : m_shelves) {
+        if (shelf.height >= size.GetHeight() && shelf.nextX + size.GetWidth() <= m_width &&
+            (!best || shelf.height < best->height)) {
+            best = &shelf;
+        }
+    }
+
+    if (!best) {
+        if (!Grow(m_usedHeight + size.GetHeight())) {
+            return false;
+        }
+        m_shelves.push_back({ m_usedHeight, size.GetHeight(), 0 });
+        m_usedHeight += size.GetHeight();
+        best = &m_shelves.back();
+    }
+
+    rect = wxRect(best->nextX, best->y, size.GetWidth(), size.GetHeight());
+    best->nextX += size.GetWidth();
+    ++m_iconCount;
+    return true;
+}
+
+IconAtlasHandle IconAtlas::Add(const wxImage& image)
+{
+    wxRect rect;
+    if (!image.IsOk() || !Allocate(image.GetSize(), rect)) {
+        return IconAtlasHandle();
+    }
+
+    const unsigned char* srcRgb = image.GetData();
+    const unsigned char* srcAlpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+    unsigned char* dstRgb = m_pixels.GetData();
+    unsigned char* dstAlpha = m_pixels.GetAlpha();
+    for (int row = 0; row < rect.height; ++row) {
+        size_t src = static_cast<size_t>(row) * rect.width;
+        size_t dst = static_cast<size_t>(rect.y + row) * m_width + rect.x;
+        std::memcpy(dstRgb + dst * 3, srcRgb + src * 3, static_cast<size_t>(rect.width) * 3);
+        if (srcAlpha) {
+            std::memcpy(dstAlpha + dst, srcAlpha + src, rect.width);
+        } else {
+            std::memset(dstAlpha + dst, 0xFF, rect.width);
+        }
+    }
+
+    m_dirty = true;
+    return IconAtlasHandle{ shared_from_this(), rect };
+}
+
+IconAtlasHandle IconAtlas::Add(const wxBitmap& bitmap)
+{
+    if (!bitmap.IsOk()) {
+        return IconAtlasHandle();
+    }
+    return Add(bitmap.ConvertToImage());
+}
+
+IconAtlasHandle IconAtlas::AddEmpty(const wxSize& size)
+{
+    // Fresh atlas rows are already transparent
+    wxRect rect;
+    if (!Allocate(size, rect)) {
+        return IconAtlasHandle();
+    }
+    return IconAtlasHandle{ shared_from_this(), rect };
+}
+
+const wxBitmap& IconAtlas::GetSurface()
+{
+    if (m_dirty && m_pixels.IsOk()) {
+        m_surface = wxBitmap(m_pixels);
+        m_dirty = false;
+    }
+    return m_surface;
+}
+
+IconAtlasPainter::IconAtlasPainter(wxDC& target)
+    : m_target(target)
+{
+}
+
+IconAtlasPainter::~IconAtlasPainter()
+{
+    if (m_selected) {
+        m_source.SelectObject(wxNullBitmap);
+    }
+}
+
+void IconAtlasPainter::Draw(const IconAtlasHandle& icon, int x, int y)
+{
+    if (!icon.IsOk()) {
+        return;
+    }
+
+    if (icon.atlas != m_selected) {
+        const wxBitmap& surface = icon.atlas->GetSurface();
+        if (!surface.IsOk()) {
+            return;
+        }
+        m_source.SelectObjectAsSource(surface);
+        m_selected = icon.atlas;
+    }
+
+    m_target.Blit(x, y, icon.rect.width, icon.rect.height, &m_source, icon.rect.x, icon.rect.y);
+}
@@ -0,0 +1,222 @@
+#include "config/IconDiskCache.h"
+#include "config/MappedFile.h"
+#include "logger/Logger.h"
+#include <wx/display.h>
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+    // Bump when the rasterization or recolouring output changes
+    const uint32_t kEntryVersion = 1;
+    const char kEntryMagic[8] = { 'F', 'L', 'I', 'C', 'O', 'N', '\0', '\1' };
+
+    enum EntryFlags : uint32_t {
+        HasAlpha = 1u << 0
+    };
+
+    // Native-endian header followed by width * height RGBA pixels
+    struct EntryHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t flags;
+        uint64_t keyHash;
+        uint64_t sourceMtimeMs;
+        uint64_t sourceSize;
+    };
+
+    uint64_t Fnv1a(const void* data, size_t len, uint64_t hash = 1469598103934665603ULL) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+}
+
+IconDiskCache::IconDiskCache(const wxString& dir)
+    : cacheDir(dir)
+{
+    if (wxDisplay::GetCount() > 0) {
+        scaleFactor = wxDisplay(0u).GetScaleFactor();
+    }
+
+    if (!wxFileName::DirExists(cacheDir) && !wxFileName::Mkdir(cacheDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+        LOG_WRN(wxString::Format("IconDiskCache: Could not create cache directory '%s', disk cache disabled", cacheDir), "IconDiskCache");
+        return;
+    }
+    available = true;
+}
+
+uint64_t IconDiskCache::HashKey(const wxString& name, const wxSize& size, const wxString& themeTag) const
+{
+    wxScopedCharBuffer nameUtf8 = name.utf8_str();
+    wxScopedCharBuffer themeUtf8 = themeTag.utf8_str();
+    int32_t dims[2] = { size.GetWidth(), size.GetHeight() };
+    uint32_t scaleMilli = static_cast<uint32_t>(scaleFactor * 1000.0 + 0.5);
+
+    uint64_t hash = Fnv1a(nameUtf8.data(), nameUtf8.length());
+    hash = Fnv1a("\0", 1, hash);
+    hash = Fnv1a(themeUtf8.data(), themeUtf8.length(), hash);
+    hash = Fnv1a(dims, sizeof(dims), hash);
+    hash = Fnv1a(&scaleMilli, sizeof(scaleMilli), hash);
+    return Fnv1a(&kEntryVersion, sizeof(kEntryVersion), hash);
+}
+
+wxString IconDiskCache::GetEntryPath(const wxString& name, const wxSize& size, uint64_t keyHash) const
+{
+    return wxString::Format("%s%s%s_%dx%d_%016llx.icache", cacheDir, wxFILE_SEP_PATH, name,
+                            size.GetWidth(), size.GetHeight(), static_cast<unsigned long long>(keyHash));
+}
+
+bool IconDiskCache::GetSourceStamp(const wxString& sourcePath, SourceStamp& stamp)
+{
+    wxFileName source(sourcePath);
+    wxDateTime modified = source.GetModificationTime();
+    wxULongLong size = source.GetSize();
+    if (!modified.IsValid() || size == wxInvalidSize) {
+        return false;
+    }
+    stamp.mtimeMs = static_cast<uint64_t>(modified.GetValue().GetValue());
+    stamp.size = size.GetValue();
+    return true;
+}
+
+wxBitmap IconDiskCache::Load(const wxString& name, const wxSize& size, const wxString& themeTag, const wxString& sourcePath)
+{
+    if (!available) {
+        return wxBitmap();
+    }
+
+    uint64_t keyHash = HashKey(name, size, themeTag);
+    wxString entryPath = GetEntryPath(name, size, keyHash);
+
+    MappedFile mapped;
+    if (!mapped.Open(std::string(entryPath.utf8_str()))) {
+        ++stats.misses;
+        return wxBitmap();
+    }
+
+    SourceStamp stamp;
+    EntryHeader header;
+    size_t pixelCount = static_cast<size_t>(size.GetWidth()) * static_cast<size_t>(size.GetHeight());
+    bool valid = mapped.Size() == sizeof(header) + pixelCount * 4 && GetSourceStamp(sourcePath, stamp);
+    if (valid) {
+        std::memcpy(&header, mapped.Data(), sizeof(header));
+        valid = std::memcmp(header.magic, kEntryMagic, sizeof(kEntryMagic)) == 0
+             && header.version == kEntryVersion
+             && header.keyHash == keyHash
+             && header.width == static_cast<uint32_t>(size.GetWidth())
+             && header.height == static_cast<uint32_t>(size.GetHeight())
+             && header.sourceMtimeMs == stamp.mtimeMs
+             && header.sourceSize == stamp.size;
+    }
+    if (!valid) {
+        mapped.Close();
+        wxRemoveFile(entryPath);
+        ++stats.stale;
+        return wxBitmap();
+    }
+
+    // wxImage owns separate RGB and alpha planes; de-interleave straight from the mapping
+    const uint8_t* pixels = mapped.Data() + sizeof(header);
+    bool hasAlpha = (header.flags & HasAlpha) != 0;
+    unsigned char* rgb = static_cast<unsigned char*>(malloc(pixelCount * 3));
+    unsigned char* alpha = hasAlpha ? static_cast<unsigned char*>(malloc(pixelCount)) : nullptr;
+    if (!rgb || (hasAlpha && !alpha)) {
+        free(rgb);
+        free(alpha);
+        return wxBitmap();
+    }
+    for (size_t i = 0; i < pixelCount; ++i) {
+        rgb[i * 3] = pixels[i * 4];
+        rgb[i * 3 + 1] = pixels[i * 4 + 1];
+        rgb[i * 3 + 2] = pixels[i * 4 + 2];
+        if (alpha) {
+            alpha[i] = pixels[i * 4 + 3];
+        }
+    }
+
+    wxImage image(size.GetWidth(), size.GetHeight(), rgb, false);
+    if (alpha) {
+        image.SetAlpha(alpha, false);
+    }
+    ++stats.hits;
+    return wxBitmap(image);
+}
+
+void IconDiskCache::Store(const wxString& name, const wxSize& size, const wxString& themeTag, const wxString& sourcePath, const wxBitmap& bitmap)
+{
+    if (!available || !bitmap.IsOk() || bitmap.GetSize() != size) {
+        return;
+    }
+    Store(name, size, themeTag, sourcePath, bitmap.ConvertToImage());
+}
+
+void IconDiskCache::Store(const wxString& name, const wxSize& size, const wxString& themeTag, const wxString& sourcePath, const wxImage& image)
+{
+    if (!available || !image.IsOk() || image.GetSize() != size) {
+        return;
+    }
+
+    SourceStamp stamp;
+    if (!GetSourceStamp(sourcePath, stamp)) {
+        return;
+    }
+
+    uint64_t keyHash = HashKey(name, size, themeTag);
+    size_t pixelCount = static_cast<size_t>(size.GetWidth()) * static_cast<size_t>(size.GetHeight());
+    const unsigned char* rgb = image.GetData();
+    const unsigned char* alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+
+    EntryHeader header;
+    std::memcpy(header.magic, kEntryMagic, sizeof(kEntryMagic));
+    header.version = kEntryVersion;
+    header.width = static_cast<uint32_t>(size.GetWidth());
+    header.height = static_cast<uint32_t>(size.GetHeight());
+    header.flags = alpha ? HasAlpha : 0;
+    header.keyHash = keyHash;
+    header.sourceMtimeMs = stamp.mtimeMs;
+    header.sourceSize = stamp.size;
+
+    std::vector<uint8_t> buffer(sizeof(header) + pixelCount * 4);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    uint8_t* pixels = buffer.data() + sizeof(header);
+    for (size_t i = 0; i < pixelCount; ++i) {
+        pixels[i * 4] = rgb[i * 3];
+        pixels[i * 4 + 1] = rgb[i * 3 + 1];
+        pixels[i * 4 + 2] = rgb[i * 3 + 2];
+        pixels[i * 4 + 3] = alpha ? alpha[i] : 255;
+    }
+
+    // Write to a temporary file and rename so a crash never leaves a torn entry. The UI thread
+    // and a prewarm worker can store the same key at once, so each write gets its own temp name
+    wxString entryPath = GetEntryPath(name, size, keyHash);
+    wxString tempPath = wxString::Format("%s.%lu-%u.tmp", entryPath, wxGetProcessId(), ++tempSerial);
+    {
+        wxFile file;
+        if (!file.Create(tempPath, true) || file.Write(buffer.data(), buffer.size()) != buffer.size()) {
+            LOG_WRN(wxString::Format("IconDiskCache: Failed to write cache entry '%s'", tempPath), "IconDiskCache");
+            file.Close();
+            wxRemoveFile(tempPath);
+            return;
+        }
+    }
+    if (!wxRenameFile(tempPath, entryPath, true)) {
+        wxRemoveFile(tempPath);
+        return;
+    }
+    ++writes;
+}
+
+IconDiskCache::Stats IconDiskCache::GetStats() const
+{
+    Stats result = stats;
+    result.writes = writes.load();
+    return result;
+}
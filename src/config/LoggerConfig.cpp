@@ -14,6 +14,58 @@ void LoggerConfig::initialize(ConfigManager& configManager) {
     LOG_INF("Reading LogLevel from config: " + logLevelStr, "LoggerConfig");
     configureLoggerLevels(logLevelStr);
     LOG_INF("Logger levels set to: " + logLevelStr, "LoggerConfig");
+    configureSinks(configManager);
+    configureRotation(configManager);
+    configureAsync(configManager);
+}
+
+void LoggerConfig::configureRotation(ConfigManager& configManager) {
+    int maxSegmentSizeMB = configManager.getInt("Logger", "MaxSegmentSizeMB", 0);
+    int maxSegments = configManager.getInt("Logger", "MaxSegments", 10);
+    int rotateIntervalHours = configManager.getInt("Logger", "RotateIntervalHours", 0);
+    if (maxSegmentSizeMB <= 0 && rotateIntervalHours <= 0) {
+        return;
+    }
+
+    uint64_t maxSegmentBytes = maxSegmentSizeMB > 0 ? static_cast<uint64_t>(maxSegmentSizeMB) * 1024 * 1024 : 0;
+    Logger::getLogger().EnableRotation(maxSegmentBytes, maxSegments, rotateIntervalHours);
+}
+
+void LoggerConfig::configureSinks(ConfigManager& configManager) {
+    std::string format = configManager.getString("Logger", "LogFormat", "Text");
+    std::transform(format.begin(), format.end(), format.begin(), ::tolower);
+    if (format == "text") {
+        return;
+    }
+    if (format != "binary" && format != "both") {
+        LOG_WRN("Unknown log format in config: " + format + ", using Text", "LoggerConfig");
+        return;
+    }
+
+    std::string binaryFile = configManager.getString("Logger", "BinaryLogFile", "app.blog");
+    Logger::getLogger().EnableBinarySink(binaryFile, format == "both");
+}
+
+void LoggerConfig::configureAsync(ConfigManager& configManager) {
+    if (!configManager.getBool("Logger", "AsyncEnabled", false)) {
+        return;
+    }
+
+    int queueCapacity = configManager.getInt("Logger", "AsyncQueueCapacity", 8192);
+    int flushIntervalMs = configManager.getInt("Logger", "AsyncFlushIntervalMs", 200);
+    std::string policyStr = configManager.getString("Logger", "AsyncOverflowPolicy", "Drop");
+    std::transform(policyStr.begin(), policyStr.end(), policyStr.begin(), ::tolower);
+
+    Logger::OverflowPolicy policy = Logger::OverflowPolicy::Drop;
+    if (policyStr == "block") {
+        policy = Logger::OverflowPolicy::Block;
+    }
+    else if (policyStr != "drop") {
+        LOG_WRN("Unknown async overflow policy in config: " + policyStr + ", using Drop", "LoggerConfig");
+    }
+
+    Logger::getLogger().EnableAsync(queueCapacity > 0 ? static_cast<size_t>(queueCapacity) : 8192,
+                                    flushIntervalMs, policy);
 }
 
 void LoggerConfig::configureLoggerLevels(const std::string& logLevelStr) {
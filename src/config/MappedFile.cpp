@@ -0,0 +1,157 @@
+#include "config/MappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    MoveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        MoveFrom(other);
+    }
+    return *this;
+}
+
+void MappedFile::MoveFrom(MappedFile& other) noexcept {
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_open = other.m_open;
+#ifdef _WIN32
+    m_file = other.m_file;
+    m_mapping = other.m_mapping;
+    other.m_file = nullptr;
+    other.m_mapping = nullptr;
+#else
+    m_fd = other.m_fd;
+    other.m_fd = -1;
+#endif
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_open = false;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    int wideLen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring widePath(wideLen > 0 ? wideLen - 1 : 0, L'\0');
+    if (wideLen > 1) {
+        MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], wideLen);
+    }
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_open = true;
+    if (size.QuadPart == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        Close();
+        return false;
+    }
+    m_mapping = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        Close();
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    }
+    if (m_file) {
+        CloseHandle(static_cast<HANDLE>(m_file));
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_open = false;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_open = true;
+    if (st.st_size == 0) {
+        return true;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        Close();
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_fd = -1;
+    m_open = false;
+}
+
+#endif
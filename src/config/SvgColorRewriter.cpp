@@ -0,0 +1,417 @@
+#include "config/SvgColorRewriter.h"
+#include <cctype>
+
+namespace {
+    bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    char ToLower(char c) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    bool IEquals(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (ToLower(a[i]) != ToLower(b[i])) return false;
+        }
+        return true;
+    }
+
+    bool IStartsWith(std::string_view s, size_t pos, std::string_view prefix) {
+        return pos <= s.size() && s.size() - pos >= prefix.size() && IEquals(s.substr(pos, prefix.size()), prefix);
+    }
+
+    size_t IFind(std::string_view s, std::string_view needle, size_t from) {
+        for (size_t i = from; i + needle.size() <= s.size(); ++i) {
+            if (IStartsWith(s, i, needle)) return i;
+        }
+        return std::string_view::npos;
+    }
+
+    int HexDigit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    bool ParseUInt(std::string_view s, size_t& pos, int& value) {
+        size_t start = pos;
+        value = 0;
+        while (pos < s.size() && s[pos] >= '0' && s[pos] <= '9') {
+            value = value * 10 + (s[pos] - '0');
+            if (value > 100000) return false;
+            ++pos;
+        }
+        return pos > start;
+    }
+
+    int Brightness(int r, int g, int b) {
+        return static_cast<int>(0.299 * r + 0.587 * g + 0.114 * b);
+    }
+}
+
+SvgColorRewriter::SvgColorRewriter(const std::string& targetColour)
+    : m_target(targetColour) {
+}
+
+int SvgColorRewriter::ColourBrightness(std::string_view value) {
+    // Lower-cased, whitespace-free copy; colour values are short
+    std::string color;
+    color.reserve(value.size());
+    for (char c : value) {
+        if (!IsSpace(c)) color.push_back(ToLower(c));
+    }
+
+    if (!color.empty() && color[0] == '#') {
+        std::string_view hex(color);
+        hex.remove_prefix(1);
+        int digits[6];
+        if (hex.size() == 3 || hex.size() == 6) {
+            for (size_t i = 0; i < 6; ++i) {
+                int d = HexDigit(hex.size() == 3 ? hex[i / 2] : hex[i]);
+                if (d < 0) return -1;
+                digits[i] = d;
+            }
+            return Brightness(digits[0] * 16 + digits[1], digits[2] * 16 + digits[3], digits[4] * 16 + digits[5]);
+        }
+    }
+
+    // rgb(r,g,b) or rgba(r,g,b,a)
+    std::string_view s(color);
+    size_t pos = 0;
+    if (s.compare(0, 4, "rgb(") == 0) {
+        pos = 4;
+    }
+    else if (s.compare(0, 5, "rgba(") == 0) {
+        pos = 5;
+    }
+    if (pos > 0) {
+        int r = 0, g = 0, b = 0;
+        if (ParseUInt(s, pos, r) && pos < s.size() && s[pos++] == ',' &&
+            ParseUInt(s, pos, g) && pos < s.size() && s[pos++] == ',' &&
+            ParseUInt(s, pos, b)) {
+            if (pos < s.size() && s[pos] == ',') {
+                ++pos;
+                size_t alphaStart = pos;
+                while (pos < s.size() && ((s[pos] >= '0' && s[pos] <= '9') || s[pos] == '.')) ++pos;
+                if (pos == alphaStart) return -1;
+            }
+            if (pos + 1 == s.size() && s[pos] == ')') {
+                return Brightness(r, g, b);
+            }
+        }
+        return -1;
+    }
+
+    if (color == "white") return 255;
+    if (color == "black") return 0;
+    if (color == "gray" || color == "grey") return 128;
+    if (color == "lightgray" || color == "lightgrey" || color == "silver") return 192;
+    if (color == "darkgray" || color == "darkgrey") return 64;
+
+    return -1;
+}
+
+bool SvgColorRewriter::ShouldReplaceColour(std::string_view value) {
+    int brightness = ColourBrightness(value);
+    if (brightness >= 0) {
+        // Light colours (brightness > 180) are kept
+        return brightness <= 180;
+    }
+
+    std::string lower;
+    lower.reserve(value.size());
+    for (char c : value) lower.push_back(ToLower(c));
+
+    if (lower == "white" || lower == "#fff" || lower == "#ffffff" ||
+        lower == "transparent" || lower == "none" ||
+        lower.find("lightgray") != std::string::npos ||
+        lower.find("lightgrey") != std::string::npos ||
+        lower.find("silver") != std::string::npos) {
+        return false;
+    }
+
+    // Dark keywords and unknown values (currentColor, url(...), ...) are replaced
+    return true;
+}
+
+bool SvgColorRewriter::ShouldReplaceCached(std::string_view value) {
+    auto it = m_decisions.find(std::string(value));
+    if (it != m_decisions.end()) {
+        return it->second;
+    }
+    bool decision = ShouldReplaceColour(value);
+    m_decisions.emplace(std::string(value), decision);
+    return decision;
+}
+
+void SvgColorRewriter::AppendTarget(std::string& out) {
+    if (m_slots) {
+        m_slots->push_back(out.size());
+    }
+    out += m_target;
+}
+
+std::string SvgColorRewriter::Rewrite(std::string_view svg, std::vector<size_t>* colourSlots) {
+    std::string out;
+    out.reserve(svg.size() + svg.size() / 8 + 64);
+    m_seenSvgRoot = false;
+    m_wrapOpen = false;
+    m_slots = colourSlots;
+
+    const size_t n = svg.size();
+    size_t pos = 0;
+    while (pos < n) {
+        size_t lt = svg.find('<', pos);
+        if (lt == std::string_view::npos) {
+            out.append(svg.substr(pos));
+            break;
+        }
+        out.append(svg.substr(pos, lt - pos));
+        pos = lt;
+
+        // Markup that never carries paint attributes is copied through untouched
+        std::string_view terminator;
+        if (svg.compare(pos, 4, "<!--") == 0) {
+            terminator = "-->";
+        }
+        else if (svg.compare(pos, 9, "<![CDATA[") == 0) {
+            terminator = "]]>";
+        }
+        else if (svg.compare(pos, 2, "<?") == 0 || svg.compare(pos, 2, "<!") == 0) {
+            terminator = ">";
+        }
+        if (!terminator.empty()) {
+            size_t end = svg.find(terminator, pos + 2);
+            end = end == std::string_view::npos ? n : end + terminator.size();
+            out.append(svg.substr(pos, end - pos));
+            pos = end;
+            continue;
+        }
+
+        if (svg.compare(pos, 2, "</") == 0) {
+            size_t end = svg.find('>', pos);
+            end = end == std::string_view::npos ? n : end + 1;
+            if (m_wrapOpen && IStartsWith(svg, pos, "</svg>")) {
+                out += "</g>";
+                m_wrapOpen = false;
+            }
+            out.append(svg.substr(pos, end - pos));
+            pos = end;
+            continue;
+        }
+
+        RewriteTag(svg, pos, out);
+    }
+
+    m_slots = nullptr;
+    return out;
+}
+
+void SvgColorRewriter::RewriteTag(std::string_view svg, size_t& pos, std::string& out) {
+    const size_t n = svg.size();
+    size_t i = pos + 1;
+    while (i < n && !IsSpace(svg[i]) && svg[i] != '/' && svg[i] != '>') ++i;
+    std::string_view name = svg.substr(pos + 1, i - pos - 1);
+    if (name.empty()) {
+        out += '<';
+        ++pos;
+        return;
+    }
+    out.append(svg.substr(pos, i - pos));
+
+    const bool isGroup = IEquals(name, "g");
+    bool hasPaint = false;
+
+    while (i < n) {
+        size_t wsStart = i;
+        while (i < n && IsSpace(svg[i])) ++i;
+        if (i >= n) {
+            out.append(svg.substr(wsStart));
+            pos = n;
+            return;
+        }
+
+        if (svg[i] == '>' || svg[i] == '/') {
+            size_t tagEnd = svg.find('>', i);
+            if (tagEnd == std::string_view::npos) {
+                out.append(svg.substr(wsStart));
+                pos = n;
+                return;
+            }
+            out.append(svg.substr(wsStart, i - wsStart));
+            if (isGroup && !hasPaint) {
+                out += " fill=\"";
+                AppendTarget(out);
+                out += '"';
+            }
+            out.append(svg.substr(i, tagEnd + 1 - i));
+            pos = tagEnd + 1;
+
+            if (!m_seenSvgRoot && IEquals(name, "svg")) {
+                m_seenSvgRoot = true;
+                if (svg[i] == '>' && NeedsGroupWrapper(svg, pos)) {
+                    out += "<g fill=\"";
+                    AppendTarget(out);
+                    out += "\">";
+                    m_wrapOpen = true;
+                }
+            }
+            return;
+        }
+
+        size_t nameStart = i;
+        while (i < n && !IsSpace(svg[i]) && svg[i] != '=' && svg[i] != '>' && svg[i] != '/') ++i;
+        std::string_view attrName = svg.substr(nameStart, i - nameStart);
+
+        size_t j = i;
+        while (j < n && IsSpace(svg[j])) ++j;
+        if (j >= n || svg[j] != '=') {
+            // Attribute without a value
+            out.append(svg.substr(wsStart, i - wsStart));
+            continue;
+        }
+        ++j;
+        while (j < n && IsSpace(svg[j])) ++j;
+        if (j >= n) {
+            out.append(svg.substr(wsStart));
+            pos = n;
+            return;
+        }
+
+        char quote = svg[j];
+        if (quote != '"' && quote != '\'') {
+            // Unquoted value: copy up to the next separator
+            size_t end = j;
+            while (end < n && !IsSpace(svg[end]) && svg[end] != '>') ++end;
+            out.append(svg.substr(wsStart, end - wsStart));
+            i = end;
+            continue;
+        }
+
+        size_t valueStart = j + 1;
+        size_t valueEnd = svg.find(quote, valueStart);
+        if (valueEnd == std::string_view::npos) {
+            out.append(svg.substr(wsStart));
+            pos = n;
+            return;
+        }
+        std::string_view value = svg.substr(valueStart, valueEnd - valueStart);
+        i = valueEnd + 1;
+
+        bool isFill = IEquals(attrName, "fill");
+        if (isFill || IEquals(attrName, "stroke")) {
+            hasPaint = true;
+            if (!value.empty() && ShouldReplaceCached(value)) {
+                out.append(svg.substr(wsStart, nameStart - wsStart));
+                out += isFill ? "fill=\"" : "stroke=\"";
+                AppendTarget(out);
+                out += '"';
+                continue;
+            }
+        }
+        else if (IEquals(attrName, "style")) {
+            out.append(svg.substr(wsStart, valueStart - wsStart));
+            RewriteStyle(value, out);
+            out += quote;
+            continue;
+        }
+
+        out.append(svg.substr(wsStart, i - wsStart));
+    }
+
+    pos = n;
+}
+
+void SvgColorRewriter::RewriteStyle(std::string_view style, std::string& out) {
+    enum Property { Other = 0, Fill = 1, Stroke = 2 };
+
+    auto forEachDeclaration = [&style](auto&& visit) {
+        size_t pos = 0;
+        for (;;) {
+            size_t end = style.find(';', pos);
+            if (end == std::string_view::npos) end = style.size();
+
+            size_t nameBegin = pos;
+            while (nameBegin < end && IsSpace(style[nameBegin])) ++nameBegin;
+            size_t nameEnd = nameBegin;
+            while (nameEnd < end && !IsSpace(style[nameEnd]) && style[nameEnd] != ':') ++nameEnd;
+            size_t colon = nameEnd;
+            while (colon < end && IsSpace(style[colon])) ++colon;
+
+            int property = Other;
+            std::string_view value;
+            if (colon < end && style[colon] == ':') {
+                size_t valueBegin = colon + 1;
+                while (valueBegin < end && IsSpace(style[valueBegin])) ++valueBegin;
+                std::string_view prop = style.substr(nameBegin, nameEnd - nameBegin);
+                if (valueBegin < end) {
+                    property = IEquals(prop, "fill") ? Fill : IEquals(prop, "stroke") ? Stroke : Other;
+                    value = style.substr(valueBegin, end - valueBegin);
+                }
+            }
+            visit(nameBegin, end, property, value);
+
+            if (end == style.size()) break;
+            pos = end + 1;
+        }
+    };
+
+    // The first fill and the first stroke declaration decide for every declaration of that property
+    int decision[3] = { 0, -1, -1 };
+    forEachDeclaration([&](size_t, size_t, int property, std::string_view value) {
+        if (property != Other && decision[property] < 0) {
+            decision[property] = ShouldReplaceCached(value) ? 1 : 0;
+        }
+    });
+
+    size_t copied = 0;
+    forEachDeclaration([&](size_t nameBegin, size_t end, int property, std::string_view) {
+        if (property == Other || decision[property] != 1) {
+            return;
+        }
+        out.append(style.substr(copied, nameBegin - copied));
+        out += property == Fill ? "fill:" : "stroke:";
+        AppendTarget(out);
+        copied = end;
+    });
+    out.append(style.substr(copied));
+}
+
+bool SvgColorRewriter::NeedsGroupWrapper(std::string_view svg, size_t innerBegin) {
+    // Only icons whose root opens directly with a <path> are candidates
+    size_t first = innerBegin;
+    while (first < svg.size() && IsSpace(svg[first])) ++first;
+    if (!IStartsWith(svg, first, "<path")) {
+        return false;
+    }
+
+    size_t innerEnd = IFind(svg, "</svg>", innerBegin);
+    if (innerEnd == std::string_view::npos) {
+        return false;
+    }
+
+    // Wrap when some <path> has no <g ...> after it on the same line.
+    // Scanning backwards tracks "a group follows on this line" in O(n).
+    bool groupAhead = false;
+    bool closeAhead = false;
+    for (size_t i = innerEnd; i-- > innerBegin;) {
+        char c = svg[i];
+        if (c == '\n' || c == '\r') {
+            groupAhead = false;
+        }
+        else if (c == '>') {
+            closeAhead = true;
+        }
+        else if (c == '<' && closeAhead) {
+            if (IStartsWith(svg, i, "<path")) {
+                if (!groupAhead) return true;
+            }
+            else if (IStartsWith(svg, i, "<g")) {
+                groupAhead = true;
+            }
+        }
+    }
+    return false;
+}
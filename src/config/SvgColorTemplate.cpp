@@ -0,0 +1,22 @@
+#include "config/SvgColorTemplate.h"
+#include "config/SvgColorRewriter.h"
+
+SvgColorTemplate::SvgColorTemplate(std::string source)
+    : m_source(std::move(source)) {
+    // An empty target leaves each slot as a zero-width gap at the recorded offset
+    SvgColorRewriter rewriter("");
+    m_text = rewriter.Rewrite(m_source, &m_slots);
+}
+
+std::string SvgColorTemplate::Apply(std::string_view colour) const {
+    std::string out;
+    out.reserve(m_text.size() + m_slots.size() * colour.size());
+    size_t copied = 0;
+    for (size_t slot : m_slots) {
+        out.append(m_text, copied, slot - copied);
+        out.append(colour);
+        copied = slot;
+    }
+    out.append(m_text, copied, std::string::npos);
+    return out;
+}
@@ -1,20 +1,104 @@
 #include "config/SvgIconManager.h"
 #include "config/ThemeManager.h"
+#include "config/ConfigManager.h"
 #include "logger/Logger.h"
 #include <wx/filename.h>
 #include <wx/stdpaths.h>
 #include <wx/file.h>
-#include <regex>
 #include <algorithm>
+#include <cstring>
+#include <chrono>
 
 // Static member definitions
 std::unique_ptr<SvgIconManager> SvgIconManager::instance = nullptr;
 wxString SvgIconManager::defaultIconDir = "";
 
+namespace {
+    size_t BitmapCost(const wxBitmap& bitmap)
+    {
+        return bitmap.IsOk() ? static_cast<size_t>(bitmap.GetWidth()) * bitmap.GetHeight() * 4 : 0;
+    }
+
+    size_t TextCost(const wxString& text)
+    {
+        return text.length() * sizeof(wxStringCharType);
+    }
+
+    size_t BudgetFromConfig(const std::string& key, int defaultKB)
+    {
+        int kb = ConfigManager::getInstance().getInt("IconCache", key, defaultKB);
+        return static_cast<size_t>(kb > 0 ? kb : defaultKB) * 1024;
+    }
+
+    // The part of a theme that affects icon rendering; fallbacks match CFG_INT/CFG_COLOUR
+    struct IconColouring {
+        bool enabled = true;
+        wxColour primary = wxColour(255, 0, 0);
+    };
+
+    IconColouring ResolveIconColouring(const ThemeSnapshot* snapshot)
+    {
+        IconColouring colouring;
+        if (snapshot) {
+            if (const int* enabled = snapshot->FindInt(THEME_KEY("SvgThemeEnabled"))) {
+                colouring.enabled = *enabled != 0;
+            }
+            if (const wxColour* primary = snapshot->FindColour(THEME_KEY("SvgPrimaryIconColour"))) {
+                colouring.primary = *primary;
+            }
+        }
+        return colouring;
+    }
+
+    wxString BuildThemeTag(const std::string& themeName, const IconColouring& colouring)
+    {
+        wxString theme = wxString::FromUTF8(themeName);
+        if (!colouring.enabled) {
+            return theme + ":original";
+        }
+        return wxString::Format("%s:#%02x%02x%02x", theme,
+            colouring.primary.Red(), colouring.primary.Green(), colouring.primary.Blue());
+    }
+
+    // Runs on raster workers, so failures just yield an empty result
+    std::string ReadFileBytes(const std::string& pathUtf8)
+    {
+        wxFile file;
+        if (!file.Open(wxString::FromUTF8(pathUtf8), wxFile::read)) {
+            return std::string();
+        }
+        wxFileOffset length = file.Length();
+        if (length <= 0) {
+            return std::string();
+        }
+        std::string bytes(static_cast<size_t>(length), '\0');
+        if (file.Read(&bytes[0], bytes.size()) != static_cast<ssize_t>(bytes.size())) {
+            return std::string();
+        }
+        return bytes;
+    }
+}
+
+SvgIconManager::ThemedIconSet::ThemedIconSet()
+    : iconCache(BudgetFromConfig("BitmapCacheBudgetKB", 16384), BitmapCost),
+      bundleCache(BudgetFromConfig("BundleCacheBudgetKB", 4096)),
+      themedSvgCache(BudgetFromConfig("ThemedSvgCacheBudgetKB", 2048), TextCost)
+{
+}
+
 SvgIconManager::SvgIconManager(const wxString& dir)
-    : iconDir(dir)
+    : themed(std::make_shared<ThemedIconSet>()),
+      iconDir(dir)
 {
     LoadIcons();
+
+    if (ConfigManager::getInstance().getBool("IconCache", "DiskCacheEnabled", true)) {
+        wxString cacheDir = wxStandardPaths::Get().GetUserLocalDataDir() + wxFILE_SEP_PATH + "IconCache";
+        diskCache = std::make_unique<IconDiskCache>(cacheDir);
+        if (!diskCache->IsAvailable()) {
+            diskCache.reset();
+        }
+    }
 }
 
 SvgIconManager& SvgIconManager::GetInstance()
@@ -31,6 +115,11 @@ SvgIconManager& SvgIconManager::GetInstance()
     return *instance;
 }
 
+SvgIconManager* SvgIconManager::GetExistingInstance()
+{
+    return instance.get();
+}
+
 void SvgIconManager::SetDefaultIconDirectory(const wxString& dir)
 {
     defaultIconDir = dir;
@@ -40,6 +129,25 @@ void SvgIconManager::SetDefaultIconDirectory(const wxString& dir)
 
 void SvgIconManager::LoadIcons()
 {
+    // A packed archive next to the icon directory replaces per-file enumeration and reads
+    if (ConfigManager::getInstance().getBool("IconCache", "IconArchiveEnabled", true)) {
+        wxFileName archivePath(iconDir);
+        archivePath.SetFullName("icons.pack");
+        if (archivePath.FileExists()) {
+            wxString archiveFile = archivePath.GetFullPath();
+            if (iconArchive.Open(std::string(archiveFile.utf8_str()))) {
+                for (const auto& entry : iconArchive.GetEntries()) {
+                    if (entry.variant.empty()) {
+                        iconMap[wxString::FromUTF8(entry.name.data(), entry.name.size())] = archiveFile;
+                    }
+                }
+                LOG_INF(wxString::Format("SvgIconManager: Loaded %u SVG icons from archive '%s'", (unsigned int)iconMap.size(), archiveFile.ToStdString()), "SvgIconManager");
+                return;
+            }
+            LOG_WRN(wxString::Format("SvgIconManager: Ignoring invalid icon archive '%s'", archiveFile.ToStdString()), "SvgIconManager");
+        }
+    }
+
     if (!wxDir::Exists(iconDir)) {
         LOG_ERR(wxString::Format("SvgIconManager: Icon directory '%s' does not exist.", iconDir.ToStdString()), "SvgIconManager");
         return;
@@ -69,12 +177,23 @@ wxString SvgIconManager::GetCacheKey(const wxString& name, const wxSize& size) c
     return wxString::Format("%s_%dx%d", name, size.GetWidth(), size.GetHeight());
 }
 
+const wxString& SvgIconManager::GetThemeCacheTag()
+{
+    if (themed->tag.IsEmpty()) {
+        // ApplyThemeToSvg only depends on the enabled flag and the primary icon colour
+        ThemeManager& themeManager = ThemeManager::getInstance();
+        ThemeSnapshotPtr snapshot = themeManager.getCurrentSnapshot();
+        themed->themeName = themeManager.getCurrentTheme();
+        themed->tag = BuildThemeTag(themed->themeName, ResolveIconColouring(snapshot.get()));
+    }
+    return themed->tag;
+}
+
 wxBitmapBundle SvgIconManager::GetBitmapBundle(const wxString& name)
 {
     // Check bundle cache first
-    auto bundleIt = bundleCache.find(name);
-    if (bundleIt != bundleCache.end()) {
-        return bundleIt->second;
+    if (const wxBitmapBundle* cached = themed->bundleCache.Find(name)) {
+        return *cached;
     }
 
     auto it = iconMap.find(name);
@@ -88,23 +207,24 @@ wxBitmapBundle SvgIconManager::GetBitmapBundle(const wxString& name)
                 wxBitmapBundle bundle = wxBitmapBundle::FromSVG(themedSvgContent.ToUTF8().data(), wxSize(16, 16));
                 
             if (bundle.IsOk()) {
-                // Cache the bundle
-                bundleCache[name] = bundle;
+                // Cache the bundle; it holds the SVG source, so cost it by that length
+                themed->bundleCache.Put(name, bundle, TextCost(themedSvgContent));
                 return bundle;
             } else {
                     LOG_WRN(wxString::Format("SvgIconManager: Failed to create bundle from themed SVG for '%s', trying original file.", name.ToStdString()), "SvgIconManager");
-                    // Fallback to original file
-                    bundle = wxBitmapBundle::FromSVGFile(it->second, wxSize(16, 16));
+                    // Fallback to original markup (the file may live inside the icon archive)
+                    std::shared_ptr<const SvgColorTemplate> svg = GetSvgTemplate(name);
+                    bundle = svg ? wxBitmapBundle::FromSVG(svg->GetSource().c_str(), wxSize(16, 16)) : wxBitmapBundle();
                     if (bundle.IsOk()) {
-                        bundleCache[name] = bundle;
+                        themed->bundleCache.Put(name, bundle, svg->GetSource().size());
                         return bundle;
                     }
                 }
-            } else {
+            } else if (!iconArchive.IsOpen()) {
                 // Fallback to original SVG file if theming failed
                 wxBitmapBundle bundle = wxBitmapBundle::FromSVGFile(it->second, wxSize(16, 16));
                 if (bundle.IsOk()) {
-                    bundleCache[name] = bundle;
+                    themed->bundleCache.Put(name, bundle, static_cast<size_t>(wxFileName::GetSize(it->second).GetValue()));
                     return bundle;
                 }
             }
@@ -131,9 +251,22 @@ wxBitmap SvgIconManager::GetIconBitmap(const wxString& name, const wxSize& size,
     // Check cache first if enabled
     if (useCache) {
         wxString cacheKey = GetCacheKey(name, size);
-        auto cacheIt = iconCache.find(cacheKey);
-        if (cacheIt != iconCache.end()) {
-            return cacheIt->second;
+        if (const wxBitmap* cached = themed->iconCache.Find(cacheKey)) {
+            return *cached;
+        }
+    }
+
+    // A valid on-disk raster skips reading, recolouring and rasterizing the SVG
+    auto pathIt = iconMap.find(name);
+    if (useCache && pathIt != iconMap.end()) {
+        iconUsage.emplace(GetCacheKey(name, size), std::make_pair(name, size));
+    }
+    bool useDiskCache = useCache && diskCache && pathIt != iconMap.end();
+    if (useDiskCache) {
+        wxBitmap bitmap = diskCache->Load(name, size, GetThemeCacheTag(), pathIt->second);
+        if (bitmap.IsOk()) {
+            themed->iconCache.Put(GetCacheKey(name, size), bitmap);
+            return bitmap;
         }
     }
 
@@ -145,7 +278,11 @@ wxBitmap SvgIconManager::GetIconBitmap(const wxString& name, const wxSize& size,
             // Cache the rendered bitmap if enabled
             if (useCache) {
                 wxString cacheKey = GetCacheKey(name, size);
-                iconCache[cacheKey] = bitmap;
+                themed->iconCache.Put(cacheKey, bitmap);
+                GetThemeCacheTag(); // Resolve now so the set can be kept aside on a theme switch
+            }
+            if (useDiskCache) {
+                diskCache->Store(name, size, GetThemeCacheTag(), pathIt->second, bitmap);
             }
             return bitmap;
         } else {
@@ -157,6 +294,174 @@ wxBitmap SvgIconManager::GetIconBitmap(const wxString& name, const wxSize& size,
     return wxBitmap(); // Return empty bitmap
 }
 
+void SvgIconManager::RequestIconAsync(const wxString& name, const wxSize& size, IconReadyCallback callback)
+{
+    if (!callback) {
+        return;
+    }
+
+    wxString cacheKey = GetCacheKey(name, size);
+    if (const wxBitmap* cached = themed->iconCache.Find(cacheKey)) {
+        callback(*cached);
+        return;
+    }
+
+    auto pathIt = iconMap.find(name);
+    if (pathIt == iconMap.end()) {
+        LOG_WRN(wxString::Format("SvgIconManager: Icon '%s' not found.", name.ToStdString()), "SvgIconManager");
+        callback(wxBitmap());
+        return;
+    }
+    iconUsage.emplace(cacheKey, std::make_pair(name, size));
+
+    if (diskCache) {
+        wxBitmap bitmap = diskCache->Load(name, size, GetThemeCacheTag(), pathIt->second);
+        if (bitmap.IsOk()) {
+            themed->iconCache.Put(cacheKey, bitmap);
+            callback(bitmap);
+            return;
+        }
+    }
+
+    auto pendingIt = pendingRequests.find(cacheKey);
+    if (pendingIt != pendingRequests.end()) {
+        pendingIt->second.push_back(std::move(callback));
+        return;
+    }
+
+    // Recolouring is cheap and reads theme state, so it stays on the UI thread
+    wxString themedContent = GetThemedSvgContent(name);
+    if (themedContent.IsEmpty()) {
+        callback(wxBitmap());
+        return;
+    }
+
+    pendingRequests[cacheKey].push_back(std::move(callback));
+
+    SvgIconManager* self = this;
+    unsigned int generation = themeGeneration;
+    GetRasterPool().Submit(std::string(themedContent.utf8_str()), size, [self, name, size, generation](const wxImage& image) {
+        // The manager may have been replaced by SetDefaultIconDirectory meanwhile
+        if (instance.get() != self) {
+            return;
+        }
+        self->OnAsyncRasterDone(name, size, generation, image);
+    });
+}
+
+void SvgIconManager::OnAsyncRasterDone(const wxString& name, const wxSize& size, unsigned int generation, const wxImage& image)
+{
+    wxString cacheKey = GetCacheKey(name, size);
+    auto pendingIt = pendingRequests.find(cacheKey);
+    if (pendingIt == pendingRequests.end()) {
+        return;
+    }
+    std::vector<IconReadyCallback> callbacks = std::move(pendingIt->second);
+    pendingRequests.erase(pendingIt);
+
+    if (generation != themeGeneration) {
+        // Theme changed while rasterizing; redo with the current colours
+        for (auto& callback : callbacks) {
+            RequestIconAsync(name, size, std::move(callback));
+        }
+        return;
+    }
+
+    wxBitmap bitmap;
+    if (image.IsOk()) {
+        bitmap = wxBitmap(image);
+        themed->iconCache.Put(cacheKey, bitmap);
+        auto pathIt = iconMap.find(name);
+        if (diskCache && pathIt != iconMap.end()) {
+            diskCache->Store(name, size, GetThemeCacheTag(), pathIt->second, bitmap);
+        }
+    } else {
+        LOG_WRN(wxString::Format("SvgIconManager: Background rasterization failed for '%s', using synchronous path.", name.ToStdString()), "SvgIconManager");
+        bitmap = GetIconBitmap(name, size);
+    }
+
+    for (auto& callback : callbacks) {
+        callback(bitmap);
+    }
+}
+
+SvgRasterWorkerPool& SvgIconManager::GetRasterPool()
+{
+    if (!rasterPool) {
+        rasterPool = std::make_unique<SvgRasterWorkerPool>();
+    }
+    return *rasterPool;
+}
+
+IconAtlasHandle SvgIconManager::PackIntoSizeAtlas(ThemedIconSet& set, const wxImage& image)
+{
+    wxString atlasKey = wxString::Format("_%dx%d", image.GetWidth(), image.GetHeight());
+    std::shared_ptr<IconAtlas>& atlas = set.iconAtlases[atlasKey];
+    if (!atlas) {
+        atlas = IconAtlas::Create();
+    }
+    IconAtlasHandle handle = atlas->Add(image);
+    if (!handle.IsOk()) {
+        // Page full: existing handles keep the old page alive, new icons go to a fresh one
+        atlas = IconAtlas::Create();
+        handle = atlas->Add(image);
+    }
+    return handle;
+}
+
+IconAtlasHandle SvgIconManager::GetAtlasIcon(const wxString& name, const wxSize& size)
+{
+    wxString cacheKey = GetCacheKey(name, size);
+    auto it = themed->atlasEntries.find(cacheKey);
+    if (it != themed->atlasEntries.end()) {
+        return it->second;
+    }
+
+    wxBitmap bitmap = GetIconBitmap(name, size);
+    if (!bitmap.IsOk()) {
+        return IconAtlasHandle();
+    }
+    IconAtlasHandle handle = PackIntoSizeAtlas(*themed, bitmap.ConvertToImage());
+    if (handle.IsOk()) {
+        themed->atlasEntries[cacheKey] = handle;
+    }
+    return handle;
+}
+
+IconAtlasHandle SvgIconManager::GetAtlasPlaceholder(const wxSize& size)
+{
+    wxString cacheKey = GetCacheKey(wxEmptyString, size);
+    auto it = themed->atlasEntries.find(cacheKey);
+    if (it != themed->atlasEntries.end()) {
+        return it->second;
+    }
+
+    wxImage image(size.GetWidth(), size.GetHeight(), true);
+    image.InitAlpha();
+    memset(image.GetAlpha(), 0, static_cast<size_t>(size.GetWidth()) * size.GetHeight());
+    IconAtlasHandle handle = PackIntoSizeAtlas(*themed, image);
+    if (handle.IsOk()) {
+        themed->atlasEntries[cacheKey] = handle;
+    }
+    return handle;
+}
+
+IconAtlasHandle SvgIconManager::PackBitmap(const wxBitmap& bitmap)
+{
+    if (!bitmap.IsOk()) {
+        return IconAtlasHandle();
+    }
+    if (!bitmapAtlas) {
+        bitmapAtlas = IconAtlas::Create();
+    }
+    IconAtlasHandle handle = bitmapAtlas->Add(bitmap);
+    if (!handle.IsOk()) {
+        bitmapAtlas = IconAtlas::Create();
+        handle = bitmapAtlas->Add(bitmap);
+    }
+    return handle;
+}
+
 wxBitmap SvgIconManager::GetIconBitmapWithFallback(const wxString& name, const wxSize& size, const wxString& fallbackName)
 {
     wxBitmap bitmap = GetIconBitmap(name, size);
@@ -187,52 +492,236 @@ wxArrayString SvgIconManager::GetAvailableIcons() const
     return names;
 }
 
+SvgIconManager::CacheStats SvgIconManager::GetCacheStats() const
+{
+    CacheStats stats;
+    stats.bitmaps = themed->iconCache.GetStats();
+    stats.bundles = themed->bundleCache.GetStats();
+    stats.themedSvg = themed->themedSvgCache.GetStats();
+    return stats;
+}
+
+void SvgIconManager::LogCacheStats() const
+{
+    auto logOne = [](const char* label, const auto& stats) {
+        LOG_INF(wxString::Format("SvgIconManager: %s cache - %zu entries, %zu/%zu KB, %llu hits, %llu misses, %llu evictions",
+            label, stats.entries, stats.bytes / 1024, stats.budget / 1024,
+            (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.evictions), "SvgIconManager");
+    };
+    CacheStats stats = GetCacheStats();
+    logOne("Bitmap", stats.bitmaps);
+    logOne("Bundle", stats.bundles);
+    logOne("Themed SVG", stats.themedSvg);
+
+    size_t templateBytes = 0;
+    for (const auto& entry : svgTemplates) {
+        templateBytes += entry.second->GetMemoryCost();
+    }
+    LOG_INF(wxString::Format("SvgIconManager: %u parsed SVG templates, %zu KB",
+        (unsigned int)svgTemplates.size(), templateBytes / 1024), "SvgIconManager");
+}
+
 void SvgIconManager::ClearCache()
 {
-    iconCache.clear();
-    bundleCache.clear();
-    themedSvgCache.clear();
+    themed = std::make_shared<ThemedIconSet>();
+    warmThemes.clear();
+    svgTemplates.clear();
+    ++themeGeneration;
     LOG_DBG("SvgIconManager: All caches cleared", "SvgIconManager");
 }
 
 void SvgIconManager::ClearThemeCache()
 {
-    themedSvgCache.clear();
-    // Also clear the rendered caches since they depend on themed SVG
-    iconCache.clear();
-    bundleCache.clear();
+    // Rendered caches depend on themed SVG, so the whole set goes
+    themed = std::make_shared<ThemedIconSet>();
+    ++themeGeneration;
     LOG_DBG("SvgIconManager: Theme cache cleared", "SvgIconManager");
 }
 
-wxString SvgIconManager::ReadSvgFile(const wxString& filePath)
+bool SvgIconManager::PrewarmTheme(const std::string& themeName)
+{
+    ThemeManager& themeManager = ThemeManager::getInstance();
+    ThemeSnapshotPtr snapshot = themeManager.getSnapshot(themeName);
+    if (!snapshot || themeName == themeManager.getCurrentTheme()) {
+        return false;
+    }
+
+    IconColouring colouring = ResolveIconColouring(snapshot.get());
+    wxString tag = BuildThemeTag(themeName, colouring);
+    auto warmIt = warmThemes.find(themeName);
+    if (warmIt != warmThemes.end() && warmIt->second->tag == tag) {
+        return true; // Already warm or warming
+    }
+
+    auto set = std::make_shared<ThemedIconSet>();
+    set->themeName = themeName;
+    set->tag = tag;
+    set->warmStarted = std::chrono::steady_clock::now();
+    warmThemes[themeName] = set;
+
+    // Everything the worker needs is copied out here; theme state stays on the UI thread
+    std::string targetColour;
+    if (colouring.enabled) {
+        targetColour = wxString::Format("#%02x%02x%02x",
+            colouring.primary.Red(), colouring.primary.Green(), colouring.primary.Blue()).ToStdString();
+    }
+
+    SvgIconManager* self = this;
+    std::weak_ptr<ThemedIconSet> weakSet = set;
+    for (const auto& usage : iconUsage) {
+        const wxString& name = usage.second.first;
+        const wxSize& size = usage.second.second;
+        auto pathIt = iconMap.find(name);
+        if (pathIt == iconMap.end()) {
+            continue;
+        }
+
+        // Icons restored from the disk cache were never parsed; the worker compiles those itself
+        // unless they come from the mapped archive, where parsing here costs no file I/O
+        ++set->pendingWarmJobs;
+        auto templateIt = svgTemplates.find(name);
+        std::shared_ptr<const SvgColorTemplate> compiled = templateIt != svgTemplates.end() ? templateIt->second : nullptr;
+        if (!compiled && iconArchive.IsOpen()) {
+            compiled = GetSvgTemplate(name);
+        }
+        std::string path(pathIt->second.utf8_str());
+        wxString sourcePath = pathIt->second;
+        // rasterPool is declared after diskCache, so its workers are joined before the cache goes away
+        IconDiskCache* disk = diskCache.get();
+        GetRasterPool().SubmitTask([compiled, path, targetColour, size, disk, name, tag, sourcePath]() {
+            std::shared_ptr<const SvgColorTemplate> svg = compiled;
+            if (!svg) {
+                svg = std::make_shared<const SvgColorTemplate>(ReadFileBytes(path));
+            }
+            wxImage image = SvgRasterWorkerPool::Rasterize(targetColour.empty() ? svg->GetSource() : svg->Apply(targetColour), size);
+            // Written here so prewarming a theme never blocks the UI thread on file I/O
+            if (disk && image.IsOk()) {
+                disk->Store(name, size, tag, sourcePath, image);
+            }
+            return image;
+        }, [self, weakSet, name, size](const wxImage& image) {
+            // The set is dropped if the caches were cleared or the colours changed meanwhile
+            std::shared_ptr<ThemedIconSet> target = weakSet.lock();
+            if (instance.get() != self || !target) {
+                return;
+            }
+            self->OnPrewarmDone(target, name, size, image);
+        });
+    }
+
+    LOG_DBG(wxString::Format("SvgIconManager: Prewarming %u icons for theme '%s'",
+        (unsigned int)set->pendingWarmJobs, wxString::FromUTF8(themeName)), "SvgIconManager");
+    return true;
+}
+
+void SvgIconManager::OnPrewarmDone(const std::shared_ptr<ThemedIconSet>& set, const wxString& name, const wxSize& size, const wxImage& image)
+{
+    if (set->pendingWarmJobs > 0) {
+        --set->pendingWarmJobs;
+    }
+
+    // The set may already be active and have rendered this icon on demand
+    wxString cacheKey = GetCacheKey(name, size);
+    if (image.IsOk() && !set->iconCache.Contains(cacheKey)) {
+        wxBitmap bitmap(image);
+        set->iconCache.Put(cacheKey, bitmap);
+        IconAtlasHandle handle = PackIntoSizeAtlas(*set, image);
+        if (handle.IsOk()) {
+            set->atlasEntries[cacheKey] = handle;
+        }
+    }
+
+    if (set->pendingWarmJobs == 0) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - set->warmStarted);
+        LOG_INF(wxString::Format("SvgIconManager: Prewarmed %u icons for theme '%s' in %lld ms",
+            (unsigned int)set->iconCache.Size(), wxString::FromUTF8(set->themeName), (long long)elapsed.count()), "SvgIconManager");
+    }
+}
+
+bool SvgIconManager::ActivateTheme(const std::string& themeName)
+{
+    std::shared_ptr<ThemedIconSet> previous = themed;
+    std::shared_ptr<ThemedIconSet> candidate;
+    auto warmIt = warmThemes.find(themeName);
+    if (warmIt != warmThemes.end()) {
+        candidate = warmIt->second;
+        warmThemes.erase(warmIt);
+    }
+
+    themed = std::make_shared<ThemedIconSet>();
+    const wxString& tag = GetThemeCacheTag();
+    bool warm = candidate && candidate->tag == tag;
+    if (warm) {
+        themed = candidate;
+    }
+    ++themeGeneration;
+
+    // Keep the outgoing set so switching back is a swap as well; its tag guards against stale colours
+    if (!previous->tag.IsEmpty() && previous->themeName != themeName && !previous->iconCache.Empty()) {
+        warmThemes[previous->themeName] = previous;
+    }
+
+    if (warm) {
+        LOG_INF(wxString::Format("SvgIconManager: Switched to prewarmed icons for theme '%s' (%u ready, %u pending)",
+            wxString::FromUTF8(themeName), (unsigned int)themed->iconCache.Size(), (unsigned int)themed->pendingWarmJobs), "SvgIconManager");
+    } else {
+        LOG_DBG(wxString::Format("SvgIconManager: No prewarmed icons for theme '%s', rendering on demand",
+            wxString::FromUTF8(themeName)), "SvgIconManager");
+    }
+    return warm;
+}
+
+std::string SvgIconManager::ReadSvgFile(const wxString& filePath)
 {
     if (!wxFile::Exists(filePath)) {
         LOG_WRN(wxString::Format("SvgIconManager: SVG file '%s' does not exist.", filePath.ToStdString()), "SvgIconManager");
-        return wxEmptyString;
+        return std::string();
     }
 
-    wxFile file(filePath, wxFile::read);
-    if (!file.IsOpened()) {
-        LOG_ERR(wxString::Format("SvgIconManager: Could not open SVG file '%s'.", filePath.ToStdString()), "SvgIconManager");
-        return wxEmptyString;
+    std::string content = ReadFileBytes(std::string(filePath.utf8_str()));
+    if (content.empty()) {
+        LOG_ERR(wxString::Format("SvgIconManager: Failed to read SVG file '%s'.", filePath.ToStdString()), "SvgIconManager");
     }
+    return content;
+}
 
-    wxString content;
-    if (!file.ReadAll(&content)) {
-        LOG_ERR(wxString::Format("SvgIconManager: Failed to read SVG file '%s'.", filePath.ToStdString()), "SvgIconManager");
-        return wxEmptyString;
+std::shared_ptr<const SvgColorTemplate> SvgIconManager::GetSvgTemplate(const wxString& name)
+{
+    auto templateIt = svgTemplates.find(name);
+    if (templateIt != svgTemplates.end()) {
+        return templateIt->second;
     }
 
-    return content;
+    auto it = iconMap.find(name);
+    if (it == iconMap.end()) {
+        return nullptr;
+    }
+
+    std::string content;
+    wxScopedCharBuffer key = name.utf8_str();
+    std::string_view packed;
+    if (iconArchive.IsOpen() && iconArchive.Find(std::string_view(key.data(), key.length()), std::string_view(), packed)) {
+        content.assign(packed.data(), packed.size());
+    } else {
+        content = ReadSvgFile(it->second);
+    }
+    if (content.empty()) {
+        return nullptr;
+    }
+
+    auto compiled = std::make_shared<const SvgColorTemplate>(std::move(content));
+    svgTemplates[name] = compiled;
+    return compiled;
 }
 
-wxString SvgIconManager::ApplyThemeToSvg(const wxString& svgContent)
+wxString SvgIconManager::ApplyThemeToSvg(const SvgColorTemplate& svg)
 {
-    if (svgContent.IsEmpty()) {
+    if (svg.IsEmpty()) {
         return wxEmptyString;
     }
 
-    wxString themedContent = svgContent;
+    const std::string& source = svg.GetSource();
+    wxString themedContent = wxString::FromUTF8(source.data(), source.size());
     
     try {
         // Check if SVG theming is enabled
@@ -241,7 +730,7 @@ wxString SvgIconManager::ApplyThemeToSvg(const wxString& svgContent)
         
         if (!svgThemeEnabled) {
             // LOG_DBG("SvgIconManager: SVG theming is disabled", "SvgIconManager");
-            return svgContent; // Return original content if theming is disabled
+            return themedContent; // Return original content if theming is disabled
         }
 
         // Get theme colors
@@ -270,17 +759,17 @@ wxString SvgIconManager::ApplyThemeToSvg(const wxString& svgContent)
         //     primaryIconHex, secondaryIconHex, disabledIconHex, highlightIconHex), "SvgIconManager");
 
         // Direct theme color application - replace all colors with theme colors
-        themedContent = ApplyDirectThemeColors(themedContent, primaryIconHex, secondaryBgHex);
+        themedContent = ApplyDirectThemeColors(svg, primaryIconHex, secondaryBgHex);
         
         // LOG_DBG(wxString::Format("SvgIconManager: Applied direct theme colors to SVG content. Original length: %d, Themed length: %d", 
         //     (int)svgContent.length(), (int)themedContent.length()), "SvgIconManager");
         
     } catch (const std::exception& e) {
         LOG_ERR(wxString::Format("SvgIconManager: Exception while applying theme to SVG: %s", e.what()), "SvgIconManager");
-        return svgContent; // Return original content on error
+        return wxString::FromUTF8(source.data(), source.size()); // Return original content on error
     } catch (...) {
         LOG_ERR("SvgIconManager: Unknown exception while applying theme to SVG", "SvgIconManager");
-        return svgContent; // Return original content on error
+        return wxString::FromUTF8(source.data(), source.size()); // Return original content on error
     }
 
     return themedContent;
@@ -289,24 +778,33 @@ wxString SvgIconManager::ApplyThemeToSvg(const wxString& svgContent)
 wxString SvgIconManager::GetThemedSvgContent(const wxString& name)
 {
     // Check themed SVG cache first
-    auto cacheIt = themedSvgCache.find(name);
-    if (cacheIt != themedSvgCache.end()) {
-        return cacheIt->second;
+    if (const wxString* cached = themed->themedSvgCache.Find(name)) {
+        return *cached;
     }
 
     auto it = iconMap.find(name);
+    if (it != iconMap.end() && iconArchive.IsOpen() && CFG_INT("SvgThemeEnabled") != 0) {
+        // The packer may have pre-themed this icon for the current colour
+        wxColour primary = CFG_COLOUR("SvgPrimaryIconColour");
+        std::string variant = wxString::Format("#%02x%02x%02x", primary.Red(), primary.Green(), primary.Blue()).ToStdString();
+        wxScopedCharBuffer key = name.utf8_str();
+        std::string_view packed;
+        if (iconArchive.Find(std::string_view(key.data(), key.length()), variant, packed)) {
+            wxString themedContent = wxString::FromUTF8(packed.data(), packed.size());
+            themed->themedSvgCache.Put(name, themedContent);
+            return themedContent;
+        }
+    }
+
     if (it != iconMap.end()) {
-        // Read original SVG content
-        wxString originalContent = ReadSvgFile(it->second);
-        if (!originalContent.IsEmpty()) {
-            // LOG_DBG(wxString::Format("SvgIconManager: Original SVG content for '%s' (first 100 chars): %s", 
-            //     name, originalContent.Left(100)), "SvgIconManager");
-            
+        // Parsed once per icon; re-theming only fills the colour slots
+        std::shared_ptr<const SvgColorTemplate> svg = GetSvgTemplate(name);
+        if (svg) {
             // Apply theme colors
-            wxString themedContent = ApplyThemeToSvg(originalContent);
+            wxString themedContent = ApplyThemeToSvg(*svg);
             
             // Cache the themed content
-            themedSvgCache[name] = themedContent;
+            themed->themedSvgCache.Put(name, themedContent);
             
             // LOG_DBG(wxString::Format("SvgIconManager: Generated themed SVG for icon '%s'", name.ToStdString()), "SvgIconManager");
             return themedContent;
@@ -348,311 +846,22 @@ void SvgIconManager::PreloadCommonIcons(const wxSize& size)
         GetIconBitmap(iconName, size, true); // This will cache the bitmap
     }
     
-    LOG_INF(wxString::Format("SvgIconManager: Preloaded %u common icons", (unsigned int)commonIcons.size()), "SvgIconManager");
-}
-
-// Enhanced color detection and mapping methods
-
-wxString SvgIconManager::ApplyDirectThemeColors(const wxString& svgContent, const wxString& primaryIconColor, const wxString& backgroundIconColor)
-{
-    wxString themedContent = svgContent;
-    
-    // LOG_DBG("SvgIconManager: Starting selective theme color application (non-light colors only)", "SvgIconManager");
-    
-    // Replace colors selectively - only non-light colors
-    themedContent = ReplaceNonLightColors(themedContent, "fill", primaryIconColor);
-    themedContent = ReplaceNonLightColors(themedContent, "stroke", primaryIconColor);
-    
-    // Handle colors in style attributes
-    themedContent = ReplaceNonLightColorsInStyles(themedContent, primaryIconColor);
-    
-    // Add default fill color to elements without any color attributes
-    themedContent = AddDefaultFillToElements(themedContent, primaryIconColor);
-    
-    // LOG_DBG(wxString::Format("SvgIconManager: Selective theme color application completed. Replaced non-light colors with %s", primaryIconColor), "SvgIconManager");
-    
-    return themedContent;
-}
-
-wxString SvgIconManager::NormalizeSvgStructure(const wxString& svgContent)
-{
-    wxString normalizedContent = svgContent;
-    
-    // Check if SVG has direct path elements under svg root (without g wrapper)
-    std::regex directPathRegex("<svg[^>]*>\\s*<path", std::regex_constants::icase);
-    std::string content = svgContent.ToStdString();
-    
-    if (std::regex_search(content, directPathRegex)) {
-        // This SVG has direct path elements, need to wrap them in a group
-        
-        // Find the opening svg tag
-        std::regex svgOpenRegex("<svg([^>]*)>", std::regex_constants::icase);
-        std::smatch svgMatch;
-        
-        if (std::regex_search(content, svgMatch, svgOpenRegex)) {
-            size_t svgEndPos = svgMatch.position() + svgMatch.length();
-            
-            // Find the closing svg tag
-            std::regex svgCloseRegex("</svg>", std::regex_constants::icase);
-            std::smatch closeMatch;
-            std::string remaining = content.substr(svgEndPos);
-            
-            if (std::regex_search(remaining, closeMatch, svgCloseRegex)) {
-                size_t closeStartPos = svgEndPos + closeMatch.position();
-                
-                // Extract the content between svg tags
-                std::string svgInnerContent = content.substr(svgEndPos, closeMatch.position());
-                
-                // Check if there are path elements not already wrapped in g
-                std::regex unwrappedPathRegex("(?!.*<g[^>]*>.*)<path[^>]*>", std::regex_constants::icase);
-                
-                if (std::regex_search(svgInnerContent, unwrappedPathRegex)) {
-                    // Wrap all content in a group element
-                    std::string newContent = content.substr(0, svgEndPos) +
-                                           "<g>" + svgInnerContent + "</g>" +
-                                           content.substr(closeStartPos);
-                    
-                    normalizedContent = wxString(newContent);
-                    LOG_DBG("SvgIconManager: Added group wrapper to SVG with direct path elements", "SvgIconManager");
-                }
-            }
-        }
-    }
-    
-    return normalizedContent;
-}
-
-wxString SvgIconManager::AddDefaultFillToElements(const wxString& svgContent, const wxString& defaultColor)
-{
-    // First normalize the SVG structure by adding g wrappers where needed
-    wxString themedContent = NormalizeSvgStructure(svgContent);
-    
-    // Now we can use a unified approach - just process group elements
-    // since all path elements should now be wrapped in groups
-    std::regex groupRegex("<g(\\s+[^>]*?)?>", std::regex_constants::icase);
-    std::string content = themedContent.ToStdString();
-    std::string result;
-    
-    std::sregex_iterator iter(content.begin(), content.end(), groupRegex);
-    std::sregex_iterator end;
-    
-    size_t lastPos = 0;
-    while (iter != end) {
-        std::smatch match = *iter;
-        std::string groupTag = match.str();
-        
-        // Check if this group already has fill or stroke attribute
-        if (groupTag.find("fill=") == std::string::npos && groupTag.find("stroke=") == std::string::npos) {
-            // Add fill attribute with default color
-            size_t insertPos = groupTag.find_last_of('>');
-            if (insertPos != std::string::npos) {
-                groupTag.insert(insertPos, " fill=\"" + defaultColor.ToStdString() + "\"");
-            }
-        }
-        
-        result += content.substr(lastPos, match.position() - lastPos);
-        result += groupTag;
-        lastPos = match.position() + match.length();
-        ++iter;
-    }
-    result += content.substr(lastPos);
-    
-    LOG_DBG("SvgIconManager: Added default fill color to group elements", "SvgIconManager");
-    return wxString(result);
-}
-
-wxString SvgIconManager::ReplaceNonLightColors(const wxString& content, const wxString& attribute, const wxString& targetColor)
-{
-    wxString result = content;
-    
-    // Create regex pattern to match the attribute with any color value
-    std::string pattern = attribute.ToStdString() + "=\"([^\"]+)\"";
-    std::regex attrRegex(pattern, std::regex_constants::icase);
-    
-    std::string contentStr = content.ToStdString();
-    std::string resultStr;
-    
-    std::sregex_iterator iter(contentStr.begin(), contentStr.end(), attrRegex);
-    std::sregex_iterator end;
-    
-    size_t lastPos = 0;
-    while (iter != end) {
-        std::smatch match = *iter;
-        wxString colorValue = wxString(match[1].str());
-        
-        // Check if this color should be replaced (non-light colors)
-        if (ShouldReplaceColor(colorValue)) {
-            // Replace this color
-            std::string replacement = attribute.ToStdString() + "=\"" + targetColor.ToStdString() + "\"";
-            
-            resultStr += contentStr.substr(lastPos, match.position() - lastPos);
-            resultStr += replacement;
-            
-            // LOG_DBG(wxString::Format("SvgIconManager: Replaced %s color '%s' with '%s'", 
-            //        attribute, colorValue, targetColor), "SvgIconManager");
-        } else {
-            // Keep original light color
-            resultStr += contentStr.substr(lastPos, match.position() - lastPos);
-            resultStr += match.str();
-            
-            // LOG_DBG(wxString::Format("SvgIconManager: Preserved light %s color '%s'", 
-            //        attribute, colorValue), "SvgIconManager");
-        }
-        
-        lastPos = match.position() + match.length();
-        ++iter;
+    if (diskCache) {
+        IconDiskCache::Stats stats = diskCache->GetStats();
+        LOG_INF(wxString::Format("SvgIconManager: Preloaded %u common icons (disk cache: %llu hits, %llu misses, %llu stale)",
+            (unsigned int)commonIcons.size(), (unsigned long long)stats.hits, (unsigned long long)stats.misses,
+            (unsigned long long)stats.stale), "SvgIconManager");
+    } else {
+        LOG_INF(wxString::Format("SvgIconManager: Preloaded %u common icons", (unsigned int)commonIcons.size()), "SvgIconManager");
     }
-    resultStr += contentStr.substr(lastPos);
-    
-    return wxString(resultStr);
 }
 
-wxString SvgIconManager::ReplaceNonLightColorsInStyles(const wxString& content, const wxString& targetColor)
-{
-    wxString result = content;
-    
-    // Process style attributes like style="fill:#000000;stroke:red"
-    std::regex styleRegex("style=\"([^\"]*)\"", std::regex_constants::icase);
-    std::string contentStr = content.ToStdString();
-    std::string resultStr;
-    
-    std::sregex_iterator iter(contentStr.begin(), contentStr.end(), styleRegex);
-    std::sregex_iterator end;
-    
-    size_t lastPos = 0;
-    while (iter != end) {
-        std::smatch match = *iter;
-        std::string styleValue = match[1].str();
-        
-        // Process fill properties within style
-        std::regex fillRegex("fill\\s*:\\s*([^;]+)", std::regex_constants::icase);
-        std::smatch fillMatch;
-        
-        if (std::regex_search(styleValue, fillMatch, fillRegex)) {
-            wxString fillColor = wxString(fillMatch[1].str());
-            if (ShouldReplaceColor(fillColor)) {
-                styleValue = std::regex_replace(styleValue, fillRegex, 
-                                              "fill:" + targetColor.ToStdString());
-                // LOG_DBG(wxString::Format("SvgIconManager: Replaced style fill color '%s' with '%s'", 
-                //        fillColor, targetColor), "SvgIconManager");
-            }
-        }
-        
-        // Process stroke properties within style
-        std::regex strokeRegex("stroke\\s*:\\s*([^;]+)", std::regex_constants::icase);
-        std::smatch strokeMatch;
-        
-        if (std::regex_search(styleValue, strokeMatch, strokeRegex)) {
-            wxString strokeColor = wxString(strokeMatch[1].str());
-            if (ShouldReplaceColor(strokeColor)) {
-                styleValue = std::regex_replace(styleValue, strokeRegex, 
-                                              "stroke:" + targetColor.ToStdString());
-                // LOG_DBG(wxString::Format("SvgIconManager: Replaced style stroke color '%s' with '%s'", 
-                //        strokeColor, targetColor), "SvgIconManager");
-            }
-        }
-        
-        std::string replacement = "style=\"" + styleValue + "\"";
-        
-        resultStr += contentStr.substr(lastPos, match.position() - lastPos);
-        resultStr += replacement;
-        lastPos = match.position() + match.length();
-        ++iter;
-    }
-    resultStr += contentStr.substr(lastPos);
-    
-    return wxString(resultStr);
-}
+// Enhanced color detection and mapping methods
 
-bool SvgIconManager::ShouldReplaceColor(const wxString& colorValue)
+wxString SvgIconManager::ApplyDirectThemeColors(const SvgColorTemplate& svg, const wxString& primaryIconColor, const wxString& backgroundIconColor)
 {
-    // Determine if a color should be replaced based on brightness
-    // Returns true for dark/medium colors, false for light colors
-    
-    int brightness = CalculateColorBrightness(colorValue);
-    
-    if (brightness < 0) {
-        // Invalid color, check common keywords
-        wxString lowerColor = colorValue.Lower();
-        
-        // Don't replace light colors and transparent
-        if (lowerColor == "white" || lowerColor == "#fff" || lowerColor == "#ffffff" ||
-            lowerColor == "transparent" || lowerColor == "none" ||
-            lowerColor.Contains("lightgray") || lowerColor.Contains("lightgrey") ||
-            lowerColor.Contains("silver")) {
-            return false;
-        }
-        
-        // Replace dark/medium colors
-        if (lowerColor == "black" || lowerColor == "#000" || lowerColor == "#000000" ||
-            lowerColor == "gray" || lowerColor == "grey" || lowerColor == "currentcolor" ||
-            lowerColor.Contains("dark")) {
-            return true;
-        }
-        
-        // For unknown colors, replace them (conservative approach)
-        return true;
-    }
-    
-    // Light colors (brightness > 180) - don't replace
-    if (brightness > 180) {
-        return false;
-    }
-    
-    // Dark and medium colors - replace
-    return true;
+    // Non-light fill/stroke colours and default group fills were located when the
+    // template was compiled; only the colour slots are filled here
+    std::string themedContent = svg.Apply(primaryIconColor.ToStdString());
+    return wxString::FromUTF8(themedContent.data(), themedContent.size());
 }
-
-int SvgIconManager::CalculateColorBrightness(const wxString& colorValue)
-{
-    std::string color = colorValue.Lower().ToStdString();
-    
-    // Remove whitespace
-    color.erase(std::remove_if(color.begin(), color.end(), ::isspace), color.end());
-    
-    // Handle hex colors
-    if (!color.empty() && color[0] == '#') {
-        std::string hex = color.substr(1);
-        if (hex.length() == 3) {
-            // Short hex format (#RGB -> #RRGGBB)
-            hex = std::string(1, hex[0]) + hex[0] + hex[1] + hex[1] + hex[2] + hex[2];
-        }
-        
-        if (hex.length() == 6) {
-            try {
-                int r = std::stoi(hex.substr(0, 2), nullptr, 16);
-                int g = std::stoi(hex.substr(2, 2), nullptr, 16);
-                int b = std::stoi(hex.substr(4, 2), nullptr, 16);
-                
-                // Calculate perceived brightness using standard formula
-                return static_cast<int>(0.299 * r + 0.587 * g + 0.114 * b);
-            } catch (...) {
-                return -1;
-            }
-        }
-    }
-    
-    // Handle RGB/RGBA format
-    std::regex rgbRegex("rgba?\\((\\d+),(\\d+),(\\d+)(?:,[\\d.]+)?\\)");
-    std::smatch match;
-    if (std::regex_match(color, match, rgbRegex)) {
-        try {
-            int r = std::stoi(match[1].str());
-            int g = std::stoi(match[2].str());
-            int b = std::stoi(match[3].str());
-            
-            return static_cast<int>(0.299 * r + 0.587 * g + 0.114 * b);
-        } catch (...) {
-            return -1;
-        }
-    }
-    
-    // For named colors, return predefined brightness values
-    if (color == "white") return 255;
-    if (color == "black") return 0;
-    if (color == "gray" || color == "grey") return 128;
-    if (color == "lightgray" || color == "lightgrey" || color == "silver") return 192;
-    if (color == "darkgray" || color == "darkgrey") return 64;
-    
-    return -1; // Unknown format
-}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "config/SvgRasterWorkerPool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <nanosvg.h>
+#include <nanosvgrast.h>
+
+SvgRasterWorkerPool::SvgRasterWorkerPool(size_t threadCount)
+{
+    if (threadCount == 0) {
+        // Leave a core for the UI thread; icon work is short and bursty
+        unsigned int cores = std::thread::hardware_concurrency();
+        threadCount = std::clamp<size_t>(cores > 1 ? cores - 1 : 1, 1, 4);
+    }
+
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back(&SvgRasterWorkerPool::WorkerLoop, this);
+    }
+}
+
+SvgRasterWorkerPool::~SvgRasterWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_jobs.clear();
+    }
+    m_cv.notify_all();
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void SvgRasterWorkerPool::Submit(std::string svgUtf8, const wxSize& size, CompletionCallback callback)
+{
+    SubmitTask([svg = std::move(svgUtf8), size]() { return Rasterize(svg, size); }, std::move(callback));
+}
+
+void SvgRasterWorkerPool::SubmitTask(RasterTask task, CompletionCallback callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return;
+        }
+        m_jobs.push_back({ std::move(task), std::move(callback) });
+    }
+    m_cv.notify_one();
+}
+
+void SvgRasterWorkerPool::WorkerLoop()
+{
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        // wxImage reference counting is not atomic; hand over a single owner via shared_ptr
+        auto image = std::make_shared<wxImage>(job.task());
+        if (wxTheApp) {
+            wxTheApp->CallAfter([callback = std::move(job.callback), image = std::move(image)]() {
+                callback(*image);
+            });
+        }
+    }
+}
+
+wxImage SvgRasterWorkerPool::Rasterize(const std::string& svgUtf8, const wxSize& size)
+{
+    if (svgUtf8.empty() || size.GetWidth() <= 0 || size.GetHeight() <= 0) {
+        return wxImage();
+    }
+
+    // nsvgParse tokenizes in place, so it needs a writable, NUL-terminated copy
+    std::vector<char> markup(svgUtf8.begin(), svgUtf8.end());
+    markup.push_back('\0');
+    NSVGimage* svg = nsvgParse(markup.data(), "px", 96.0f);
+    if (!svg) {
+        return wxImage();
+    }
+    if (svg->width <= 0 || svg->height <= 0) {
+        nsvgDelete(svg);
+        return wxImage();
+    }
+
+    NSVGrasterizer* rasterizer = nsvgCreateRasterizer();
+    if (!rasterizer) {
+        nsvgDelete(svg);
+        return wxImage();
+    }
+
+    const int width = size.GetWidth();
+    const int height = size.GetHeight();
+    const float scale = std::min(width / svg->width, height / svg->height);
+    const float offsetX = (width - svg->width * scale) / 2.0f;
+    const float offsetY = (height - svg->height * scale) / 2.0f;
+
+    std::vector<unsigned char> rgba(static_cast<size_t>(width) * height * 4);
+    nsvgRasterize(rasterizer, svg, offsetX, offsetY, scale, rgba.data(), width, height, width * 4);
+    nsvgDeleteRasterizer(rasterizer);
+    nsvgDelete(svg);
+
+    // wxImage takes ownership of malloc'd RGB and alpha planes
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    unsigned char* rgb = static_cast<unsigned char*>(malloc(pixelCount * 3));
+    unsigned char* alpha = static_cast<unsigned char*>(malloc(pixelCount));
+    if (!rgb || !alpha) {
+        free(rgb);
+        free(alpha);
+        return wxImage();
+    }
+    for (size_t i = 0; i < pixelCount; ++i) {
+        rgb[i * 3] = rgba[i * 4];
+        rgb[i * 3 + 1] = rgba[i * 4 + 1];
+        rgb[i * 3 + 2] = rgba[i * 4 + 2];
+        alpha[i] = rgba[i * 4 + 3];
+    }
+
+    wxImage image(width, height, rgb, false);
+    image.SetAlpha(alpha, false);
+    return image;
+}
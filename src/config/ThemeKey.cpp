@@ -0,0 +1,45 @@
+#include "config/ThemeKey.h"
+
+ThemeKey::ThemeKey(const char* name)
+    : m_id(ThemeKeyRegistry::getInstance().intern(name ? std::string(name) : std::string())) {
+}
+
+ThemeKey::ThemeKey(const std::string& name)
+    : m_id(ThemeKeyRegistry::getInstance().intern(name)) {
+}
+
+const std::string& ThemeKey::name() const {
+    return ThemeKeyRegistry::getInstance().name(m_id);
+}
+
+ThemeKeyRegistry& ThemeKeyRegistry::getInstance() {
+    static ThemeKeyRegistry instance;
+    return instance;
+}
+
+uint32_t ThemeKeyRegistry::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_ids.find(name);
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(m_names.size());
+    m_names.push_back(name);
+    m_ids.emplace(name, id);
+    return id;
+}
+
+const std::string& ThemeKeyRegistry::name(uint32_t id) const {
+    static const std::string empty;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (id >= m_names.size()) {
+        return empty;
+    }
+    return m_names[id];
+}
+
+size_t ThemeKeyRegistry::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_names.size();
+}
@@ -1,9 +1,51 @@
 #include "config/ThemeManager.h"
 #include "config/SvgIconManager.h"
+#include "config/ThemeValueParser.h"
 #include "logger/Logger.h"
+#include <wx/app.h>
 #include <wx/settings.h>
-#include <sstream>
 #include <set>
+#include <chrono>
+#include <algorithm>
+
+namespace {
+    // Integer sizes shared by all themes
+    const std::vector<std::string> kSizeSections = {
+        "BarSizes", "ButtonBarSizes", "Separators", "Icons",
+        "GallerySizes", "PanelSizes", "HomeSpace", "HomeMenu"
+    };
+
+    // Every section the theme profiles are built from
+    std::vector<std::string> themeSections() {
+        std::vector<std::string> sections = { "ThemeColors", "SvgTheme", "Font" };
+        sections.insert(sections.end(), kSizeSections.begin(), kSizeSections.end());
+        return sections;
+    }
+
+    // Keys looked up on this thread while a ThemeSubscription::Recorder is alive
+    thread_local std::vector<uint32_t>* t_recordedKeys = nullptr;
+
+    inline void recordKey(uint32_t keyId) {
+        if (t_recordedKeys) {
+            t_recordedKeys->push_back(keyId);
+        }
+    }
+
+    template <typename Map>
+    void diffMaps(const Map& before, const Map& after, std::vector<uint32_t>& changed) {
+        for (const auto& pair : before) {
+            auto it = after.find(pair.first);
+            if (it == after.end() || it->second != pair.second) {
+                changed.push_back(ThemeKey(pair.first).id());
+            }
+        }
+        for (const auto& pair : after) {
+            if (before.find(pair.first) == before.end()) {
+                changed.push_back(ThemeKey(pair.first).id());
+            }
+        }
+    }
+}
 
 ThemeManager& ThemeManager::getInstance() {
     static ThemeManager instance;
@@ -11,7 +53,7 @@ ThemeManager& ThemeManager::getInstance() {
 }
 
 ThemeManager::ThemeManager() 
-    : m_configManager(nullptr), m_currentTheme("default"), m_initialized(false) {
+    : m_configManager(nullptr), m_currentTheme("default"), m_activeRaw(nullptr), m_nextGeneration(1), m_flushScheduled(false), m_initialized(false) {
 }
 
 ThemeManager::~ThemeManager() {
@@ -42,8 +84,14 @@ void ThemeManager::initialize(ConfigManager& config) {
 void ThemeManager::loadBuiltinThemes() {
     // Load theme configurations from new format
     if (m_configManager) {
-        // Load theme colors from ThemeColors section
-        auto colorKeys = m_configManager->getKeys("ThemeColors");
+        // Profiles compiled on a previous run are still valid while the INI is unchanged
+        std::map<std::string, ThemeProfile> precompiled;
+        if (m_configManager->getPrecompiledThemes(precompiled)) {
+            m_themes.swap(precompiled);
+            compileAllThemes();
+            LOG_INF("Loaded precompiled themes from config snapshot", "ThemeManager");
+            return;
+        }
         
         // Initialize three themes
         ThemeProfile defaultTheme, darkTheme, blueTheme;
@@ -54,105 +102,102 @@ void ThemeManager::loadBuiltinThemes() {
         darkTheme.displayName = "Dark";
         blueTheme.name = "blue";
         blueTheme.displayName = "Modern Blue";
+        ThemeProfile* profiles[3] = { &defaultTheme, &darkTheme, &blueTheme };
         
         // Parse theme colors in new format: default_value;dark_value;blue_value
-        for (const auto& key : colorKeys) {
-            std::string value = m_configManager->getString("ThemeColors", key, "");
-            if (!value.empty()) {
-                // Split by semicolon to get three theme values
-                std::vector<std::string> themeValues = splitString(value, ';');
-                
-                if (themeValues.size() >= 3) {
-                    // Parse each theme's color value
-                    wxColour defaultColor = parseColour(themeValues[0]);
-                    wxColour darkColor = parseColour(themeValues[1]);
-                    wxColour blueColor = parseColour(themeValues[2]);
-                    
-                    if (defaultColor.IsOk()) defaultTheme.colours[key] = defaultColor;
-                    if (darkColor.IsOk()) darkTheme.colours[key] = darkColor;
-                    if (blueColor.IsOk()) blueTheme.colours[key] = blueColor;
-                }
+        if (const auto* colours = m_configManager->getSection("ThemeColors")) {
+            for (const auto& entry : *colours) {
+                applyThemeColours(entry.first, entry.second, profiles);
             }
         }
         
         // Load SVG theme colors
-        auto svgKeys = m_configManager->getKeys("SvgTheme");
-        for (const auto& key : svgKeys) {
-            if (key == "SvgThemeEnabled") {
-                int enabled = m_configManager->getInt("SvgTheme", key, 1);
-                defaultTheme.integers[key] = enabled;
-                darkTheme.integers[key] = enabled;
-                blueTheme.integers[key] = enabled;
-            } else {
-                std::string value = m_configManager->getString("SvgTheme", key, "");
-                if (!value.empty()) {
-                    std::vector<std::string> themeValues = splitString(value, ';');
-                    if (themeValues.size() >= 3) {
-                        wxColour defaultColor = parseColour(themeValues[0]);
-                        wxColour darkColor = parseColour(themeValues[1]);
-                        wxColour blueColor = parseColour(themeValues[2]);
-                        
-                        if (defaultColor.IsOk()) defaultTheme.colours[key] = defaultColor;
-                        if (darkColor.IsOk()) darkTheme.colours[key] = darkColor;
-                        if (blueColor.IsOk()) blueTheme.colours[key] = blueColor;
+        if (const auto* svgColours = m_configManager->getSection("SvgTheme")) {
+            for (const auto& entry : *svgColours) {
+                if (entry.first == "SvgThemeEnabled") {
+                    int enabled = 1;
+                    ThemeValueParser::ParseInt(entry.second, enabled);
+                    for (ThemeProfile* profile : profiles) {
+                        profile->integers[entry.first] = enabled;
                     }
+                } else {
+                    applyThemeColours(entry.first, entry.second, profiles);
                 }
             }
         }
         
-        // Load size configurations (same for all themes)
-        loadSizeConfigurations(defaultTheme);
-        loadSizeConfigurations(darkTheme);
-        loadSizeConfigurations(blueTheme);
-        
-        // Set default fonts
-        defaultTheme.defaultFont = loadFont();
-        darkTheme.defaultFont = loadFont();
-        blueTheme.defaultFont = loadFont();
+        // Size configurations and the default font are the same for all themes
+        std::map<std::string, int> sizes = loadSizeConfigurations();
+        wxFont font = loadFont();
+        for (ThemeProfile* profile : profiles) {
+            for (const auto& size : sizes) {
+                profile->integers[size.first] = size.second;
+            }
+            profile->defaultFont = font;
+        }
         
         m_themes["default"] = defaultTheme;
         m_themes["dark"] = darkTheme;
         m_themes["blue"] = blueTheme;
         
+        compileAllThemes();
+        
+        m_configManager->setPrecompiledThemes(m_themes, themeSections());
+        
         LOG_INF("Loaded themes with new configuration format", "ThemeManager");
     } else {
         LOG_ERR("ConfigManager not available for loading themes", "ThemeManager");
     }
 }
 
-std::vector<std::string> ThemeManager::splitString(const std::string& str, char delimiter) {
-    std::vector<std::string> tokens;
-    std::string token;
-    std::istringstream tokenStream(str);
+void ThemeManager::compileAllThemes() {
+    std::map<std::string, ThemeSnapshotPtr> snapshots;
+    for (const auto& pair : m_themes) {
+        snapshots[pair.first] = ThemeSnapshot::Build(pair.second, m_nextGeneration++);
+    }
+    m_snapshots.swap(snapshots);
     
-    while (std::getline(tokenStream, token, delimiter)) {
-        // Trim whitespace
-        token.erase(0, token.find_first_not_of(" \t"));
-        token.erase(token.find_last_not_of(" \t") + 1);
-        tokens.push_back(token);
+    auto it = m_snapshots.find(m_currentTheme);
+    publishSnapshot(it != m_snapshots.end() ? it->second : ThemeSnapshotPtr());
+}
+
+void ThemeManager::publishSnapshot(const ThemeSnapshotPtr& snapshot) {
+    // Store the owning pointer first so the borrowed raw pointer never outlives it
+    std::atomic_store(&m_activeSnapshot, snapshot);
+    m_activeRaw.store(snapshot.get(), std::memory_order_release);
+}
+
+void ThemeManager::applyThemeColours(const std::string& key, std::string_view value, ThemeProfile* const profiles[3]) const {
+    // Split by semicolon to get three theme values
+    std::string_view themeValues[3];
+    if (ThemeValueParser::Split(value, ';', themeValues, 3) < 3) {
+        return;
     }
     
-    return tokens;
+    for (int i = 0; i < 3; ++i) {
+        wxColour colour = parseColour(themeValues[i]);
+        if (colour.IsOk()) {
+            profiles[i]->colours[key] = colour;
+        }
+    }
 }
 
-void ThemeManager::loadSizeConfigurations(ThemeProfile& theme) {
-    if (!m_configManager) return;
+std::map<std::string, int> ThemeManager::loadSizeConfigurations() const {
+    std::map<std::string, int> sizes;
+    if (!m_configManager) return sizes;
     
     // Load size configurations from various sections
-    std::vector<std::string> sizeSections = {
-        "BarSizes", "ButtonBarSizes", "Separators", "Icons", 
-        "GallerySizes", "PanelSizes", "HomeSpace", "HomeMenu"
-    };
-    
-    for (const auto& section : sizeSections) {
-        auto keys = m_configManager->getKeys(section);
-        for (const auto& key : keys) {
-            int value = m_configManager->getInt(section, key, 0);
-            if (value != 0) {
-                theme.integers[key] = value;
+    for (const auto& section : kSizeSections) {
+        const auto* values = m_configManager->getSection(section);
+        if (!values) continue;
+        for (const auto& entry : *values) {
+            int value = 0;
+            if (ThemeValueParser::ParseInt(entry.second, value) && value != 0) {
+                sizes[entry.first] = value;
             }
         }
     }
+    return sizes;
 }
 
 wxFont ThemeManager::loadFont() {
@@ -171,20 +216,12 @@ wxFont ThemeManager::loadFont() {
     return font;
 }
 
-wxColour ThemeManager::parseColour(const std::string& value) const {
-    if (value.empty()) return wxColour();
-    
-    std::istringstream ss(value);
-    int r, g, b;
-    char comma;
-    
-    if (ss >> r >> comma >> g >> comma >> b) {
-        if (r >= 0 && r <= 255 && g >= 0 && g <= 255 && b >= 0 && b <= 255) {
-            return wxColour(r, g, b);
-        }
+wxColour ThemeManager::parseColour(std::string_view value) const {
+    ThemeValueParser::Rgb rgb;
+    if (value.empty() || !ThemeValueParser::ParseRgb(value, rgb)) {
+        return wxColour();
     }
-    
-    return wxColour();
+    return wxColour(rgb.r, rgb.g, rgb.b);
 }
 
 bool ThemeManager::setCurrentTheme(const std::string& themeName) {
@@ -194,7 +231,10 @@ bool ThemeManager::setCurrentTheme(const std::string& themeName) {
         return false;
     }
     
+    auto switchStart = std::chrono::steady_clock::now();
     m_currentTheme = themeName;
+    auto snapshotIt = m_snapshots.find(themeName);
+    publishSnapshot(snapshotIt != m_snapshots.end() ? snapshotIt->second : ThemeSnapshotPtr());
     
     // Save current theme to config
     if (m_configManager) {
@@ -202,10 +242,16 @@ bool ThemeManager::setCurrentTheme(const std::string& themeName) {
         m_configManager->save();
     }
     
-    // Notify listeners
+    // Notify listeners; the refresh itself runs in the coalesced flush, which logs the total
+    m_switchingTheme = themeName;
+    m_switchStart = switchStart;
     notifyThemeChange();
+    if (!m_flushScheduled) {
+        m_switchingTheme.clear(); // Nothing to refresh, or the flush already ran
+    }
     
-    LOG_INF("Theme changed to: " + themeName, "ThemeManager");
+    auto switchMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - switchStart).count();
+    LOG_INF("Theme changed to: " + themeName + " (snapshot and icon swap took " + std::to_string(switchMicros / 1000.0) + " ms)", "ThemeManager");
     return true;
 }
 
@@ -221,72 +267,122 @@ std::string ThemeManager::getCurrentTheme() const {
     return m_currentTheme;
 }
 
-wxColour ThemeManager::getColour(const std::string& key) const {
+wxColour ThemeManager::getColour(const ThemeKey& key) const {
+    recordKey(key.id());
     if (!m_initialized) {
         LOG_ERR("Theme manager not initialized", "ThemeManager");
         return wxColour(255, 0, 0); // Error color
     }
     
-    auto themeIt = m_themes.find(m_currentTheme);
-    if (themeIt == m_themes.end()) {
+    const ThemeSnapshot* snapshot = m_activeRaw.load(std::memory_order_acquire);
+    if (!snapshot) {
         LOG_ERR("Current theme not found: " + m_currentTheme, "ThemeManager");
         return wxColour(255, 0, 0);
     }
     
-    auto colorIt = themeIt->second.colours.find(key);
-    if (colorIt == themeIt->second.colours.end()) {
-        LOG_WRN("Color key not found: " + key + " in theme: " + m_currentTheme, "ThemeManager");
+    const wxColour* colour = snapshot->FindColour(key);
+    if (!colour) {
+        LOG_WRN("Color key not found: " + key.name() + " in theme: " + m_currentTheme, "ThemeManager");
         return wxColour(255, 0, 0);
     }
     
-    return colorIt->second;
+    return *colour;
 }
 
-int ThemeManager::getInt(const std::string& key) const {
+int ThemeManager::getInt(const ThemeKey& key) const {
+    recordKey(key.id());
     if (!m_initialized) {
         LOG_ERR("Theme manager not initialized", "ThemeManager");
         return -1;
     }
     
-    auto themeIt = m_themes.find(m_currentTheme);
-    if (themeIt == m_themes.end()) {
+    const ThemeSnapshot* snapshot = m_activeRaw.load(std::memory_order_acquire);
+    if (!snapshot) {
         LOG_ERR("Current theme not found: " + m_currentTheme, "ThemeManager");
         return -1;
     }
     
-    auto intIt = themeIt->second.integers.find(key);
-    if (intIt == themeIt->second.integers.end()) {
+    const int* value = snapshot->FindInt(key);
+    if (!value) {
         // Only log warning once per key to avoid log spam
-        static std::set<std::string> loggedKeys;
-        if (loggedKeys.find(key) == loggedKeys.end()) {
-            LOG_WRN("Integer key not found: " + key + " in theme: " + m_currentTheme, "ThemeManager");
-            loggedKeys.insert(key);
+        static std::set<uint32_t> loggedKeys;
+        if (loggedKeys.insert(key.id()).second) {
+            LOG_WRN("Integer key not found: " + key.name() + " in theme: " + m_currentTheme, "ThemeManager");
         }
         return -1;
     }
     
-    return intIt->second;
+    return *value;
+}
+
+wxColour ThemeManager::getColour(const std::string& key) const {
+    return getColour(ThemeKey(key));
+}
+
+int ThemeManager::getInt(const std::string& key) const {
+    return getInt(ThemeKey(key));
+}
+
+const wxPen& ThemeManager::getPen(const ThemeKey& key) const {
+    static const wxPen errorPen(wxColour(255, 0, 0), 1);
+    recordKey(key.id());
+    const ThemeSnapshot* snapshot = m_activeRaw.load(std::memory_order_acquire);
+    const wxPen* pen = snapshot ? snapshot->FindPen(key) : nullptr;
+    if (!pen) {
+        LOG_WRN("Color key not found: " + key.name() + " in theme: " + m_currentTheme, "ThemeManager");
+        return errorPen;
+    }
+    return *pen;
+}
+
+const wxBrush& ThemeManager::getBrush(const ThemeKey& key) const {
+    static const wxBrush errorBrush(wxColour(255, 0, 0));
+    recordKey(key.id());
+    const ThemeSnapshot* snapshot = m_activeRaw.load(std::memory_order_acquire);
+    const wxBrush* brush = snapshot ? snapshot->FindBrush(key) : nullptr;
+    if (!brush) {
+        LOG_WRN("Color key not found: " + key.name() + " in theme: " + m_currentTheme, "ThemeManager");
+        return errorBrush;
+    }
+    return *brush;
+}
+
+ThemeSnapshotPtr ThemeManager::getCurrentSnapshot() const {
+    return std::atomic_load(&m_activeSnapshot);
+}
+
+ThemeSnapshotPtr ThemeManager::getSnapshot(const std::string& themeName) const {
+    auto it = m_snapshots.find(themeName);
+    return it != m_snapshots.end() ? it->second : ThemeSnapshotPtr();
+}
+
+uint64_t ThemeManager::getThemeGeneration() const {
+    const ThemeSnapshot* snapshot = m_activeRaw.load(std::memory_order_acquire);
+    return snapshot ? snapshot->GetGeneration() : 0;
 }
 
 std::string ThemeManager::getString(const std::string& key) const {
+    if (t_recordedKeys) {
+        recordKey(ThemeKey(key).id());
+    }
     if (!m_initialized) {
         LOG_ERR("Theme manager not initialized", "ThemeManager");
         return "";
     }
     
-    auto themeIt = m_themes.find(m_currentTheme);
-    if (themeIt == m_themes.end()) {
+    const ThemeSnapshot* snapshot = m_activeRaw.load(std::memory_order_acquire);
+    if (!snapshot) {
         LOG_ERR("Current theme not found: " + m_currentTheme, "ThemeManager");
         return "";
     }
     
-    auto strIt = themeIt->second.strings.find(key);
-    if (strIt == themeIt->second.strings.end()) {
+    const std::string* value = snapshot->FindString(key);
+    if (!value) {
         LOG_WRN("String key not found: " + key + " in theme: " + m_currentTheme, "ThemeManager");
         return "";
     }
     
-    return strIt->second;
+    return *value;
 }
 
 wxFont ThemeManager::getDefaultFont() const {
@@ -294,41 +390,194 @@ wxFont ThemeManager::getDefaultFont() const {
         return wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT);
     }
     
-    auto themeIt = m_themes.find(m_currentTheme);
-    if (themeIt == m_themes.end()) {
+    const ThemeSnapshot* snapshot = m_activeRaw.load(std::memory_order_acquire);
+    if (!snapshot) {
         return wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT);
     }
     
-    return themeIt->second.defaultFont;
+    return snapshot->GetDefaultFont();
 }
 
 void ThemeManager::addThemeChangeListener(void* listener, std::function<void()> callback) {
-    m_listeners[listener] = callback;
+    removeThemeChangeListener(listener);
+    Listener& entry = m_listeners[listener];
+    entry.everyChange = true;
+    entry.callback = std::move(callback);
+}
+
+void ThemeManager::addThemeChangeListener(void* listener, std::vector<ThemeKey> keys, std::function<void()> callback) {
+    removeThemeChangeListener(listener);
+    Listener& entry = m_listeners[listener];
+    entry.callback = std::move(callback);
+    
+    std::vector<uint32_t> keyIds;
+    for (const auto& key : keys) {
+        keyIds.push_back(key.id());
+    }
+    indexListenerKeys(listener, entry, keyIds);
+}
+
+void ThemeManager::addListenerKeys(void* listener, const std::vector<uint32_t>& keyIds) {
+    auto it = m_listeners.find(listener);
+    if (it != m_listeners.end() && !it->second.everyChange) {
+        indexListenerKeys(listener, it->second, keyIds);
+    }
+}
+
+void ThemeManager::indexListenerKeys(void* listener, Listener& entry, const std::vector<uint32_t>& keyIds) {
+    for (uint32_t keyId : keyIds) {
+        auto pos = std::lower_bound(entry.keyIds.begin(), entry.keyIds.end(), keyId);
+        if (keyId == ThemeKey::InvalidId || (pos != entry.keyIds.end() && *pos == keyId)) {
+            continue;
+        }
+        entry.keyIds.insert(pos, keyId);
+        m_keySubscribers[keyId].push_back(listener);
+    }
 }
 
 void ThemeManager::removeThemeChangeListener(void* listener) {
-    m_listeners.erase(listener);
+    auto it = m_listeners.find(listener);
+    if (it == m_listeners.end()) return;
+    
+    for (uint32_t keyId : it->second.keyIds) {
+        auto indexIt = m_keySubscribers.find(keyId);
+        if (indexIt == m_keySubscribers.end()) continue;
+        auto& subscribers = indexIt->second;
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), listener), subscribers.end());
+        if (subscribers.empty()) {
+            m_keySubscribers.erase(indexIt);
+        }
+    }
+    m_listeners.erase(it);
+    m_pendingListeners.erase(listener);
 }
 
 void ThemeManager::notifyThemeChange() {
-    // Clear SVG theme cache when theme changes
+    // Swap SVG icon caches to the new theme (prewarmed if PrewarmTheme ran for it)
     try {
-        SvgIconManager::GetInstance().ClearThemeCache();
-        LOG_INF("SVG theme cache cleared on theme change", "ThemeManager");
+        SvgIconManager::GetInstance().ActivateTheme(m_currentTheme);
     } catch (const std::exception& e) {
-        LOG_ERR(wxString::Format("Error clearing SVG theme cache: %s", e.what()).ToStdString(), "ThemeManager");
+        LOG_ERR(wxString::Format("Error switching SVG theme cache: %s", e.what()).ToStdString(), "ThemeManager");
     } catch (...) {
-        LOG_ERR("Unknown error clearing SVG theme cache", "ThemeManager");
+        LOG_ERR("Unknown error switching SVG theme cache", "ThemeManager");
     }
     
     // Notify other listeners
-    for (const auto& pair : m_listeners) {
+    notifyListeners(nullptr);
+}
+
+void ThemeManager::notifyListeners(const std::vector<uint32_t>* changedKeys) {
+    if (!changedKeys) {
+        for (const auto& pair : m_listeners) {
+            m_pendingListeners.insert(pair.first);
+        }
+    } else {
+        for (const auto& pair : m_listeners) {
+            if (pair.second.everyChange) {
+                m_pendingListeners.insert(pair.first);
+            }
+        }
+        for (uint32_t keyId : *changedKeys) {
+            auto it = m_keySubscribers.find(keyId);
+            if (it != m_keySubscribers.end()) {
+                m_pendingListeners.insert(it->second.begin(), it->second.end());
+            }
+        }
+    }
+    
+    if (m_pendingListeners.empty() || m_flushScheduled) return;
+    
+    // Coalesce bursts (several edits, a switch plus an edit) into a single refresh pass
+    if (wxTheApp) {
+        m_flushScheduled = true;
+        wxTheApp->CallAfter([this]() { flushListeners(); });
+    } else {
+        flushListeners();
+    }
+}
+
+void ThemeManager::flushListeners() {
+    m_flushScheduled = false;
+    
+    // Copy first, a listener may add or remove listeners
+    std::vector<std::function<void()>> callbacks;
+    for (void* listener : m_pendingListeners) {
+        auto it = m_listeners.find(listener);
+        if (it != m_listeners.end()) {
+            callbacks.push_back(it->second.callback);
+        }
+    }
+    m_pendingListeners.clear();
+    
+    for (const auto& callback : callbacks) {
         try {
-            pair.second();
+            callback();
         } catch (...) {
             LOG_ERR("Error in theme change listener", "ThemeManager");
         }
     }
+    
+    // Repaints are queued by now; this closes the timer started by setCurrentTheme
+    if (!m_switchingTheme.empty()) {
+        auto totalMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_switchStart).count();
+        LOG_INF("Theme switch to " + m_switchingTheme + " refreshed " + std::to_string(callbacks.size()) +
+            " listeners, total " + std::to_string(totalMicros / 1000.0) + " ms", "ThemeManager");
+        m_switchingTheme.clear();
+    }
+}
+
+std::vector<uint32_t> ThemeManager::diffProfiles(const ThemeProfile& before, const ThemeProfile& after) const {
+    std::vector<uint32_t> changed;
+    diffMaps(before.colours, after.colours, changed);
+    diffMaps(before.integers, after.integers, changed);
+    diffMaps(before.strings, after.strings, changed);
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    return changed;
+}
+
+void ThemeManager::applyConfigChanges(const std::vector<ConfigChange>& changes) {
+    if (!m_initialized || !m_configManager) return;
+    
+    const std::vector<std::string> sections = themeSections();
+    bool profilesChanged = false;
+    bool svgColoursChanged = false;
+    bool themeSelected = false;
+    for (const auto& change : changes) {
+        if (change.section == "Theme" && change.key == "CurrentTheme") {
+            themeSelected = true;
+        } else if (std::find(sections.begin(), sections.end(), change.section) != sections.end()) {
+            profilesChanged = true;
+            svgColoursChanged = svgColoursChanged || change.section == "SvgTheme";
+        }
+    }
+    if (!profilesChanged && !themeSelected) return;
+    
+    ThemeProfile before = m_themes[m_currentTheme];
+    if (profilesChanged) {
+        loadBuiltinThemes();
+    }
+    
+    // Selecting another theme in the file is a regular switch and refreshes everything
+    std::string selected = m_configManager->getString("Theme", "CurrentTheme", m_currentTheme);
+    if (themeSelected && selected != m_currentTheme && m_themes.count(selected)) {
+        setCurrentTheme(selected);
+        return;
+    }
+    if (!profilesChanged) return;
+    
+    const ThemeProfile& after = m_themes[m_currentTheme];
+    bool fontChanged = !(before.defaultFont == after.defaultFont);
+    std::vector<uint32_t> changedKeys = diffProfiles(before, after);
+    LOG_INF("Applied config edit: " + std::to_string(changedKeys.size()) + " theme key(s) changed" +
+        (fontChanged ? ", default font changed" : ""), "ThemeManager");
+    if (changedKeys.empty() && !fontChanged) return;
+    
+    if (svgColoursChanged) {
+        SvgIconManager::GetInstance().ActivateTheme(m_currentTheme);
+    }
+    // Every control uses the default font, so a font edit reaches all listeners
+    notifyListeners(fontChanged ? nullptr : &changedKeys);
 }
 
 bool ThemeManager::saveCurrentTheme() {
@@ -336,6 +585,26 @@ bool ThemeManager::saveCurrentTheme() {
     return m_configManager->save();
 }
 
+ThemeSubscription::ThemeSubscription(std::function<void()> callback, std::vector<ThemeKey> keys) {
+    ThemeManager::getInstance().addThemeChangeListener(this, std::move(keys), std::move(callback));
+}
+
+ThemeSubscription::~ThemeSubscription() {
+    ThemeManager::getInstance().removeThemeChangeListener(this);
+}
+
+ThemeSubscription::Recorder::Recorder(ThemeSubscription& subscription)
+    : m_subscription(subscription), m_outer(t_recordedKeys) {
+    t_recordedKeys = &m_keyIds;
+}
+
+ThemeSubscription::Recorder::~Recorder() {
+    t_recordedKeys = m_outer;
+    std::sort(m_keyIds.begin(), m_keyIds.end());
+    m_keyIds.erase(std::unique(m_keyIds.begin(), m_keyIds.end()), m_keyIds.end());
+    ThemeManager::getInstance().addListenerKeys(&m_subscription, m_keyIds);
+}
+
 bool ThemeManager::reloadThemes() {
     if (!m_configManager) return false;
     
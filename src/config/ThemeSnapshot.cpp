@@ -0,0 +1,84 @@
+#include "config/ThemeSnapshot.h"
+
+std::shared_ptr<const ThemeSnapshot> ThemeSnapshot::Build(const ThemeProfile& profile, uint64_t generation) {
+    std::shared_ptr<ThemeSnapshot> snapshot(new ThemeSnapshot());
+    snapshot->m_name = profile.name;
+    snapshot->m_displayName = profile.displayName;
+    snapshot->m_generation = generation;
+    snapshot->m_strings = profile.strings;
+    snapshot->m_defaultFont = profile.defaultFont;
+
+    // Intern every key first so the tables can be sized once
+    std::vector<std::pair<uint32_t, const wxColour*>> colourIds;
+    colourIds.reserve(profile.colours.size());
+    for (const auto& pair : profile.colours) {
+        colourIds.emplace_back(ThemeKey(pair.first).id(), &pair.second);
+    }
+    std::vector<std::pair<uint32_t, int>> intIds;
+    intIds.reserve(profile.integers.size());
+    for (const auto& pair : profile.integers) {
+        intIds.emplace_back(ThemeKey(pair.first).id(), pair.second);
+    }
+
+    size_t keyCount = ThemeKeyRegistry::getInstance().size();
+    snapshot->m_colours.resize(keyCount);
+    snapshot->m_pens.resize(keyCount);
+    snapshot->m_brushes.resize(keyCount);
+    snapshot->m_hasColour.resize(keyCount, 0);
+    snapshot->m_integers.resize(keyCount, 0);
+    snapshot->m_hasInteger.resize(keyCount, 0);
+
+    for (const auto& entry : colourIds) {
+        const wxColour& colour = *entry.second;
+        snapshot->m_colours[entry.first] = colour;
+        snapshot->m_pens[entry.first] = wxPen(colour, 1);
+        snapshot->m_brushes[entry.first] = wxBrush(colour);
+        snapshot->m_hasColour[entry.first] = 1;
+    }
+    for (const auto& entry : intIds) {
+        snapshot->m_integers[entry.first] = entry.second;
+        snapshot->m_hasInteger[entry.first] = 1;
+    }
+
+    return snapshot;
+}
+
+const wxColour* ThemeSnapshot::FindColour(const ThemeKey& key) const {
+    uint32_t id = key.id();
+    if (id >= m_hasColour.size() || !m_hasColour[id]) {
+        return nullptr;
+    }
+    return &m_colours[id];
+}
+
+const int* ThemeSnapshot::FindInt(const ThemeKey& key) const {
+    uint32_t id = key.id();
+    if (id >= m_hasInteger.size() || !m_hasInteger[id]) {
+        return nullptr;
+    }
+    return &m_integers[id];
+}
+
+const wxPen* ThemeSnapshot::FindPen(const ThemeKey& key) const {
+    uint32_t id = key.id();
+    if (id >= m_hasColour.size() || !m_hasColour[id]) {
+        return nullptr;
+    }
+    return &m_pens[id];
+}
+
+const wxBrush* ThemeSnapshot::FindBrush(const ThemeKey& key) const {
+    uint32_t id = key.id();
+    if (id >= m_hasColour.size() || !m_hasColour[id]) {
+        return nullptr;
+    }
+    return &m_brushes[id];
+}
+
+const std::string* ThemeSnapshot::FindString(const std::string& key) const {
+    auto it = m_strings.find(key);
+    if (it == m_strings.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
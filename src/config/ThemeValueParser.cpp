@@ -0,0 +1,93 @@
+#include "config/ThemeValueParser.h"
+#include <charconv>
+
+namespace {
+    bool IsStreamSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    const char* SkipSpace(const char* cursor, const char* end) {
+        while (cursor != end && IsStreamSpace(*cursor)) {
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    // Reads a leading integer like operator>>: optional whitespace and sign, then digits
+    const char* ReadInt(const char* cursor, const char* end, int& value) {
+        cursor = SkipSpace(cursor, end);
+        if (cursor != end && *cursor == '+') {
+            ++cursor;
+            if (cursor == end || *cursor == '-') {
+                return nullptr;
+            }
+        }
+        auto result = std::from_chars(cursor, end, value);
+        return result.ec == std::errc() ? result.ptr : nullptr;
+    }
+}
+
+namespace ThemeValueParser {
+
+std::string_view Trim(std::string_view text) {
+    size_t first = text.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return std::string_view();
+    }
+    size_t last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1);
+}
+
+size_t Split(std::string_view text, char delimiter, std::string_view* fields, size_t maxFields) {
+    size_t count = 0;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t stop = text.find(delimiter, start);
+        if (stop == std::string_view::npos) {
+            stop = text.size();
+        }
+        if (count < maxFields) {
+            fields[count] = Trim(text.substr(start, stop - start));
+        }
+        ++count;
+        start = stop + 1;
+    }
+    return count;
+}
+
+bool ParseInt(std::string_view text, int& value) {
+    const char* end = text.data() + text.size();
+    int parsed = 0;
+    const char* stop = ReadInt(text.data(), end, parsed);
+    if (!stop || SkipSpace(stop, end) != end) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+bool ParseRgb(std::string_view text, Rgb& rgb) {
+    const char* cursor = text.data();
+    const char* end = cursor + text.size();
+    int components[3];
+    for (int i = 0; i < 3; ++i) {
+        if (i > 0) {
+            // The separator is read like a char extraction: skip whitespace, take one character
+            cursor = SkipSpace(cursor, end);
+            if (cursor == end) {
+                return false;
+            }
+            ++cursor;
+        }
+        cursor = ReadInt(cursor, end, components[i]);
+        if (!cursor || components[i] < 0 || components[i] > 255) {
+            return false;
+        }
+    }
+    rgb.r = static_cast<uint8_t>(components[0]);
+    rgb.g = static_cast<uint8_t>(components[1]);
+    rgb.b = static_cast<uint8_t>(components[2]);
+    return true;
+}
+
+} // namespace ThemeValueParser
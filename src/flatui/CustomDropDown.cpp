@@ -1,8 +1,10 @@
 #include "flatui/CustomDropDown.h"
+#include "flatui/FlatUITextExtentCache.h"
 #include "config/SvgIconManager.h"
 #include "config/ThemeManager.h"
 #include <wx/dcbuffer.h>
 #include <wx/settings.h>
+#include <wx/weakref.h>
 
 // Define the custom event
 wxDEFINE_EVENT(wxEVT_CUSTOM_DROPDOWN_SELECTION, wxCommandEvent);
@@ -333,7 +335,7 @@ CustomDropDownStyle CustomDropDown::GetDropDownStyle() const
 void CustomDropDown::SetLeftIcon(const wxString& iconName)
 {
     m_leftIconName = iconName;
-    Refresh();
+    RequestLeftIcon();
 }
 
 wxString CustomDropDown::GetLeftIcon() const
@@ -344,9 +346,31 @@ wxString CustomDropDown::GetLeftIcon() const
 void CustomDropDown::SetLeftIconSize(const wxSize& size)
 {
     m_leftIconSize = size;
+    RequestLeftIcon();
     Refresh();
 }
 
+void CustomDropDown::RequestLeftIcon()
+{
+    m_leftIconBitmap = wxNullBitmap;
+    if (m_leftIconName.IsEmpty()) {
+        Refresh();
+        return;
+    }
+
+    // Only the icon area is repainted when the bitmap arrives; stale replies are ignored
+    wxWeakRef<CustomDropDown> self(this);
+    wxString iconName = m_leftIconName;
+    wxSize iconSize = m_leftIconSize;
+    SvgIconManager::GetInstance().RequestIconAsync(iconName, iconSize, [self, iconName, iconSize](const wxBitmap& bitmap) {
+        if (!self || self->m_leftIconName != iconName || self->m_leftIconSize != iconSize) {
+            return;
+        }
+        self->m_leftIconBitmap = bitmap;
+        self->RefreshRect(self->GetLeftIconRect());
+    });
+}
+
 wxSize CustomDropDown::GetLeftIconSize() const
 {
     return m_leftIconSize;
@@ -562,8 +586,7 @@ void CustomDropDown::DrawLeftIcon(wxDC& dc)
         return;
     }
     
-    wxBitmap iconBitmap = SvgIconManager::GetInstance().GetIconBitmap(m_leftIconName, m_leftIconSize);
-    
+    const wxBitmap& iconBitmap = m_leftIconBitmap;
     if (iconBitmap.IsOk()) {
         // Center the icon in the rect
         int iconX = iconRect.x + (iconRect.width - m_leftIconSize.GetWidth()) / 2;
@@ -785,7 +808,7 @@ wxSize CustomDropDownPopup::GetBestSize() const
     
     int maxWidth = 0;
     for (const wxString& item : m_items) {
-        wxSize textSize = dc.GetTextExtent(item);
+        wxSize textSize = FlatUITextExtentCache::GetInstance().GetTextExtent(dc, item);
         maxWidth = wxMax(maxWidth, textSize.GetWidth());
     }
     
@@ -893,7 +916,7 @@ void CustomDropDownPopup::DrawItems(wxDC& dc)
             dc.SetTextForeground(GetForegroundColour());
         }
         
-        wxSize textSize = dc.GetTextExtent(m_items[i]);
+        wxSize textSize = FlatUITextExtentCache::GetInstance().GetTextExtent(dc, m_items[i]);
         int textY = itemRect.y + (itemRect.height - textSize.GetHeight()) / 2;
         dc.DrawText(m_items[i], itemRect.x + 5, textY);
     }
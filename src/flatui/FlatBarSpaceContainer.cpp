@@ -7,6 +7,8 @@
 #include "flatui/FlatUIProfileSpace.h"
 #include "flatui/FlatUITabDropdown.h"
 #include "flatui/FlatUIBarStateManager.h"
+#include "flatui/FlatUIResourcePool.h"
+#include "flatui/FlatUITextExtentCache.h"
 #include "config/ThemeManager.h"
 #include "logger/Logger.h"
 #include <wx/dcbuffer.h>
@@ -327,7 +329,7 @@ void FlatBarSpaceContainer::PaintTabs(wxDC& dc)
     //        "," + std::to_string(m_tabAreaRect.height) + ")", "BarSpaceContainer");
     
     // Set up drawing context
-    dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+    dc.SetFont(FlatUIResourcePool::GetInstance().GetFont(8));
     
     int currentX = m_tabAreaRect.x;
     int tabY = m_tabAreaRect.y + 4; // Add some top margin
@@ -349,7 +351,7 @@ void FlatBarSpaceContainer::PaintTabs(wxDC& dc)
         if (!page) continue;
         
         wxString label = page->GetLabel();
-        wxSize labelSize = dc.GetTextExtent(label);
+        wxSize labelSize = FlatUITextExtentCache::GetInstance().GetTextExtent(dc, label);
         int tabWidth = CalculateTabWidth(dc, label);
         
         // Double check if tab fits in available area
@@ -589,7 +591,7 @@ bool FlatBarSpaceContainer::HandleTabClick(const wxPoint& pos)
     int tabSpacing = CFG_INT("BarTabSpacing");
     
     wxClientDC dc(this);
-    dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+    dc.SetFont(FlatUIResourcePool::GetInstance().GetFont(8));
     
     // Only check visible tabs
     for (size_t tabIndex : m_visibleTabIndices) {
@@ -597,7 +599,6 @@ bool FlatBarSpaceContainer::HandleTabClick(const wxPoint& pos)
         if (!page) continue;
         
         wxString label = page->GetLabel();
-        wxSize labelSize = dc.GetTextExtent(label);
         int tabWidth = CalculateTabWidth(dc, label);
         
         wxRect tabRect(currentX, m_tabAreaRect.y, tabWidth, m_tabAreaRect.height);
@@ -639,7 +640,7 @@ bool FlatBarSpaceContainer::HandleTabClick(const wxPoint& pos)
 
 int FlatBarSpaceContainer::CalculateTabWidth(wxDC& dc, const wxString& label) const
 {
-    wxSize labelSize = dc.GetTextExtent(label);
+    wxSize labelSize = FlatUITextExtentCache::GetInstance().GetTextExtent(dc, label);
     int tabPadding = CFG_INT("BarTabPadding");
     return labelSize.GetWidth() + tabPadding * 2;
 }
@@ -658,7 +659,7 @@ void FlatBarSpaceContainer::UpdateTabOverflow()
     m_hiddenTabIndices.clear();
     
     wxClientDC dc(this);
-    dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+    dc.SetFont(FlatUIResourcePool::GetInstance().GetFont(8));
     
     int tabSpacing = CFG_INT("BarTabSpacing");
     int availableWidth = m_tabAreaRect.width;
@@ -720,7 +721,7 @@ void FlatBarSpaceContainer::UpdateTabOverflow()
                 FlatUIPage* page = parentBar->GetPage(tabIndex);
                 if (page) {
                     wxClientDC dc(this);
-                    dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+                    dc.SetFont(FlatUIResourcePool::GetInstance().GetFont(8));
                     int tabWidth = CalculateTabWidth(dc, page->GetLabel());
                     
                     if (i > 0) lastTabEnd += tabSpacing;
@@ -59,7 +59,8 @@ FlatUIBar::FlatUIBar(wxWindow* parent, wxWindowID id, const wxPoint& pos, const
     m_hiddenTabsMenu(nullptr),
     m_visibleTabsCount(0),
     m_functionSpaceUserVisible(true),  // Default to visible
-    m_profileSpaceUserVisible(true)    // Default to visible
+    m_profileSpaceUserVisible(true),    // Default to visible
+    m_themeSubscription([this]() { Refresh(); })
 {
     SetName("FlatUIBar");
     SetFont(CFG_DEFAULTFONT());
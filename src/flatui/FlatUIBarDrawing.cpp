@@ -6,6 +6,7 @@
 #include <string>
 #include "logger/Logger.h"
 #include "config/ThemeManager.h"
+#include "flatui/FlatUIResourcePool.h"
 
 
 void FlatUIBar::DrawBackground(wxDC& dc) 
@@ -13,13 +14,13 @@ void FlatUIBar::DrawBackground(wxDC& dc)
     wxSize clientSize = GetClientSize();
     int padding = (CFG_INT("BarPadding"));
     int barH = GetBarHeight();
-    dc.SetBrush(CFG_COLOUR("BarBackgroundColour"));
+    dc.SetBrush(CFG_BRUSH("BarBackgroundColour"));
     dc.SetPen(*wxTRANSPARENT_PEN);
     dc.DrawRectangle(0, 0, clientSize.GetWidth(), barH);
 
     if (!IsBarPinned() && m_temporarilyShownPage == nullptr) {
         int unpinnedIndicatorHeight = 5;
-        dc.SetBrush(wxBrush(CFG_COLOUR("SecondaryBackgroundColour")));
+        dc.SetBrush(CFG_BRUSH("SecondaryBackgroundColour"));
         dc.SetPen(*wxTRANSPARENT_PEN);
         dc.DrawRectangle(0, barH, clientSize.GetWidth(), unpinnedIndicatorHeight);
     }
@@ -30,12 +31,13 @@ void FlatUIBar::DrawBarSeparator(wxDC& dc)
     wxSize clientSize = GetClientSize();
     int padding = (CFG_INT("BarPadding"));
     int barH = GetBarHeight() - m_barBottomMargin;;
-    dc.SetPen(wxPen(CFG_COLOUR("BarBorderColour"), 1));
+    dc.SetPen(CFG_PEN("BarBorderColour"));
     dc.DrawLine(padding, barH, clientSize.GetWidth() - padding, barH);
 }
 
 void FlatUIBar::OnPaint(wxPaintEvent& evt)
 {
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
     if (m_performanceManager) {
         m_performanceManager->StartPerformanceTimer("FlatUIBar_OnPaint");
     }
@@ -62,6 +64,7 @@ void FlatUIBar::OnPaint(wxPaintEvent& evt)
     }
 
     if (m_performanceManager) {
+        m_performanceManager->RecordRepaint(this, GetUpdateRegion(), 0, 0);
         m_performanceManager->EndPerformanceTimer("FlatUIBar_OnPaint");
     }
 }
@@ -75,14 +78,14 @@ void FlatUIBar::DrawBackgroundOptimized(wxGraphicsContext& gc)
     int barH = GetBarHeight();
     
     // Use hardware-accelerated drawing
-    gc.SetBrush(wxBrush(CFG_COLOUR("BarBackgroundColour")));
+    gc.SetBrush(CFG_BRUSH("BarBackgroundColour"));
     gc.SetPen(*wxTRANSPARENT_PEN);
     gc.DrawRectangle(0, 0, clientSize.GetWidth(), barH);
 
     if (!IsBarPinned() && m_temporarilyShownPage == nullptr) {
         int unpinnedIndicatorHeight = m_performanceManager ? 
             m_performanceManager->GetDPIAwareValue("UnpinnedIndicatorHeight", 5) : 5;
-        gc.SetBrush(wxBrush(CFG_COLOUR("SecondaryBackgroundColour")));
+        gc.SetBrush(CFG_BRUSH("SecondaryBackgroundColour"));
         gc.SetPen(*wxTRANSPARENT_PEN);
         gc.DrawRectangle(0, barH, clientSize.GetWidth(), unpinnedIndicatorHeight);
     }
@@ -100,7 +103,7 @@ void FlatUIBar::DrawBarSeparatorOptimized(wxGraphicsContext& gc)
     int penWidth = m_performanceManager ? 
         m_performanceManager->GetDPIAwareValue("BorderWidth", 1) : 1;
     
-    gc.SetPen(wxPen(CFG_COLOUR("BarBorderColour"), penWidth));
+    gc.SetPen(FlatUIResourcePool::GetInstance().GetPen(CFG_COLOUR("BarBorderColour"), penWidth));
     gc.StrokeLine(padding, barH, clientSize.GetWidth() - padding, barH);
 }
 
@@ -145,28 +148,25 @@ void FlatUIBar::DrawTabBorder(wxDC& dc, const wxRect& tabRect, bool isActive)
     wxColour bottomColour = m_tabBorderBottomColour;
     wxColour leftColour = m_tabBorderLeftColour;
     wxColour rightColour = m_tabBorderRightColour;
+    FlatUIResourcePool& pool = FlatUIResourcePool::GetInstance();
 
     switch (m_tabBorderStyle) {
     case TabBorderStyle::DASHED:
     {
         if (m_tabBorderTop > 0) {
-            wxPen dashedPen(topColour, m_tabBorderTop, wxPENSTYLE_SHORT_DASH);
-            gc->SetPen(dashedPen);
+            gc->SetPen(pool.GetPen(topColour, m_tabBorderTop, wxPENSTYLE_SHORT_DASH));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop(), tabRect.GetRight(), tabRect.GetTop());
         }
         if (m_tabBorderBottom > 0) {
-            wxPen dashedPen(bottomColour, m_tabBorderBottom, wxPENSTYLE_SHORT_DASH);
-            gc->SetPen(dashedPen);
+            gc->SetPen(pool.GetPen(bottomColour, m_tabBorderBottom, wxPENSTYLE_SHORT_DASH));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetBottom(), tabRect.GetRight(), tabRect.GetBottom());
         }
         if (m_tabBorderLeft > 0) {
-            wxPen dashedPen(leftColour, m_tabBorderLeft, wxPENSTYLE_SHORT_DASH);
-            gc->SetPen(dashedPen);
+            gc->SetPen(pool.GetPen(leftColour, m_tabBorderLeft, wxPENSTYLE_SHORT_DASH));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop(), tabRect.GetLeft(), tabRect.GetBottom());
         }
         if (m_tabBorderRight > 0) {
-            wxPen dashedPen(rightColour, m_tabBorderRight, wxPENSTYLE_SHORT_DASH);
-            gc->SetPen(dashedPen);
+            gc->SetPen(pool.GetPen(rightColour, m_tabBorderRight, wxPENSTYLE_SHORT_DASH));
             gc->StrokeLine(tabRect.GetRight(), tabRect.GetTop(), tabRect.GetRight(), tabRect.GetBottom());
         }
     }
@@ -175,23 +175,19 @@ void FlatUIBar::DrawTabBorder(wxDC& dc, const wxRect& tabRect, bool isActive)
     case TabBorderStyle::DOTTED:
     {
         if (m_tabBorderTop > 0) {
-            wxPen dottedPen(topColour, m_tabBorderTop, wxPENSTYLE_DOT);
-            gc->SetPen(dottedPen);
+            gc->SetPen(pool.GetPen(topColour, m_tabBorderTop, wxPENSTYLE_DOT));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop(), tabRect.GetRight(), tabRect.GetTop());
         }
         if (m_tabBorderBottom > 0) {
-            wxPen dottedPen(bottomColour, m_tabBorderBottom, wxPENSTYLE_DOT);
-            gc->SetPen(dottedPen);
+            gc->SetPen(pool.GetPen(bottomColour, m_tabBorderBottom, wxPENSTYLE_DOT));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetBottom(), tabRect.GetRight(), tabRect.GetBottom());
         }
         if (m_tabBorderLeft > 0) {
-            wxPen dottedPen(leftColour, m_tabBorderLeft, wxPENSTYLE_DOT);
-            gc->SetPen(dottedPen);
+            gc->SetPen(pool.GetPen(leftColour, m_tabBorderLeft, wxPENSTYLE_DOT));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop(), tabRect.GetLeft(), tabRect.GetBottom());
         }
         if (m_tabBorderRight > 0) {
-            wxPen dottedPen(rightColour, m_tabBorderRight, wxPENSTYLE_DOT);
-            gc->SetPen(dottedPen);
+            gc->SetPen(pool.GetPen(rightColour, m_tabBorderRight, wxPENSTYLE_DOT));
             gc->StrokeLine(tabRect.GetRight(), tabRect.GetTop(), tabRect.GetRight(), tabRect.GetBottom());
         }
     }
@@ -201,22 +197,22 @@ void FlatUIBar::DrawTabBorder(wxDC& dc, const wxRect& tabRect, bool isActive)
     {
         int gap = 2; // Gap between double lines
         if (m_tabBorderTop > 0) {
-            gc->SetPen(wxPen(topColour, 1));
+            gc->SetPen(pool.GetPen(topColour, 1));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop(), tabRect.GetRight(), tabRect.GetTop());
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop() + gap, tabRect.GetRight(), tabRect.GetTop() + gap);
         }
         if (m_tabBorderBottom > 0) {
-            gc->SetPen(wxPen(bottomColour, 1));
+            gc->SetPen(pool.GetPen(bottomColour, 1));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetBottom() - gap, tabRect.GetRight(), tabRect.GetBottom() - gap);
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetBottom(), tabRect.GetRight(), tabRect.GetBottom());
         }
         if (m_tabBorderLeft > 0) {
-            gc->SetPen(wxPen(leftColour, 1));
+            gc->SetPen(pool.GetPen(leftColour, 1));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop(), tabRect.GetLeft(), tabRect.GetBottom());
             gc->StrokeLine(tabRect.GetLeft() + gap, tabRect.GetTop(), tabRect.GetLeft() + gap, tabRect.GetBottom());
         }
         if (m_tabBorderRight > 0) {
-            gc->SetPen(wxPen(rightColour, 1));
+            gc->SetPen(pool.GetPen(rightColour, 1));
             gc->StrokeLine(tabRect.GetRight() - gap, tabRect.GetTop(), tabRect.GetRight() - gap, tabRect.GetBottom());
             gc->StrokeLine(tabRect.GetRight(), tabRect.GetTop(), tabRect.GetRight(), tabRect.GetBottom());
         }
@@ -238,15 +234,15 @@ void FlatUIBar::DrawTabBorder(wxDC& dc, const wxRect& tabRect, bool isActive)
         }
 
         if (m_tabBorderTop > 0 && isActive) {
-            gc->SetPen(wxPen(darkColour, m_tabBorderTop / 2));
+            gc->SetPen(pool.GetPen(darkColour, m_tabBorderTop / 2));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop(), tabRect.GetRight(), tabRect.GetTop());
-            gc->SetPen(wxPen(lightColour, m_tabBorderTop / 2));
+            gc->SetPen(pool.GetPen(lightColour, m_tabBorderTop / 2));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop() + m_tabBorderTop / 2, tabRect.GetRight(), tabRect.GetTop() + m_tabBorderTop / 2);
         }
         if (m_tabBorderLeft > 0) {
-            gc->SetPen(wxPen(darkColour, m_tabBorderLeft / 2));
+            gc->SetPen(pool.GetPen(darkColour, m_tabBorderLeft / 2));
             gc->StrokeLine(tabRect.GetLeft(), tabRect.GetTop(), tabRect.GetLeft(), tabRect.GetBottom());
-            gc->SetPen(wxPen(lightColour, m_tabBorderLeft / 2));
+            gc->SetPen(pool.GetPen(lightColour, m_tabBorderLeft / 2));
             gc->StrokeLine(tabRect.GetLeft() + m_tabBorderLeft / 2, tabRect.GetTop(), tabRect.GetLeft() + m_tabBorderLeft / 2, tabRect.GetBottom());
         }
     }
@@ -255,7 +251,7 @@ void FlatUIBar::DrawTabBorder(wxDC& dc, const wxRect& tabRect, bool isActive)
     case TabBorderStyle::ROUNDED:
     {
         gc->SetAntialiasMode(wxANTIALIAS_DEFAULT);
-        gc->SetPen(wxPen(topColour, wxMax(wxMax(m_tabBorderTop, m_tabBorderBottom),
+        gc->SetPen(pool.GetPen(topColour, wxMax(wxMax(m_tabBorderTop, m_tabBorderBottom),
             wxMax(m_tabBorderLeft, m_tabBorderRight))));
         wxGraphicsPath path = gc->CreatePath();
         path.AddRoundedRectangle(tabRect.x, tabRect.y, tabRect.width, tabRect.height, m_tabCornerRadius);
@@ -1,6 +1,7 @@
 #include "flatui/FlatUIBarLayoutManager.h"
 #include "flatui/FlatUIBar.h"
 #include "flatui/FlatUIBarConfig.h"
+#include "flatui/FlatUITextExtentCache.h"
 #include "config/ThemeManager.h"
 #include "logger/Logger.h"
 #include <wx/dcmemory.h>
@@ -233,7 +234,7 @@ int FlatUIBarLayoutManager::CalculateTabsWidth(wxDC& dc) const
         if (!page) continue;
         
         wxString label = page->GetLabel();
-        wxSize labelSize = dc.GetTextExtent(label);
+        wxSize labelSize = FlatUITextExtentCache::GetInstance().GetTextExtent(dc, label);
         totalWidth += labelSize.GetWidth() + tabPadding * 2;
         
         if (i < pageCount - 1) {
@@ -259,7 +260,7 @@ TabLayoutParams FlatUIBarLayoutManager::CalculateVisibleTabs(wxDC& dc, int avail
         if (!page) continue;
 
         wxString label = page->GetLabel();
-        wxSize labelSize = dc.GetTextExtent(label);
+        wxSize labelSize = FlatUITextExtentCache::GetInstance().GetTextExtent(dc, label);
         int tabWidth = labelSize.GetWidth() + tabPadding * 2;
         int widthWithSpacing = tabWidth + (result.visibleCount > 0 ? tabSpacing : 0);
 
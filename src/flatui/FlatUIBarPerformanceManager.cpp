@@ -1,6 +1,11 @@
 #include "flatui/FlatUIBarPerformanceManager.h"
 #include "flatui/FlatUIBar.h"
+#include "flatui/FlatUIResourcePool.h"
+#include "flatui/FlatUITextExtentCache.h"
+#include "flatui/FlatUILayoutEngine.h"
 #include "config/ThemeManager.h"
+#include "config/ConfigManager.h"
+#include "config/SvgIconManager.h"
 #include "logger/Logger.h"
 #include <wx/dcbuffer.h>
 #include <wx/dcmemory.h>
@@ -14,7 +19,42 @@
 #pragma comment(lib, "dwmapi.lib")
 #endif
 
+namespace {
+    // Scaled bitmaps are charged by pixel memory; fonts and values by entry size
+    size_t ResourceBitmapCost(const DPIAwareResource& resource)
+    {
+        return resource.bitmap.IsOk()
+            ? static_cast<size_t>(resource.bitmap.GetWidth()) * resource.bitmap.GetHeight() * 4
+            : sizeof(DPIAwareResource);
+    }
+
+    size_t ResourceEntryCost(const DPIAwareResource&)
+    {
+        return sizeof(DPIAwareResource);
+    }
+
+    size_t ResourceBudgetBytes()
+    {
+        int kb = ConfigManager::getInstance().getInt("IconCache", "DpiResourceCacheBudgetKB", 8192);
+        return static_cast<size_t>(std::max(kb, 64)) * 1024;
+    }
+
+    uint64_t RegionArea(const wxRegion& region)
+    {
+        uint64_t area = 0;
+        for (wxRegionIterator it(region); it; ++it) {
+            area += static_cast<uint64_t>(it.GetW()) * it.GetH();
+        }
+        return area;
+    }
 
+    void LogResourceCacheStats(const char* label, const LruCache<wxString, DPIAwareResource>::Stats& stats)
+    {
+        LOG_INF(wxString::Format("%s cache: %zu entries, %zu/%zu KB, %llu hits, %llu misses, %llu evictions",
+            label, stats.entries, stats.bytes / 1024, stats.budget / 1024,
+            (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.evictions), "PerformanceManager");
+    }
+}
 
 FlatUIBarPerformanceManager::FlatUIBarPerformanceManager(FlatUIBar* bar)
     : m_bar(bar)
@@ -22,7 +62,9 @@ FlatUIBarPerformanceManager::FlatUIBarPerformanceManager(FlatUIBar* bar)
     , m_hardwareAcceleration(true)
     , m_batchPainting(false)
     , m_optimizationFlags(PerformanceOptimization::ALL)
-    , m_hasInvalidRegions(false)
+    , m_bitmapCache(ResourceBudgetBytes(), ResourceBitmapCost)
+    , m_fontCache(ResourceBudgetBytes() / 16, ResourceEntryCost)
+    , m_valueCache(ResourceBudgetBytes() / 16, ResourceEntryCost)
 {
     UpdateDPIScale();
     
@@ -41,6 +83,35 @@ FlatUIBarPerformanceManager::~FlatUIBarPerformanceManager()
     LogPerformanceStats();
 }
 
+FlatUIBarPerformanceManager* FlatUIBarPerformanceManager::FromWindow(wxWindow* window)
+{
+    for (wxWindow* current = window; current; current = current->GetParent()) {
+        if (FlatUIBar* bar = dynamic_cast<FlatUIBar*>(current)) {
+            return bar->GetPerformanceManager();
+        }
+        if (current->IsTopLevel()) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+void FlatUIBarPerformanceManager::RefreshWindowRect(wxWindow* window, const wxRect& rect)
+{
+    if (!window || rect.IsEmpty()) {
+        return;
+    }
+    FlatUIBarPerformanceManager* manager = FromWindow(window);
+    if (manager && !manager->IsOptimizationEnabled(PerformanceOptimization::DIRTY_REGION_TRACKING)) {
+        window->Refresh();
+        return;
+    }
+    if (manager) {
+        manager->InvalidateRegion(window, rect);
+    }
+    window->RefreshRect(rect, false);
+}
+
 double FlatUIBarPerformanceManager::GetCurrentDPIScale() const
 {
     return m_currentDPIScale;
@@ -54,6 +125,7 @@ void FlatUIBarPerformanceManager::OnDPIChanged()
     if (oldScale != m_currentDPIScale) {
         // Clear caches when DPI changes
         ClearResourceCache();
+        FlatUITextExtentCache::GetInstance().Clear();
         InvalidateAll();
         
         LOG_INF("DPI changed from " + std::to_string(oldScale) + " to " + 
@@ -105,9 +177,9 @@ wxBitmap FlatUIBarPerformanceManager::GetDPIAwareBitmap(const wxString& key, con
     
     wxString cacheKey = GenerateCacheKey(key, m_currentDPIScale);
     
-    auto it = m_bitmapCache.find(cacheKey);
-    if (it != m_bitmapCache.end() && it->second.scaleFactor == m_currentDPIScale) {
-        return it->second.bitmap;
+    const DPIAwareResource* cached = m_bitmapCache.Find(cacheKey);
+    if (cached && cached->scaleFactor == m_currentDPIScale) {
+        return cached->bitmap;
     }
     
     // Create DPI-scaled bitmap
@@ -115,7 +187,7 @@ wxBitmap FlatUIBarPerformanceManager::GetDPIAwareBitmap(const wxString& key, con
     wxBitmap scaledBitmap = originalBitmap.ConvertToImage()
         .Scale(scaledSize.GetWidth(), scaledSize.GetHeight(), wxIMAGE_QUALITY_HIGH);
     
-    m_bitmapCache[cacheKey] = DPIAwareResource(m_currentDPIScale, scaledBitmap);
+    m_bitmapCache.Put(cacheKey, DPIAwareResource(m_currentDPIScale, scaledBitmap));
     
     LOG_DBG("Created DPI-aware bitmap for key: " + key.ToStdString() + 
             " at scale: " + std::to_string(m_currentDPIScale), "PerformanceManager");
@@ -137,9 +209,9 @@ wxFont FlatUIBarPerformanceManager::GetCachedFont(const wxString& key, const wxF
     
     wxString cacheKey = GenerateCacheKey(key, m_currentDPIScale);
     
-    auto it = m_fontCache.find(cacheKey);
-    if (it != m_fontCache.end() && it->second.scaleFactor == m_currentDPIScale) {
-        return it->second.font;
+    const DPIAwareResource* cached = m_fontCache.Find(cacheKey);
+    if (cached && cached->scaleFactor == m_currentDPIScale) {
+        return cached->font;
     }
     
     // Create DPI-scaled font
@@ -147,7 +219,7 @@ wxFont FlatUIBarPerformanceManager::GetCachedFont(const wxString& key, const wxF
     int newSize = FromDIP(originalFont.GetPointSize());
     scaledFont.SetPointSize(newSize);
     
-    m_fontCache[cacheKey] = DPIAwareResource(m_currentDPIScale, scaledFont);
+    m_fontCache.Put(cacheKey, DPIAwareResource(m_currentDPIScale, scaledFont));
     
     return scaledFont;
 }
@@ -161,22 +233,22 @@ int FlatUIBarPerformanceManager::GetDPIAwareValue(const wxString& key, int origi
     
     wxString cacheKey = GenerateCacheKey(key, m_currentDPIScale);
     
-    auto it = m_valueCache.find(cacheKey);
-    if (it != m_valueCache.end() && it->second.scaleFactor == m_currentDPIScale) {
-        return it->second.intValue;
+    const DPIAwareResource* cached = m_valueCache.Find(cacheKey);
+    if (cached && cached->scaleFactor == m_currentDPIScale) {
+        return cached->intValue;
     }
     
     int scaledValue = FromDIP(originalValue);
-    m_valueCache[cacheKey] = DPIAwareResource(m_currentDPIScale, scaledValue);
+    m_valueCache.Put(cacheKey, DPIAwareResource(m_currentDPIScale, scaledValue));
     
     return scaledValue;
 }
 
 void FlatUIBarPerformanceManager::ClearResourceCache()
 {
-    m_bitmapCache.clear();
-    m_fontCache.clear();
-    m_valueCache.clear();
+    m_bitmapCache.Clear();
+    m_fontCache.Clear();
+    m_valueCache.Clear();
     
     LOG_DBG("Resource cache cleared", "PerformanceManager");
 }
@@ -254,56 +326,89 @@ wxGraphicsContext* FlatUIBarPerformanceManager::CreateOptimizedGraphicsContext(w
 
 void FlatUIBarPerformanceManager::InvalidateRegion(const wxRect& region)
 {
-    if (!IsOptimizationEnabled(PerformanceOptimization::DIRTY_REGION_TRACKING)) {
-        return;
-    }
-    
-    m_invalidRegions.push_back(region);
-    m_hasInvalidRegions = true;
-    
-    // Optimize by merging overlapping regions
-    if (m_invalidRegions.size() > 10) {
-        std::sort(m_invalidRegions.begin(), m_invalidRegions.end(), 
-                  [](const wxRect& a, const wxRect& b) { return a.x < b.x; });
-        
-        std::vector<wxRect> merged;
-        merged.reserve(m_invalidRegions.size());
-        
-        for (const auto& rect : m_invalidRegions) {
-            if (merged.empty() || !merged.back().Intersects(rect)) {
-                merged.push_back(rect);
-            } else {
-                merged.back() = merged.back().Union(rect);
-            }
-        }
-        
-        m_invalidRegions = std::move(merged);
-    }
+    // Bar coordinates are the bar's own client coordinates; FlatUIBar::OnPaint consumes them
+    InvalidateRegion(m_bar, region);
 }
 
 void FlatUIBarPerformanceManager::InvalidateAll()
 {
-    m_invalidRegions.clear();
-    if (m_bar) {
-        m_invalidRegions.push_back(m_bar->GetClientRect());
-    }
-    m_hasInvalidRegions = true;
+    // A full repaint follows, so pending item damage is covered without tracking it
+    m_windowDamage.clear();
 }
 
 bool FlatUIBarPerformanceManager::HasInvalidRegions() const
 {
-    return m_hasInvalidRegions && !m_invalidRegions.empty();
+    return std::any_of(m_windowDamage.begin(), m_windowDamage.end(),
+        [](const WindowDamage& entry) { return entry.window.get() != nullptr; });
 }
 
 std::vector<wxRect> FlatUIBarPerformanceManager::GetInvalidRegions() const
 {
-    return m_invalidRegions;
+    std::vector<wxRect> rects;
+    for (const auto& entry : m_windowDamage) {
+        if (!entry.window) {
+            continue;
+        }
+        wxPoint offset = GetOffsetInBar(entry.window.get());
+        for (wxRegionIterator it(entry.damage); it; ++it) {
+            wxRect rect = it.GetRect();
+            rect.Offset(offset);
+            rects.push_back(rect);
+        }
+    }
+    return rects;
 }
 
 void FlatUIBarPerformanceManager::ClearInvalidRegions()
 {
-    m_invalidRegions.clear();
-    m_hasInvalidRegions = false;
+    m_windowDamage.clear();
+}
+
+void FlatUIBarPerformanceManager::InvalidateRegion(wxWindow* window, const wxRect& rect)
+{
+    if (!window || !IsOptimizationEnabled(PerformanceOptimization::DIRTY_REGION_TRACKING)) {
+        return;
+    }
+
+    // Entries of destroyed controls are dropped here; their damage will never be painted
+    m_windowDamage.erase(std::remove_if(m_windowDamage.begin(), m_windowDamage.end(),
+        [](const WindowDamage& entry) { return !entry.window; }),
+        m_windowDamage.end());
+
+    for (auto& entry : m_windowDamage) {
+        if (entry.window.get() == window) {
+            entry.damage.Union(rect);
+            return;
+        }
+    }
+    WindowDamage entry;
+    entry.window = window;
+    entry.damage = wxRegion(rect);
+    m_windowDamage.push_back(entry);
+}
+
+void FlatUIBarPerformanceManager::RecordRepaint(wxWindow* window, const wxRegion& damage, size_t itemsDrawn, size_t itemsSkipped)
+{
+    uint64_t pixels = RegionArea(damage);
+    wxSize client = window->GetClientSize();
+
+    m_repaintStats.frames++;
+    m_repaintStats.pixelsRepainted += pixels;
+    m_repaintStats.pixelsFullRepaint += static_cast<uint64_t>(std::max(client.GetWidth(), 0)) * std::max(client.GetHeight(), 0);
+    m_repaintStats.lastFramePixels = pixels;
+    m_repaintStats.itemsDrawn += itemsDrawn;
+    m_repaintStats.itemsSkipped += itemsSkipped;
+
+    // Damage is kept per window, so whatever this paint covered is simply subtracted
+    for (auto it = m_windowDamage.begin(); it != m_windowDamage.end(); ++it) {
+        if (it->window.get() == window) {
+            it->damage.Subtract(damage);
+            if (it->damage.IsEmpty()) {
+                m_windowDamage.erase(it);
+            }
+            break;
+        }
+    }
 }
 
 void FlatUIBarPerformanceManager::BeginBatchPaint()
@@ -402,6 +507,30 @@ void FlatUIBarPerformanceManager::LogPerformanceStats() const
                 ", max=" + std::to_string(max_time) + "ms" +
                 ", count=" + std::to_string(stat.second.size()), "PerformanceManager");
     }
+
+    if (m_repaintStats.frames > 0) {
+        const RepaintStats& repaint = m_repaintStats;
+        double share = repaint.pixelsFullRepaint > 0 ? 100.0 * repaint.pixelsRepainted / repaint.pixelsFullRepaint : 100.0;
+        LOG_INF(wxString::Format("Repaint: %llu frames, %.0f px/frame (%.1f%% of full repaints), %llu items drawn, %llu skipped",
+            (unsigned long long)repaint.frames, double(repaint.pixelsRepainted) / repaint.frames, share,
+            (unsigned long long)repaint.itemsDrawn, (unsigned long long)repaint.itemsSkipped), "PerformanceManager");
+    }
+
+    LogResourceCacheStats("DPI bitmap", m_bitmapCache.GetStats());
+    LogResourceCacheStats("DPI font", m_fontCache.GetStats());
+    LogResourceCacheStats("DPI value", m_valueCache.GetStats());
+}
+
+void FlatUIBarPerformanceManager::LogSharedStats()
+{
+    // The icon manager may have been reset; creating it here would reload every icon
+    if (SvgIconManager* icons = SvgIconManager::GetExistingInstance()) {
+        icons->LogCacheStats();
+    }
+
+    FlatUIResourcePool::GetInstance().LogStats();
+    FlatUITextExtentCache::GetInstance().LogStats();
+    FlatUILayoutEngine::GetInstance().LogStats();
 }
 
 void FlatUIBarPerformanceManager::SetOptimizationFlags(PerformanceOptimization flags)
@@ -446,7 +575,8 @@ void FlatUIBarPerformanceManager::PreloadResources()
     };
     
     for (const auto& key : commonKeys) {
-        GetDPIAwareValue(key, CFG_INT(key.ToStdString()));
+        // Runtime key: use the string overload, CFG_INT only accepts literals
+        GetDPIAwareValue(key, ThemeManager::getInstance().getInt(key.ToStdString()));
     }
     
     LOG_INF("Resource preloading completed", "PerformanceManager");
@@ -508,6 +638,14 @@ void FlatUIBarPerformanceManager::UpdateDPIScale()
 #endif
 }
 
+wxPoint FlatUIBarPerformanceManager::GetOffsetInBar(wxWindow* window) const
+{
+    if (!m_bar || !window || window == m_bar) {
+        return wxPoint(0, 0);
+    }
+    return m_bar->ScreenToClient(window->ClientToScreen(wxPoint(0, 0)));
+}
+
 wxString FlatUIBarPerformanceManager::GenerateCacheKey(const wxString& baseKey, double scaleFactor) const
 {
     return baseKey + "_" + wxString::Format("%.2f", scaleFactor);
@@ -516,14 +654,10 @@ wxString FlatUIBarPerformanceManager::GenerateCacheKey(const wxString& baseKey,
 void FlatUIBarPerformanceManager::CleanupExpiredCacheEntries()
 {
     // Remove cache entries that don't match current DPI scale
-    auto cleanupCache = [this](auto& cache) {
-        for (auto it = cache.begin(); it != cache.end();) {
-            if (std::abs(it->second.scaleFactor - m_currentDPIScale) > 0.01) {
-                it = cache.erase(it);
-            } else {
-                ++it;
-            }
-        }
+    auto cleanupCache = [this](ResourceCache& cache) {
+        cache.EraseIf([this](const wxString&, const DPIAwareResource& resource) {
+            return std::abs(resource.scaleFactor - m_currentDPIScale) > 0.01;
+        });
     };
     
     cleanupCache(m_bitmapCache);
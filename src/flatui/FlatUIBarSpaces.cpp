@@ -1,4 +1,5 @@
 #include "flatui/FlatUIBar.h"
+#include "flatui/FlatUITextExtentCache.h"
 #include <wx/dcbuffer.h>
 #include "config/ThemeManager.h"
 #include "logger/Logger.h"
@@ -148,7 +149,7 @@ int FlatUIBar::CalculateTabsWidth(wxDC& dc) const
         FlatUIPage* page = GetPage(i);
         if (!page) continue;
         wxString label = page->GetLabel();
-        wxSize labelSize = dc.GetTextExtent(label);
+        wxSize labelSize = FlatUITextExtentCache::GetInstance().GetTextExtent(dc, label);
         totalWidth += labelSize.GetWidth() + tabPadding * 2;
         if (i < GetPageCount() - 1)
         {
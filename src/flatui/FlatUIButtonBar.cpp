@@ -1,11 +1,30 @@
 #include "flatui/FlatUIButtonBar.h"
 #include "flatui/FlatUIPanel.h"
 #include "flatui/FlatUIEventManager.h"
+#include "flatui/FlatUIBarPerformanceManager.h"
 #include <wx/dcbuffer.h>
 #include <wx/graphics.h>
 #include <wx/display.h>
 #include <algorithm> // For std::min
-#include "config/ThemeManager.h"  
+#include "config/ThemeManager.h"
+#include "flatui/FlatUIResourcePool.h"  
+#include "flatui/FlatUITextExtentCache.h"
+#include "config/SvgIconManager.h"
+#include <wx/weakref.h>
+#include <functional>
+
+namespace {
+    size_t StateBitmapBudgetBytes()
+    {
+        int kb = ConfigManager::getInstance().getInt("IconCache", "ButtonStateCacheBudgetKB", 2048);
+        return static_cast<size_t>(std::max(kb, 0)) * 1024;
+    }
+
+    size_t StateBitmapCost(const wxBitmap& bitmap)
+    {
+        return static_cast<size_t>(bitmap.GetWidth()) * bitmap.GetHeight() * 4;
+    }
+}
 
 
 
@@ -14,6 +33,7 @@ int targetH = -1;
 
 FlatUIButtonBar::FlatUIButtonBar(FlatUIPanel* parent)
     : wxControl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE),
+    FlatUILayoutNode(this),
     m_displayStyle(ButtonDisplayStyle::ICON_TEXT_BESIDE),
     m_buttonStyle(ButtonStyle::DEFAULT),
     m_buttonBorderStyle(ButtonBorderStyle::SOLID),
@@ -30,34 +50,13 @@ FlatUIButtonBar::FlatUIButtonBar(FlatUIPanel* parent)
     m_buttonHorizontalPadding(CFG_INT("ButtonbarHorizontalPadding")),
     m_buttonVerticalPadding(CFG_INT("ButtonbarInternalVerticalPadding")),
     m_btnBarBorderWidth(0),
-    m_hoverEffectsEnabled(true)
+    m_hoverEffectsEnabled(true),
+    m_stateBitmaps(StateBitmapBudgetBytes(), StateBitmapCost),
+    m_stateBitmapsEnabled(m_stateBitmaps.GetBudget() > 0),
+    m_themeSubscription([this]() { LoadThemeValues(); InvalidateButtonBitmaps(); }),
+    m_layoutSubscription([this]() { LoadThemeValues(); RecalculateLayout(); })
 {
-    m_buttonBgColour = CFG_COLOUR("ActBarBackgroundColour");
-    m_buttonHoverBgColour = CFG_COLOUR("ButtonbarDefaultHoverBgColour");
-    m_buttonPressedBgColour = CFG_COLOUR("ButtonbarDefaultPressedBgColour");
-    m_buttonTextColour = CFG_COLOUR("ButtonbarDefaultTextColour");
-    m_buttonBorderColour = CFG_COLOUR("ButtonbarDefaultBorderColour");
-    m_btnBarBgColour = CFG_COLOUR("ButtonbarDefaultBgColour");
-    m_btnBarBorderColour = CFG_COLOUR("ButtonbarDefaultBorderColour");
-
-
-    m_buttonBorderWidth = CFG_INT("ButtonbarDefaultBorderWidth");
-    m_buttonCornerRadius = CFG_INT("ButtonbarDefaultCornerRadius");
-    m_buttonSpacing = CFG_INT("ButtonbarSpacing");
-    m_buttonHorizontalPadding = CFG_INT("ButtonbarHorizontalPadding");
-    m_buttonVerticalPadding = CFG_INT("ButtonbarInternalVerticalPadding");
-
-
-    m_dropdownArrowWidth = CFG_INT("ButtonbarDropdownArrowWidth");
-    m_dropdownArrowHeight = CFG_INT("ButtonbarDropdownArrowHeight");
-
-
-    m_separatorWidth = CFG_INT("ButtonbarSeparatorWidth");
-    m_separatorPadding = CFG_INT("ButtonbarSeparatorPadding");
-    m_separatorMargin = CFG_INT("ButtonbarSeparatorMargin");
-
-
-    m_btnBarHorizontalMargin = CFG_INT("ButtonbarBarHorizontalMargin");
+    LoadThemeValues();
 
     targetH = CFG_INT("ButtonbarTargetHeight");
 
@@ -74,32 +73,106 @@ FlatUIButtonBar::FlatUIButtonBar(FlatUIPanel* parent)
 
 FlatUIButtonBar::~FlatUIButtonBar() = default;
 
+void FlatUIButtonBar::LoadThemeValues()
+{
+    // Keys read here are recorded, so the subscriptions always match what is cached
+    {
+        ThemeSubscription::Recorder themeKeys(m_themeSubscription);
+        m_buttonBgColour = CFG_COLOUR("ActBarBackgroundColour");
+        m_buttonHoverBgColour = CFG_COLOUR("ButtonbarDefaultHoverBgColour");
+        m_buttonPressedBgColour = CFG_COLOUR("ButtonbarDefaultPressedBgColour");
+        m_buttonTextColour = CFG_COLOUR("ButtonbarDefaultTextColour");
+        m_buttonBorderColour = CFG_COLOUR("ButtonbarDefaultBorderColour");
+        m_btnBarBgColour = CFG_COLOUR("ButtonbarDefaultBgColour");
+        m_btnBarBorderColour = CFG_COLOUR("ButtonbarDefaultBorderColour");
+
+        m_buttonBorderWidth = CFG_INT("ButtonbarDefaultBorderWidth");
+        m_buttonCornerRadius = CFG_INT("ButtonbarDefaultCornerRadius");
+        m_buttonVerticalPadding = CFG_INT("ButtonbarInternalVerticalPadding");
+        m_dropdownArrowHeight = CFG_INT("ButtonbarDropdownArrowHeight");
+        m_separatorMargin = CFG_INT("ButtonbarSeparatorMargin");
+    }
+
+    // These feed CalculateButtonWidth, so edits to them re-measure the bar
+    ThemeSubscription::Recorder layoutKeys(m_layoutSubscription);
+    m_buttonSpacing = CFG_INT("ButtonbarSpacing");
+    m_buttonHorizontalPadding = CFG_INT("ButtonbarHorizontalPadding");
+    m_dropdownArrowWidth = CFG_INT("ButtonbarDropdownArrowWidth");
+    m_separatorWidth = CFG_INT("ButtonbarSeparatorWidth");
+    m_separatorPadding = CFG_INT("ButtonbarSeparatorPadding");
+    m_btnBarHorizontalMargin = CFG_INT("ButtonbarBarHorizontalMargin");
+}
+
 void FlatUIButtonBar::AddButton(int id, const wxString& label, const wxBitmap& bitmap, wxMenu* menu)
 {
-    Freeze();
     ButtonInfo button;
     button.id = id;
     button.label = label;
-    int imgw = CFG_INT("ButtonbarIconSize");
-    button.icon = bitmap;
+    button.icon = SvgIconManager::GetInstance().PackBitmap(bitmap);
+    button.menu = menu;
+    button.isDropDown = (menu != nullptr);
+    AppendButton(button);
+}
+
+void FlatUIButtonBar::AddButton(int id, const wxString& label, const wxString& iconName, wxMenu* menu)
+{
+    int iconSize = CFG_INT("ButtonbarIconSize");
+    wxSize size(iconSize, iconSize);
+    SvgIconManager& icons = SvgIconManager::GetInstance();
+
+    // The placeholder has the final icon size, so the real icon never changes the layout
+    ButtonInfo button;
+    button.id = id;
+    button.label = label;
+    button.icon = icons.GetAtlasPlaceholder(size);
+    button.iconName = iconName;
     button.menu = menu;
     button.isDropDown = (menu != nullptr);
+    AppendButton(button);
 
+    wxWeakRef<FlatUIButtonBar> self(this);
+    icons.RequestIconAsync(iconName, size, [self, id, iconName](const wxBitmap& bitmap) {
+        if (self) {
+            self->OnButtonIconReady(id, iconName, bitmap);
+        }
+    });
+}
+
+void FlatUIButtonBar::AppendButton(ButtonInfo& button)
+{
+    // Only the new label is measured; positions are assigned once in the next layout pass
     wxClientDC dc(this);
     dc.SetFont(CFG_DEFAULTFONT());
-    button.textSize = dc.GetTextExtent(label);
+    button.textSize = FlatUITextExtentCache::GetInstance().GetTextExtent(dc, button.label);
 
     m_buttons.push_back(button);
-    RecalculateLayout();
+    InvalidateMeasure();
+}
 
-    Thaw();
-    Refresh();
+void FlatUIButtonBar::OnButtonIconReady(int id, const wxString& iconName, const wxBitmap& bitmap)
+{
+    if (!bitmap.IsOk()) {
+        return;
+    }
+    IconAtlasHandle icon = SvgIconManager::GetInstance().GetAtlasIcon(iconName, bitmap.GetSize());
+    if (!icon.IsOk()) {
+        return;
+    }
+    for (size_t i = 0; i < m_buttons.size(); ++i) {
+        ButtonInfo& button = m_buttons[i];
+        if (button.id == id && button.iconName == iconName) {
+            button.icon = icon;
+            m_stateBitmaps.EraseIf([id](const StateBitmapKey& key, const wxBitmap&) { return key.id == id; });
+            m_displayList.Invalidate(i);
+            RefreshButton(i);
+        }
+    }
 }
 
-int FlatUIButtonBar::CalculateButtonWidth(const ButtonInfo& button, wxDC& dc) const
+int FlatUIButtonBar::CalculateButtonWidth(const ButtonInfo& button) const
 {
     int buttonWidth = 0;
-    int iconWidth = button.icon.IsOk() ? button.icon.GetWidth() : 0;
+    int iconWidth = button.icon.IsOk() ? button.icon.GetSize().GetWidth() : 0;
     const int STANDARD_BUTTON_SIZE = 24; // Standard button size 24x24
 
     switch (m_displayStyle) {
@@ -147,17 +220,42 @@ int FlatUIButtonBar::CalculateButtonWidth(const ButtonInfo& button, wxDC& dc) co
 
 void FlatUIButtonBar::RecalculateLayout()
 {
-    Freeze();
+    // The default font may have changed with the theme, so every label is measured again
     wxClientDC dc(this);
     dc.SetFont(CFG_DEFAULTFONT());
+    for (auto& button : m_buttons) {
+        button.textSize = FlatUITextExtentCache::GetInstance().GetTextExtent(dc, button.label);
+    }
+    InvalidateMeasure();
+}
+
+wxSize FlatUIButtonBar::MeasureOverride() const
+{
+    ThemeSubscription::Recorder layoutKeys(m_layoutSubscription);
+    int totalWidth = m_btnBarHorizontalMargin;
+    for (const auto& button : m_buttons) {
+        totalWidth += CalculateButtonWidth(button);
+        if (&button != &m_buttons.back()) {
+            totalWidth += m_buttonSpacing;
+        }
+    }
+    totalWidth += 2 * m_btnBarHorizontalMargin;
+
+    // Calculate overall button bar height using Gallery's target height for consistency
+    int galleryTargetHeight = CFG_INT("GalleryTargetHeight");
+    int totalBarHeight = galleryTargetHeight + 2 * CFG_INT("ButtonbarVerticalMargin");
+    return wxSize(totalWidth, totalBarHeight);
+}
+
+void FlatUIButtonBar::ArrangeOverride(const wxSize& measured)
+{
+    ThemeSubscription::Recorder layoutKeys(m_layoutSubscription);
     int currentX = m_btnBarHorizontalMargin;
     const int STANDARD_BUTTON_HEIGHT = 24; // Standard button height
+    int buttonY = CFG_INT("ButtonbarVerticalMargin");
 
     for (auto& button : m_buttons) {
-        if (button.textSize != dc.GetTextExtent(button.label)) {
-            button.textSize = dc.GetTextExtent(button.label);
-        }
-        int buttonWidth = CalculateButtonWidth(button, dc);
+        int buttonWidth = CalculateButtonWidth(button);
 
         // Button height calculation based on display style
         int buttonHeight = STANDARD_BUTTON_HEIGHT;
@@ -168,31 +266,29 @@ void FlatUIButtonBar::RecalculateLayout()
             }
         }
 
-        int buttonY = CFG_INT("ButtonbarVerticalMargin");
         button.rect = wxRect(currentX, buttonY, buttonWidth, buttonHeight);
         currentX += buttonWidth;
         if (&button != &m_buttons.back()) {
             currentX += m_buttonSpacing;
         }
     }
-    currentX += 2 * m_btnBarHorizontalMargin;
 
-    // Calculate overall button bar height using Gallery's target height for consistency
-    int galleryTargetHeight = CFG_INT("GalleryTargetHeight");
-    int totalBarHeight = galleryTargetHeight + 2 * CFG_INT("ButtonbarVerticalMargin"); 
-
-    wxSize currentMinSize = GetMinSize();
-    if (currentMinSize.GetWidth() != currentX || currentMinSize.GetHeight() != totalBarHeight) {
-        SetMinSize(wxSize(currentX, totalBarHeight));
-        InvalidateBestSize();
-        if (auto* parentPanel = dynamic_cast<FlatUIPanel*>(GetParent())) {
-            parentPanel->UpdatePanelSize();
-        }
-        else {
-            GetParent()->Layout();
-        }
+    // The panel measured against this size already; it runs its sizer after us
+    if (GetMinSize() != measured) {
+        SetMinSize(measured);
     }
-    Thaw();
+    RefreshButtons();
+}
+
+void FlatUIButtonBar::InvalidateButtonBitmaps()
+{
+    m_stateBitmaps.Clear();
+    RefreshButtons();
+}
+
+void FlatUIButtonBar::RefreshButtons()
+{
+    m_displayList.Invalidate();
     Refresh();
 }
 
@@ -207,31 +303,12 @@ void FlatUIButtonBar::SetDisplayStyle(ButtonDisplayStyle style)
 
 wxSize FlatUIButtonBar::DoGetBestSize() const
 {
-    wxMemoryDC dc;
-    dc.SetFont(CFG_DEFAULTFONT());
-    int totalWidth = m_btnBarHorizontalMargin;
-
-    for (const auto& button : m_buttons) {
-        totalWidth += CalculateButtonWidth(button, dc);
-        if (&button != &m_buttons.back()) {
-            totalWidth += m_buttonSpacing;
-        }
-    }
-    totalWidth += m_btnBarHorizontalMargin;
-
-    if (m_buttons.empty()) {
-        totalWidth = m_btnBarHorizontalMargin * 2;
-        if (totalWidth == 0) totalWidth = 10;
-    }
-
-    // Use same height calculation as Gallery for consistency
-    int galleryTargetHeight = CFG_INT("GalleryTargetHeight");
-    int totalHeight = galleryTargetHeight + 2 * CFG_INT("ButtonbarVerticalMargin");
-    return wxSize(totalWidth, totalHeight);
+    return Measure();
 }
 
 void FlatUIButtonBar::OnPaint(wxPaintEvent& evt)
 {
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
     wxAutoBufferedPaintDC dc(this);
     dc.SetBackground(m_btnBarBgColour);
     dc.Clear();
@@ -245,42 +322,160 @@ void FlatUIButtonBar::OnPaint(wxPaintEvent& evt)
         return;
     }
 
-    dc.SetFont(CFG_DEFAULTFONT());
+    // Only buttons invalidated since the last paint are regenerated
+    if (m_displayList.GetSegmentCount() != m_buttons.size()) {
+        m_displayList.Reset(m_buttons.size());
+    }
     for (size_t i = 0; i < m_buttons.size(); ++i) {
-        DrawButton(dc, m_buttons[i], i);
+        if (m_displayList.IsDirty(i)) {
+            FlatUIDisplayList::Builder builder = m_displayList.Rebuild(i);
+            BuildButton(builder, m_buttons[i], i);
+        }
+    }
+
+    // Hover and icon updates invalidate single buttons; skip everything outside the damage
+    wxRegion damage = GetUpdateRegion();
+    dc.SetFont(CFG_DEFAULTFONT());
+    IconAtlasPainter icons(dc);
+    size_t drawn = m_displayList.Replay(dc, icons, damage);
+    if (FlatUIBarPerformanceManager* perf = FlatUIBarPerformanceManager::FromWindow(this)) {
+        perf->RecordRepaint(this, damage, drawn, m_buttons.size() - drawn);
+    }
+}
+
+void FlatUIButtonBar::RefreshButton(int index)
+{
+    if (index < 0 || index >= static_cast<int>(m_buttons.size())) {
+        return;
+    }
+    // Old commands may reach past the rect (shadow, wide pens); the new border may too
+    wxRect damage = wxRect(m_buttons[index].rect).Inflate(m_buttonBorderWidth / 2 + 1);
+    wxRect previous = m_displayList.GetSegmentBounds(index);
+    if (!previous.IsEmpty()) {
+        damage.Union(previous);
+    }
+    FlatUIBarPerformanceManager::RefreshWindowRect(this, damage);
+}
+
+bool FlatUIButtonBar::StateBitmapKey::operator==(const StateBitmapKey& other) const
+{
+    return id == other.id && labelHash == other.labelHash && size == other.size &&
+        themeGeneration == other.themeGeneration && dpiPercent == other.dpiPercent &&
+        displayStyle == other.displayStyle && buttonStyle == other.buttonStyle &&
+        borderStyle == other.borderStyle && state == other.state;
+}
+
+size_t FlatUIButtonBar::StateBitmapKeyHash::operator()(const StateBitmapKey& key) const
+{
+    size_t hash = key.labelHash;
+    auto mix = [&hash](uint64_t value) { hash ^= std::hash<uint64_t>()(value) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+    mix(static_cast<uint32_t>(key.id));
+    mix((static_cast<uint64_t>(static_cast<uint32_t>(key.size.GetWidth())) << 32) | static_cast<uint32_t>(key.size.GetHeight()));
+    mix(key.themeGeneration);
+    mix(static_cast<uint32_t>(key.dpiPercent));
+    mix((static_cast<uint64_t>(key.displayStyle) << 24) | (static_cast<uint64_t>(key.buttonStyle) << 16) |
+        (static_cast<uint64_t>(key.borderStyle) << 8) | static_cast<uint64_t>(key.state));
+    return hash;
+}
+
+FlatUIButtonBar::StateBitmapKey FlatUIButtonBar::MakeStateBitmapKey(const ButtonInfo& button, ButtonState state) const
+{
+    StateBitmapKey key;
+    key.id = button.id;
+    key.labelHash = std::hash<wxString>()(button.label);
+    key.size = button.rect.GetSize();
+    key.themeGeneration = ThemeManager::getInstance().getThemeGeneration();
+    key.dpiPercent = static_cast<int>(GetDPIScaleFactor() * 100 + 0.5);
+    key.displayStyle = m_displayStyle;
+    key.buttonStyle = m_buttonStyle;
+    key.borderStyle = m_buttonBorderStyle;
+    key.state = state;
+    return key;
+}
+
+void FlatUIButtonBar::RenderStateBitmaps(const ButtonInfo& button)
+{
+    // Rendered at the origin with the regular builders, on the bar background so the blit can be opaque
+    ButtonInfo local = button;
+    local.rect = wxRect(button.rect.GetSize());
+    const ButtonState states[] = { ButtonState::NORMAL, ButtonState::HOVER, ButtonState::PRESSED };
+
+    for (ButtonState state : states) {
+        StateBitmapKey key = MakeStateBitmapKey(button, state);
+        if (m_stateBitmaps.Contains(key)) {
+            continue;
+        }
+
+        wxBitmap bitmap;
+        if (!bitmap.CreateScaled(local.rect.GetWidth(), local.rect.GetHeight(), wxBITMAP_SCREEN_DEPTH, GetContentScaleFactor())) {
+            return;
+        }
+        FlatUIDisplayList scratch;
+        {
+            FlatUIDisplayList::Builder builder = scratch.Rebuild(0);
+            BuildButtonPrimitives(builder, local, state == ButtonState::HOVER, state == ButtonState::PRESSED);
+        }
+        {
+            wxMemoryDC dc(bitmap);
+            dc.SetBackground(m_btnBarBgColour);
+            dc.Clear();
+            dc.SetFont(CFG_DEFAULTFONT());
+            IconAtlasPainter icons(dc);
+            scratch.Replay(dc, icons);
+        }
+        m_stateBitmaps.Put(key, bitmap);
     }
 }
 
-void FlatUIButtonBar::DrawButton(wxDC& dc, const ButtonInfo& button, int index)
+void FlatUIButtonBar::BuildButton(FlatUIDisplayList::Builder& out, const ButtonInfo& button, int index)
 {
     bool isHovered = m_hoverEffectsEnabled && index == m_hoveredButtonIndex;
     bool isPressed = button.pressed;
 
+    // A state change is a single blit of a pre-rendered bitmap
+    if (m_stateBitmapsEnabled && !button.rect.IsEmpty()) {
+        ButtonState state = isPressed ? ButtonState::PRESSED : isHovered ? ButtonState::HOVER : ButtonState::NORMAL;
+        StateBitmapKey key = MakeStateBitmapKey(button, state);
+        wxBitmap* bitmap = m_stateBitmaps.Find(key);
+        if (!bitmap) {
+            RenderStateBitmaps(button);
+            bitmap = m_stateBitmaps.Find(key);
+        }
+        if (bitmap && bitmap->IsOk()) {
+            out.Bitmap(*bitmap, button.rect.GetTopLeft());
+            return;
+        }
+    }
+
+    BuildButtonPrimitives(out, button, isHovered, isPressed);
+}
+
+void FlatUIButtonBar::BuildButtonPrimitives(FlatUIDisplayList::Builder& out, const ButtonInfo& button, bool isHovered, bool isPressed)
+{
     if (m_buttonStyle != ButtonStyle::GHOST || isHovered || isPressed) {
-        DrawButtonBackground(dc, button.rect, isHovered, isPressed);
+        BuildButtonBackground(out, button.rect, isHovered, isPressed);
     }
 
     if (m_buttonStyle == ButtonStyle::OUTLINED ||
         m_buttonStyle == ButtonStyle::RAISED ||
         (m_buttonStyle == ButtonStyle::DEFAULT && (isHovered || isPressed))) {
-        DrawButtonBorder(dc, button.rect, isHovered, isPressed);
+        BuildButtonBorder(out, button.rect, isHovered, isPressed);
     }
 
-    dc.SetTextForeground(m_buttonTextColour);
-    DrawButtonIcon(dc, button, button.rect);
-    DrawButtonText(dc, button, button.rect);
+    BuildButtonIcon(out, button, button.rect);
+    BuildButtonText(out, button, button.rect);
     if (button.isDropDown) {
-        DrawButtonSeparator(dc, button, button.rect); // Draw separator before arrow
-        DrawButtonDropdownArrow(dc, button, button.rect);
+        BuildButtonSeparator(out, button, button.rect); // Draw separator before arrow
+        BuildButtonDropdownArrow(out, button, button.rect);
     }
 }
 
-void FlatUIButtonBar::DrawButtonIcon(wxDC& dc, const ButtonInfo& button, const wxRect& rect)
+void FlatUIButtonBar::BuildButtonIcon(FlatUIDisplayList::Builder& out, const ButtonInfo& button, const wxRect& rect)
 {
     if (!button.icon.IsOk()) return;
 
-    int iconWidth = button.icon.GetWidth();
-    int iconHeight = button.icon.GetHeight();
+    int iconWidth = button.icon.GetSize().GetWidth();
+    int iconHeight = button.icon.GetSize().GetHeight();
     const int STANDARD_BUTTON_SIZE = 24;
 
     switch (m_displayStyle) {
@@ -289,7 +484,7 @@ void FlatUIButtonBar::DrawButtonIcon(wxDC& dc, const ButtonInfo& button, const w
         // Center the original-sized icon within the 24x24 button area
         int iconX = rect.GetLeft() + (STANDARD_BUTTON_SIZE - iconWidth) / 2;
         int iconY = rect.GetTop() + (STANDARD_BUTTON_SIZE - iconHeight) / 2;
-        dc.DrawBitmap(button.icon, iconX, iconY, true);
+        out.Icon(button.icon, wxPoint(iconX, iconY));
         break;
     }
     case ButtonDisplayStyle::ICON_TEXT_BELOW:
@@ -297,7 +492,7 @@ void FlatUIButtonBar::DrawButtonIcon(wxDC& dc, const ButtonInfo& button, const w
         // Center the icon horizontally within the button width
         int iconX = rect.GetLeft() + (rect.GetWidth() - iconWidth) / 2;
         int iconY = rect.GetTop() + CFG_INT("IconTextBelowTopMargin");
-        dc.DrawBitmap(button.icon, iconX, iconY, true);
+        out.Icon(button.icon, wxPoint(iconX, iconY));
         break;
     }
     case ButtonDisplayStyle::ICON_TEXT_BESIDE:
@@ -305,7 +500,7 @@ void FlatUIButtonBar::DrawButtonIcon(wxDC& dc, const ButtonInfo& button, const w
         // Center the icon within the 24px button area on the left
         int iconX = rect.GetLeft() + (STANDARD_BUTTON_SIZE - iconWidth) / 2;
         int iconY = rect.GetTop() + (rect.GetHeight() - iconHeight) / 2;
-        dc.DrawBitmap(button.icon, iconX, iconY, true);
+        out.Icon(button.icon, wxPoint(iconX, iconY));
         break;
     }
     default:
@@ -313,7 +508,7 @@ void FlatUIButtonBar::DrawButtonIcon(wxDC& dc, const ButtonInfo& button, const w
     }
 }
 
-void FlatUIButtonBar::DrawButtonText(wxDC& dc, const ButtonInfo& button, const wxRect& rect)
+void FlatUIButtonBar::BuildButtonText(FlatUIDisplayList::Builder& out, const ButtonInfo& button, const wxRect& rect)
 {
     if (button.label.empty()) return;
 
@@ -324,16 +519,16 @@ void FlatUIButtonBar::DrawButtonText(wxDC& dc, const ButtonInfo& button, const w
     {
         int textX = rect.GetLeft() + (rect.GetWidth() - button.textSize.GetWidth()) / 2;
         int textY = rect.GetTop() + (rect.GetHeight() - button.textSize.GetHeight()) / 2;
-        dc.DrawText(button.label, textX, textY);
+        out.Text(button.label, wxPoint(textX, textY), button.textSize, m_buttonTextColour);
         break;
     }
     case ButtonDisplayStyle::ICON_TEXT_BELOW:
     {
         int textX = rect.GetLeft() + (rect.GetWidth() - button.textSize.GetWidth()) / 2;
         int textY = rect.GetTop() + CFG_INT("IconTextBelowTopMargin") +
-            (button.icon.IsOk() ? button.icon.GetHeight() + CFG_INT("IconTextBelowSpacing") : 0);
+            (button.icon.IsOk() ? button.icon.GetSize().GetHeight() + CFG_INT("IconTextBelowSpacing") : 0);
         if (textY + button.textSize.GetHeight() <= rect.GetBottom()) {
-            dc.DrawText(button.label, textX, textY);
+            out.Text(button.label, wxPoint(textX, textY), button.textSize, m_buttonTextColour);
         }
         break;
     }
@@ -342,7 +537,7 @@ void FlatUIButtonBar::DrawButtonText(wxDC& dc, const ButtonInfo& button, const w
         // Text starts after the 24px button area
         int textX = rect.GetLeft() + STANDARD_BUTTON_SIZE + m_buttonHorizontalPadding;
         int textY = rect.GetTop() + (rect.GetHeight() - button.textSize.GetHeight()) / 2;
-        dc.DrawText(button.label, textX, textY);
+        out.Text(button.label, wxPoint(textX, textY), button.textSize, m_buttonTextColour);
         break;
     }
     default:
@@ -350,95 +545,76 @@ void FlatUIButtonBar::DrawButtonText(wxDC& dc, const ButtonInfo& button, const w
     }
 }
 
-void FlatUIButtonBar::DrawButtonDropdownArrow(wxDC& dc, const ButtonInfo& button, const wxRect& rect)
+void FlatUIButtonBar::BuildButtonDropdownArrow(FlatUIDisplayList::Builder& out, const ButtonInfo& button, const wxRect& rect)
 {
     int arrowX = rect.GetRight() - m_buttonHorizontalPadding - m_dropdownArrowWidth;
     int arrowY = rect.GetTop() + (rect.GetHeight() - m_dropdownArrowHeight) / 2;
-    wxPoint pts[3] = {
-        {arrowX, arrowY},
-        {arrowX + m_dropdownArrowWidth, arrowY},
-        {arrowX + m_dropdownArrowWidth / 2, arrowY + m_dropdownArrowHeight}
-    };
-    dc.SetBrush(wxBrush(m_buttonTextColour));
-    dc.SetPen(*wxTRANSPARENT_PEN);
-    dc.DrawPolygon(3, pts);
+    out.Triangle(wxPoint(arrowX, arrowY),
+        wxPoint(arrowX + m_dropdownArrowWidth, arrowY),
+        wxPoint(arrowX + m_dropdownArrowWidth / 2, arrowY + m_dropdownArrowHeight),
+        m_buttonTextColour);
 }
 
-void FlatUIButtonBar::DrawButtonSeparator(wxDC& dc, const ButtonInfo& button, const wxRect& rect)
+void FlatUIButtonBar::BuildButtonSeparator(FlatUIDisplayList::Builder& out, const ButtonInfo& button, const wxRect& rect)
 {
     int sepX = rect.GetRight() - m_buttonHorizontalPadding - m_dropdownArrowWidth
         - m_separatorPadding - m_separatorWidth;
     int topY = rect.GetTop() + m_separatorMargin;
     int botY = rect.GetBottom() - m_separatorMargin;
-    dc.SetPen(wxPen(m_buttonBorderColour, m_separatorWidth));
-    dc.DrawLine(sepX, topY, sepX, botY);
+    out.Line(wxPoint(sepX, topY), wxPoint(sepX, botY), m_buttonBorderColour, m_separatorWidth);
 }
 
-void FlatUIButtonBar::DrawButtonBackground(wxDC& dc, const wxRect& rect, bool isHovered, bool isPressed)
+void FlatUIButtonBar::BuildButtonBackground(FlatUIDisplayList::Builder& out, const wxRect& rect, bool isHovered, bool isPressed)
 {
     wxColour bgColour = isPressed && m_hoverEffectsEnabled ? m_buttonPressedBgColour :
         isHovered && m_hoverEffectsEnabled ? m_buttonHoverBgColour :
         m_buttonBgColour;
 
-    dc.SetBrush(wxBrush(bgColour));
-    dc.SetPen(*wxTRANSPARENT_PEN);
-
-    if (m_buttonStyle == ButtonStyle::PILL ||
-        (m_buttonBorderStyle == ButtonBorderStyle::ROUNDED && m_buttonCornerRadius > 0)) {
-        dc.DrawRoundedRectangle(rect, m_buttonCornerRadius);
-    }
-    else {
-        dc.DrawRectangle(rect);
-    }
+    bool rounded = m_buttonStyle == ButtonStyle::PILL ||
+        (m_buttonBorderStyle == ButtonBorderStyle::ROUNDED && m_buttonCornerRadius > 0);
+    out.FillRect(rect, bgColour, rounded ? m_buttonCornerRadius : 0);
 
     if (m_buttonStyle == ButtonStyle::RAISED && !isPressed) {
         wxColour shadowColour = bgColour.ChangeLightness(70);
-        dc.SetPen(wxPen(shadowColour, 1));
-        dc.DrawLine(rect.GetLeft() + 1, rect.GetBottom(), rect.GetRight(), rect.GetBottom());
-        dc.DrawLine(rect.GetRight(), rect.GetTop() + 1, rect.GetRight(), rect.GetBottom());
+        out.Line(wxPoint(rect.GetLeft() + 1, rect.GetBottom()), wxPoint(rect.GetRight(), rect.GetBottom()), shadowColour);
+        out.Line(wxPoint(rect.GetRight(), rect.GetTop() + 1), wxPoint(rect.GetRight(), rect.GetBottom()), shadowColour);
     }
 }
 
-void FlatUIButtonBar::DrawButtonBorder(wxDC& dc, const wxRect& rect, bool isHovered, bool isPressed)
+void FlatUIButtonBar::BuildButtonBorder(FlatUIDisplayList::Builder& out, const wxRect& rect, bool isHovered, bool isPressed)
 {
     wxColour borderColour = isHovered && m_hoverEffectsEnabled ? m_buttonBorderColour.ChangeLightness(80)
         : m_buttonBorderColour;
-    wxRect innerRect = rect;
 
+    wxPenStyle penStyle = wxPENSTYLE_SOLID;
     switch (m_buttonBorderStyle) {
-    case ButtonBorderStyle::SOLID:
-        dc.SetPen(wxPen(borderColour, m_buttonBorderWidth));
-        break;
     case ButtonBorderStyle::DASHED:
-        dc.SetPen(wxPen(borderColour, m_buttonBorderWidth, wxPENSTYLE_SHORT_DASH));
+        penStyle = wxPENSTYLE_SHORT_DASH;
         break;
     case ButtonBorderStyle::DOTTED:
-        dc.SetPen(wxPen(borderColour, m_buttonBorderWidth, wxPENSTYLE_DOT));
+        penStyle = wxPENSTYLE_DOT;
         break;
     case ButtonBorderStyle::DOUBLE:
-        dc.SetPen(wxPen(borderColour, 1));
-        dc.DrawRectangle(rect);
+    {
+        wxRect innerRect = rect;
         innerRect.Deflate(2);
-        dc.DrawRectangle(innerRect);
+        out.StrokeRect(rect, borderColour);
+        out.StrokeRect(innerRect, borderColour);
         return;
-    case ButtonBorderStyle::ROUNDED:
-        dc.SetPen(wxPen(borderColour, m_buttonBorderWidth));
+    }
+    default:
         break;
     }
 
-    dc.SetBrush(*wxTRANSPARENT_BRUSH);
-    if (m_buttonStyle == ButtonStyle::PILL ||
-        (m_buttonBorderStyle == ButtonBorderStyle::ROUNDED && m_buttonCornerRadius > 0)) {
-        dc.DrawRoundedRectangle(rect, m_buttonCornerRadius);
-    }
-    else {
-        dc.DrawRectangle(rect);
-    }
+    bool rounded = m_buttonStyle == ButtonStyle::PILL ||
+        (m_buttonBorderStyle == ButtonBorderStyle::ROUNDED && m_buttonCornerRadius > 0);
+    out.StrokeRect(rect, borderColour, m_buttonBorderWidth, penStyle, rounded ? m_buttonCornerRadius : 0);
 }
 
 void FlatUIButtonBar::OnMouseMove(wxMouseEvent& evt)
 {
     if (!m_hoverEffectsEnabled) return;
+    EnsureArranged();
 
     int oldHoveredIndex = m_hoveredButtonIndex;
     m_hoveredButtonIndex = -1;
@@ -452,20 +628,26 @@ void FlatUIButtonBar::OnMouseMove(wxMouseEvent& evt)
     }
 
     if (oldHoveredIndex != m_hoveredButtonIndex) {
-        Refresh();
+        m_displayList.Invalidate(oldHoveredIndex);
+        m_displayList.Invalidate(m_hoveredButtonIndex);
+        RefreshButton(oldHoveredIndex);
+        RefreshButton(m_hoveredButtonIndex);
     }
 }
 
 void FlatUIButtonBar::OnMouseLeave(wxMouseEvent& evt)
 {
     if (m_hoveredButtonIndex != -1) {
+        int oldHoveredIndex = m_hoveredButtonIndex;
         m_hoveredButtonIndex = -1;
-        Refresh();
+        m_displayList.Invalidate(oldHoveredIndex);
+        RefreshButton(oldHoveredIndex);
     }
 }
 
 void FlatUIButtonBar::OnMouseDown(wxMouseEvent& evt)
 {
+    EnsureArranged();
     wxPoint pos = evt.GetPosition();
 
     for (const auto& button : m_buttons) {
@@ -490,14 +672,15 @@ void FlatUIButtonBar::OnMouseDown(wxMouseEvent& evt)
 
 void FlatUIButtonBar::OnSize(wxSizeEvent& evt)
 {
-    RecalculateLayout();
+    // Button rects do not depend on the bar size; re-measuring here would feed back into the panel
+    Refresh();
 }
 
 void FlatUIButtonBar::SetButtonStyle(ButtonStyle style)
 {
     if (m_buttonStyle != style) {
         m_buttonStyle = style;
-        Refresh();
+        InvalidateButtonBitmaps();
     }
 }
 
@@ -505,50 +688,50 @@ void FlatUIButtonBar::SetButtonBorderStyle(ButtonBorderStyle style)
 {
     if (m_buttonBorderStyle != style) {
         m_buttonBorderStyle = style;
-        Refresh();
+        InvalidateButtonBitmaps();
     }
 }
 
 void FlatUIButtonBar::SetButtonBackgroundColour(const wxColour& colour)
 {
     m_buttonBgColour = colour;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetButtonHoverBackgroundColour(const wxColour& colour)
 {
     m_buttonHoverBgColour = colour;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetButtonPressedBackgroundColour(const wxColour& colour)
 {
     m_buttonPressedBgColour = colour;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetButtonTextColour(const wxColour& colour)
 {
     m_buttonTextColour = colour;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetButtonBorderColour(const wxColour& colour)
 {
     m_buttonBorderColour = colour;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetButtonBorderWidth(int width)
 {
     m_buttonBorderWidth = width;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetButtonCornerRadius(int radius)
 {
     m_buttonCornerRadius = radius;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetButtonSpacing(int spacing)
@@ -564,6 +747,7 @@ void FlatUIButtonBar::SetButtonPadding(int horizontal, int vertical)
     if (m_buttonHorizontalPadding != horizontal || m_buttonVerticalPadding != vertical) {
         m_buttonHorizontalPadding = horizontal;
         m_buttonVerticalPadding = vertical;
+        m_stateBitmaps.Clear();
         RecalculateLayout();
     }
 }
@@ -577,19 +761,19 @@ void FlatUIButtonBar::GetButtonPadding(int& horizontal, int& vertical) const
 void FlatUIButtonBar::SetBtnBarBackgroundColour(const wxColour& colour)
 {
     m_btnBarBgColour = colour;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetBtnBarBorderColour(const wxColour& colour)
 {
     m_btnBarBorderColour = colour;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetBtnBarBorderWidth(int width)
 {
     m_btnBarBorderWidth = width;
-    Refresh();
+    InvalidateButtonBitmaps();
 }
 
 void FlatUIButtonBar::SetHoverEffectsEnabled(bool enabled)
@@ -597,6 +781,6 @@ void FlatUIButtonBar::SetHoverEffectsEnabled(bool enabled)
     if (m_hoverEffectsEnabled != enabled) {
         m_hoverEffectsEnabled = enabled;
         m_hoveredButtonIndex = -1;
-        Refresh();
+        InvalidateButtonBitmaps();
     }
 }
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "flatui/FlatUIDisplayList.h"
+#include "flatui/FlatUIResourcePool.h"
+
+FlatUIDisplayList::Command& FlatUIDisplayList::Builder::Append(Command::Type type, const wxRect& area)
+{
+    m_bounds = m_bounds.IsEmpty() ? area : m_bounds.Union(area);
+    m_commands.emplace_back();
+    Command& command = m_commands.back();
+    command.type = type;
+    return command;
+}
+
+void FlatUIDisplayList::Builder::FillRect(const wxRect& rect, const wxColour& colour, int radius)
+{
+    Command& command = Append(Command::Type::FILL_RECT, rect);
+    command.rect = rect;
+    command.colour = colour;
+    command.radius = radius;
+}
+
+void FlatUIDisplayList::Builder::StrokeRect(const wxRect& rect, const wxColour& colour, int width,
+                                            wxPenStyle style, int radius)
+{
+    // Wide pens are centred on the outline
+    Command& command = Append(Command::Type::STROKE_RECT, wxRect(rect).Inflate(width / 2 + 1));
+    command.rect = rect;
+    command.colour = colour;
+    command.width = width;
+    command.penStyle = style;
+    command.radius = radius;
+}
+
+void FlatUIDisplayList::Builder::Line(const wxPoint& from, const wxPoint& to, const wxColour& colour, int width)
+{
+    Command& command = Append(Command::Type::LINE, wxRect(from, to).Inflate(width / 2 + 1));
+    command.points[0] = from;
+    command.points[1] = to;
+    command.colour = colour;
+    command.width = width;
+}
+
+void FlatUIDisplayList::Builder::Triangle(const wxPoint& a, const wxPoint& b, const wxPoint& c, const wxColour& colour)
+{
+    wxRect area = wxRect(a, b).Union(wxRect(c, c));
+    Command& command = Append(Command::Type::TRIANGLE, area.Inflate(1));
+    command.points[0] = a;
+    command.points[1] = b;
+    command.points[2] = c;
+    command.colour = colour;
+}
+
+void FlatUIDisplayList::Builder::Text(const wxString& text, const wxPoint& origin, const wxSize& extent, const wxColour& colour)
+{
+    Command& command = Append(Command::Type::TEXT, wxRect(origin, extent));
+    command.rect = wxRect(origin, extent);
+    command.text = text;
+    command.colour = colour;
+}
+
+void FlatUIDisplayList::Builder::Icon(const IconAtlasHandle& icon, const wxPoint& origin)
+{
+    Command& command = Append(Command::Type::ICON, wxRect(origin, icon.GetSize()));
+    command.rect = wxRect(origin, icon.GetSize());
+    command.icon = icon;
+}
+
+void FlatUIDisplayList::Builder::Bitmap(const wxBitmap& bitmap, const wxPoint& origin)
+{
+    Command& command = Append(Command::Type::BITMAP, wxRect(origin, bitmap.GetScaledSize()));
+    command.rect = wxRect(origin, bitmap.GetScaledSize());
+    command.bitmap = bitmap;
+}
+
+void FlatUIDisplayList::Reset(size_t segmentCount)
+{
+    m_segments.clear();
+    m_segments.resize(segmentCount);
+}
+
+void FlatUIDisplayList::Invalidate()
+{
+    for (auto& segment : m_segments) {
+        segment.dirty = true;
+    }
+}
+
+void FlatUIDisplayList::Invalidate(size_t segment)
+{
+    if (segment < m_segments.size()) {
+        m_segments[segment].dirty = true;
+    }
+}
+
+bool FlatUIDisplayList::IsDirty(size_t segment) const
+{
+    return segment >= m_segments.size() || m_segments[segment].dirty;
+}
+
+FlatUIDisplayList::Builder FlatUIDisplayList::Rebuild(size_t segment)
+{
+    if (segment >= m_segments.size()) {
+        m_segments.resize(segment + 1);
+    }
+    Segment& target = m_segments[segment];
+    target.commands.clear();
+    target.bounds = wxRect();
+    target.dirty = false;
+    ++m_rebuildCount;
+    return Builder(target.commands, target.bounds);
+}
+
+wxRect FlatUIDisplayList::GetSegmentBounds(size_t segment) const
+{
+    return segment < m_segments.size() ? m_segments[segment].bounds : wxRect();
+}
+
+void FlatUIDisplayList::Replay(wxDC& dc, IconAtlasPainter& icons) const
+{
+    for (const auto& segment : m_segments) {
+        for (const auto& command : segment.commands) {
+            ReplayCommand(dc, icons, command);
+        }
+    }
+}
+
+size_t FlatUIDisplayList::Replay(wxDC& dc, IconAtlasPainter& icons, const wxRegion& damage) const
+{
+    size_t drawn = 0;
+    for (const auto& segment : m_segments) {
+        if (segment.commands.empty() || damage.Contains(segment.bounds) == wxOutRegion) {
+            continue;
+        }
+        for (const auto& command : segment.commands) {
+            ReplayCommand(dc, icons, command);
+        }
+        ++drawn;
+    }
+    return drawn;
+}
+
+size_t FlatUIDisplayList::GetCommandCount() const
+{
+    size_t count = 0;
+    for (const auto& segment : m_segments) {
+        count += segment.commands.size();
+    }
+    return count;
+}
+
+void FlatUIDisplayList::ReplayCommand(wxDC& dc, IconAtlasPainter& icons, const Command& command)
+{
+    FlatUIResourcePool& pool = FlatUIResourcePool::GetInstance();
+    switch (command.type) {
+    case Command::Type::FILL_RECT:
+        dc.SetBrush(pool.GetBrush(command.colour));
+        dc.SetPen(*wxTRANSPARENT_PEN);
+        if (command.radius > 0) {
+            dc.DrawRoundedRectangle(command.rect, command.radius);
+        }
+        else {
+            dc.DrawRectangle(command.rect);
+        }
+        break;
+    case Command::Type::STROKE_RECT:
+        dc.SetPen(pool.GetPen(command.colour, command.width, command.penStyle));
+        dc.SetBrush(*wxTRANSPARENT_BRUSH);
+        if (command.radius > 0) {
+            dc.DrawRoundedRectangle(command.rect, command.radius);
+        }
+        else {
+            dc.DrawRectangle(command.rect);
+        }
+        break;
+    case Command::Type::LINE:
+        dc.SetPen(pool.GetPen(command.colour, command.width));
+        dc.DrawLine(command.points[0], command.points[1]);
+        break;
+    case Command::Type::TRIANGLE:
+        dc.SetBrush(pool.GetBrush(command.colour));
+        dc.SetPen(*wxTRANSPARENT_PEN);
+        dc.DrawPolygon(3, command.points);
+        break;
+    case Command::Type::TEXT:
+        dc.SetTextForeground(command.colour);
+        dc.DrawText(command.text, command.rect.GetTopLeft());
+        break;
+    case Command::Type::ICON:
+        icons.Draw(command.icon, command.rect.x, command.rect.y);
+        break;
+    case Command::Type::BITMAP:
+        dc.DrawBitmap(command.bitmap, command.rect.x, command.rect.y, false);
+        break;
+    }
+}
@@ -16,6 +16,7 @@ wxEND_EVENT_TABLE()
 
 FlatUIFixPanel::FlatUIFixPanel(wxWindow* parent, wxWindowID id)
     : wxPanel(parent, id, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE),
+    FlatUILayoutNode(this),
     m_activePageIndex(wxNOT_FOUND),
     m_unpinButton(nullptr),
     m_scrollingEnabled(false),
@@ -225,26 +226,46 @@ void FlatUIFixPanel::UpdateLayout()
 }
 
 void FlatUIFixPanel::RecalculateSize()
+{
+    InvalidateMeasure();
+}
+
+wxSize FlatUIFixPanel::MeasureOverride() const
 {
     if (m_pages.empty()) {
-        SetMinSize(wxSize(100, 60));
-        return;
+        return wxSize(100, 60);
     }
 
     // Calculate the maximum size needed by any page
     wxSize maxSize(0, 0);
     for (auto* page : m_pages) {
         if (page) {
-            wxSize pageSize = page->GetBestSize();
+            wxSize pageSize = page->Measure();
             maxSize.SetWidth(wxMax(maxSize.GetWidth(), pageSize.GetWidth()));
             maxSize.SetHeight(wxMax(maxSize.GetHeight(), pageSize.GetHeight()));
         }
     }
+    return maxSize;
+}
 
-    SetMinSize(maxSize);
-    LOG_INF("RecalculateSize: FixPanel size set to (" + 
-           std::to_string(maxSize.GetWidth()) + "," + 
-           std::to_string(maxSize.GetHeight()) + ")", "FlatUIFixPanel");
+void FlatUIFixPanel::ArrangeOverride(const wxSize& measured)
+{
+    SetMinSize(measured);
+    LOG_DBG("RecalculateSize: FixPanel size set to (" + 
+           std::to_string(measured.GetWidth()) + "," + 
+           std::to_string(measured.GetHeight()) + ")", "FlatUIFixPanel");
+
+    // Pages were arranged first, so the active page is positioned with its final size
+    UpdateLayout();
+}
+
+void FlatUIFixPanel::GetLayoutChildren(std::vector<FlatUILayoutNode*>& children) const
+{
+    for (auto* page : m_pages) {
+        if (page) {
+            children.push_back(page);
+        }
+    }
 }
 
 void FlatUIFixPanel::ShowUnpinButton(bool show)
@@ -261,21 +282,7 @@ void FlatUIFixPanel::ShowUnpinButton(bool show)
 
 wxSize FlatUIFixPanel::DoGetBestSize() const
 {
-    if (m_pages.empty()) {
-        return wxSize(100, 60);
-    }
-
-    // Return the size of the largest page
-    wxSize maxSize(0, 0);
-    for (const auto* page : m_pages) {
-        if (page) {
-            wxSize pageSize = page->GetBestSize();
-            maxSize.SetWidth(wxMax(maxSize.GetWidth(), pageSize.GetWidth()));
-            maxSize.SetHeight(wxMax(maxSize.GetHeight(), pageSize.GetHeight()));
-        }
-    }
-
-    return maxSize;
+    return Measure();
 }
 
 void FlatUIFixPanel::OnSize(wxSizeEvent& event)
@@ -446,6 +453,7 @@ void FlatUIFixPanel::ClearContent()
     
     // Clear the pages vector (pages are owned by their original creators)
     m_pages.clear();
+    RecalculateSize();
     
     // Reset active page index
     m_activePageIndex = wxNOT_FOUND;
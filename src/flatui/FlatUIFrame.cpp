@@ -29,10 +29,21 @@ FlatUIFrame::FlatUIFrame(wxWindow* parent, wxWindowID id, const wxString& title,
       // m_dragging, m_resizing, m_resizeMode, m_rubberBandVisible, m_borderThreshold are initialized by BorderlessFrameLogic
 {
     InitFrameStyle(); // Specific styling for FlatUIFrame
+
+    // Ribbon controls repaint through their own subscriptions; the frame only tracks its
+    // workspace colour, which RefreshAllUI has already applied on a regular switch
+    ThemeManager::getInstance().addThemeChangeListener(this, { THEME_KEY("FrameAppWorkspaceColour") }, [this]() {
+        wxColour workspace = CFG_COLOUR("FrameAppWorkspaceColour");
+        if (workspace != GetBackgroundColour()) {
+            SetBackgroundColour(workspace);
+            Refresh();
+        }
+    });
 }
 
 FlatUIFrame::~FlatUIFrame()
 {
+    ThemeManager::getInstance().removeThemeChangeListener(this);
     wxLogDebug("FlatUIFrame destruction started.");
     wxLogDebug("FlatUIFrame destruction completed.");
 }
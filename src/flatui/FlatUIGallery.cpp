@@ -1,13 +1,17 @@
 #include "flatui/FlatUIGallery.h"
 #include "flatui/FlatUIPanel.h"
 #include "flatui/FlatUIEventManager.h"
+#include "flatui/FlatUIBarPerformanceManager.h"
 #include "logger/Logger.h"
 #include <wx/dcbuffer.h>
 #include <wx/graphics.h>
 #include "config/ThemeManager.h"
+#include "flatui/FlatUIResourcePool.h"
+#include "config/SvgIconManager.h"
 
 FlatUIGallery::FlatUIGallery(FlatUIPanel* parent)
     : wxControl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE),
+    FlatUILayoutNode(this),
     m_itemStyle(ItemStyle::DEFAULT),
     m_itemBorderStyle(ItemBorderStyle::SOLID),
     m_layoutStyle(LayoutStyle::HORIZONTAL),
@@ -23,15 +27,14 @@ FlatUIGallery::FlatUIGallery(FlatUIPanel* parent)
     m_hoverEffectsEnabled(true),
     m_selectionEnabled(true),
     m_hasDropdown(false),
-    m_dropdownWidth(0)
+    m_dropdownWidth(0),
+    m_themeSubscription([this]() { LoadThemeValues(); RefreshItems(); }),
+    m_layoutSubscription([this]() { LoadThemeValues(); InvalidateMeasure(); })
 {
     SetDoubleBuffered(true);
     SetBackgroundStyle(wxBG_STYLE_PAINT);
 
-    m_galleryBgColour     = CFG_COLOUR("ActBarBackgroundColour");
-    m_galleryBorderColour = CFG_COLOUR("ActBarBackgroundColour");
-    m_itemSpacing         = CFG_INT("GalleryItemSpacing");
-    m_itemPadding         = CFG_INT("GalleryItemPadding");
+    LoadThemeValues();
     int targetH           = CFG_INT("GalleryTargetHeight");
     int horizMargin       = CFG_INT("GalleryHorizontalMargin");
     int galleryVerticalPadding = CFG_INT("GalleryInternalVerticalPadding");
@@ -48,53 +51,55 @@ FlatUIGallery::~FlatUIGallery()
 {
 }
 
+void FlatUIGallery::LoadThemeValues()
+{
+    // Keys read here are recorded, so the subscriptions always match what is cached
+    {
+        ThemeSubscription::Recorder themeKeys(m_themeSubscription);
+        m_itemBgColour         = CFG_COLOUR("GalleryItemBgColour");
+        m_itemHoverBgColour    = CFG_COLOUR("GalleryItemHoverBgColour");
+        m_itemSelectedBgColour = CFG_COLOUR("GalleryItemSelectedBgColour");
+        m_itemBorderColour     = CFG_COLOUR("GalleryItemBorderColour");
+        m_galleryBgColour      = CFG_COLOUR("ActBarBackgroundColour");
+        m_galleryBorderColour  = CFG_COLOUR("ActBarBackgroundColour");
+    }
+
+    ThemeSubscription::Recorder layoutKeys(m_layoutSubscription);
+    m_itemSpacing          = CFG_INT("GalleryItemSpacing");
+    m_itemPadding          = CFG_INT("GalleryItemPadding");
+}
+
 void FlatUIGallery::AddItem(const wxBitmap& bitmap, int id)
 {
-    Freeze();
     ItemInfo info;
-    info.bitmap = bitmap;
+    info.icon = SvgIconManager::GetInstance().PackBitmap(bitmap);
     info.id = id;
     info.hovered = false;
     info.selected = false;
     m_items.push_back(info);
 
-    // Best size is now determined by DoGetBestSize.
-    // We just need to inform the layout system that our best size might have changed.
-    InvalidateBestSize();
-
-    wxWindow* parent = GetParent();
-    if (parent) {
-        // It's usually better to let the panel manage its own updates if needed.
-        // panel->UpdatePanelSize(); might still be relevant if panel's size depends on gallery's exact new width.
-        FlatUIPanel* panel = dynamic_cast<FlatUIPanel*>(parent);
-        if (panel) {
-            panel->UpdatePanelSize(); // This will re-query gallery's best size.
-        }
-        // Alternatively, or in addition, a simple Layout() on parent might suffice if parent is a sizer window.
-        // parent->Layout(); 
-    }
-
-    Refresh(); // Refresh this gallery control
-    Thaw();
+    // Item rects and the panel size are updated together in the next layout pass
+    InvalidateMeasure();
 
-    // Optional: Log the new best size for debugging
-    wxSize bestSize = GetBestSize();
-    LOG_INF("Added item to FlatUIGallery, new best size: " +
-        std::to_string(bestSize.GetWidth()) + "x" +
-        std::to_string(bestSize.GetHeight()), "FlatUIGallery");
+    LOG_DBG("Added item to FlatUIGallery, " + std::to_string(m_items.size()) + " items", "FlatUIGallery");
 }
 
 wxSize FlatUIGallery::DoGetBestSize() const
 {
-    wxSize size;
+    return Measure();
+}
+
+wxSize FlatUIGallery::MeasureOverride() const
+{
+    ThemeSubscription::Recorder layoutKeys(m_layoutSubscription);
     int horizMargin = CFG_INT("GalleryHorizontalMargin");
     int totalWidth = horizMargin;
     bool hasItems = false;
     int itemCount = 0;
     for (const auto& item : m_items) {
-        if (item.bitmap.IsOk()) {
+        if (item.icon.IsOk()) {
             hasItems = true;
-            int itemWidth = item.bitmap.GetWidth() + 2 * m_itemPadding;
+            int itemWidth = item.icon.GetSize().GetWidth() + 2 * m_itemPadding;
             if (itemCount > 0) {
                 totalWidth += m_itemSpacing;
             }
@@ -112,10 +117,36 @@ wxSize FlatUIGallery::DoGetBestSize() const
     return wxSize(totalWidth, totalHeight);
 }
 
+void FlatUIGallery::ArrangeOverride(const wxSize& measured)
+{
+    ThemeSubscription::Recorder layoutKeys(m_layoutSubscription);
+    if (GetMinSize() != measured) {
+        SetMinSize(measured);
+    }
+    RecalculateLayout();
+}
+
 void FlatUIGallery::RecalculateLayout()
 {
-    // Layout recalculation will be done in OnPaint for now
-    // In future, this could pre-calculate item positions
+    int x = CFG_INT("GalleryHorizontalMargin");
+    int y = CFG_INT("GalleryVerticalMargin");
+    for (auto& item : m_items) {
+        if (item.icon.IsOk()) {
+            int itemWidth = item.icon.GetSize().GetWidth() + 2 * m_itemPadding;
+            int itemHeight = item.icon.GetSize().GetHeight() + 2 * m_itemPadding;
+            item.rect = wxRect(x, y, itemWidth, itemHeight);
+            x += itemWidth + m_itemSpacing;
+        }
+        else {
+            item.rect = wxRect();
+        }
+    }
+    RefreshItems();
+}
+
+void FlatUIGallery::RefreshItems()
+{
+    m_displayList.Invalidate();
     Refresh();
 }
 
@@ -127,6 +158,7 @@ void FlatUIGallery::OnSize(wxSizeEvent& evt)
 
 void FlatUIGallery::OnPaint(wxPaintEvent& evt)
 {
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
     wxAutoBufferedPaintDC dc(this);
     wxSize size = GetSize();
 
@@ -135,7 +167,7 @@ void FlatUIGallery::OnPaint(wxPaintEvent& evt)
 
     // Draw gallery border if configured
     if (m_galleryBorderWidth > 0) {
-        dc.SetPen(wxPen(m_galleryBorderColour, m_galleryBorderWidth));
+        dc.SetPen(FlatUIResourcePool::GetInstance().GetPen(m_galleryBorderColour, m_galleryBorderWidth));
         dc.SetBrush(*wxTRANSPARENT_BRUSH);
         dc.DrawRectangle(0, 0, size.GetWidth(), size.GetHeight());
     }
@@ -151,34 +183,43 @@ void FlatUIGallery::OnPaint(wxPaintEvent& evt)
         return;
     }
 
-    int x = CFG_INT("GalleryHorizontalMargin");
-    int y = CFG_INT("GalleryVerticalMargin");
-
+    // Item rects come from RecalculateLayout; only invalidated items are regenerated
+    if (m_displayList.GetSegmentCount() != m_items.size()) {
+        m_displayList.Reset(m_items.size());
+    }
     for (size_t i = 0; i < m_items.size(); ++i) {
-        auto& item = m_items[i];
-        if (item.bitmap.IsOk()) {
-            int itemWidth = item.bitmap.GetWidth() + 2 * m_itemPadding;
-            int itemHeight = item.bitmap.GetHeight() + 2 * m_itemPadding;
-
-            // Calculate actual y position for this specific item (top-aligned)
-            int item_y = CFG_INT("GalleryVerticalMargin");
-
-            // Update item rect for hit testing
-            item.rect = wxRect(x, item_y, itemWidth, itemHeight);
-
-            // Draw item
-            DrawItem(dc, item, i);
-
-            x += itemWidth + m_itemSpacing;
+        if (m_displayList.IsDirty(i)) {
+            FlatUIDisplayList::Builder builder = m_displayList.Rebuild(i);
+            if (m_items[i].icon.IsOk()) {
+                BuildItem(builder, m_items[i], i);
+            }
         }
     }
 
-    // LOG_DBG("FlatUIGallery OnPaint - Size: " +
-    //     std::to_string(size.GetWidth()) + "x" +
-    //     std::to_string(size.GetHeight()), "FlatUIGallery");
+    // Hover and selection changes invalidate single items; skip everything outside the damage
+    wxRegion damage = GetUpdateRegion();
+    IconAtlasPainter icons(dc);
+    size_t drawn = m_displayList.Replay(dc, icons, damage);
+    if (FlatUIBarPerformanceManager* perf = FlatUIBarPerformanceManager::FromWindow(this)) {
+        perf->RecordRepaint(this, damage, drawn, m_items.size() - drawn);
+    }
+}
+
+void FlatUIGallery::RefreshItem(int index)
+{
+    if (index < 0 || index >= static_cast<int>(m_items.size())) {
+        return;
+    }
+    // Covers the SHADOWED offset and wide border pens of the old and new commands
+    wxRect damage = wxRect(m_items[index].rect).Inflate(m_itemBorderWidth / 2 + 2);
+    wxRect previous = m_displayList.GetSegmentBounds(index);
+    if (!previous.IsEmpty()) {
+        damage.Union(previous);
+    }
+    FlatUIBarPerformanceManager::RefreshWindowRect(this, damage);
 }
 
-void FlatUIGallery::DrawItem(wxDC& dc, const ItemInfo& item, int index)
+void FlatUIGallery::BuildItem(FlatUIDisplayList::Builder& out, const ItemInfo& item, int index)
 {
     wxRect itemRect = item.rect;
     bool isHovered = (m_hoverEffectsEnabled && index == m_hoveredItem);
@@ -186,36 +227,32 @@ void FlatUIGallery::DrawItem(wxDC& dc, const ItemInfo& item, int index)
 
     // Draw item background
     if (m_itemStyle != ItemStyle::DEFAULT || isHovered || isSelected) {
-        DrawItemBackground(dc, itemRect, isHovered, isSelected);
+        BuildItemBackground(out, itemRect, isHovered, isSelected);
     }
 
     // Draw item border
     if (m_itemStyle == ItemStyle::BORDERED ||
         m_itemStyle == ItemStyle::ROUNDED ||
         (m_itemStyle == ItemStyle::DEFAULT && (isHovered || isSelected))) {
-        DrawItemBorder(dc, itemRect, isHovered, isSelected);
+        BuildItemBorder(out, itemRect, isHovered, isSelected);
     }
 
     // Draw shadow for SHADOWED style
     if (m_itemStyle == ItemStyle::SHADOWED) {
         wxColour shadowColour = m_galleryBgColour.ChangeLightness(85);
-        dc.SetPen(wxPen(shadowColour, 1));
-        dc.SetBrush(*wxTRANSPARENT_BRUSH);
-        dc.DrawLine(itemRect.GetLeft() + 2, itemRect.GetBottom() + 1,
-            itemRect.GetRight() + 1, itemRect.GetBottom() + 1);
-        dc.DrawLine(itemRect.GetRight() + 1, itemRect.GetTop() + 2,
-            itemRect.GetRight() + 1, itemRect.GetBottom() + 1);
+        out.Line(wxPoint(itemRect.GetLeft() + 2, itemRect.GetBottom() + 1),
+            wxPoint(itemRect.GetRight() + 1, itemRect.GetBottom() + 1), shadowColour);
+        out.Line(wxPoint(itemRect.GetRight() + 1, itemRect.GetTop() + 2),
+            wxPoint(itemRect.GetRight() + 1, itemRect.GetBottom() + 1), shadowColour);
     }
 
     // Draw the bitmap
-    if (item.bitmap.IsOk()) {
-        int bitmapX = itemRect.GetLeft() + m_itemPadding;
-        int bitmapY = itemRect.GetTop() + m_itemPadding;
-        dc.DrawBitmap(item.bitmap, bitmapX, bitmapY, true);
+    if (item.icon.IsOk()) {
+        out.Icon(item.icon, wxPoint(itemRect.GetLeft() + m_itemPadding, itemRect.GetTop() + m_itemPadding));
     }
 }
 
-void FlatUIGallery::DrawItemBackground(wxDC& dc, const wxRect& rect, bool isHovered, bool isSelected)
+void FlatUIGallery::BuildItemBackground(FlatUIDisplayList::Builder& out, const wxRect& rect, bool isHovered, bool isSelected)
 {
     wxColour bgColour = m_itemBgColour;
     if (isSelected) {
@@ -225,63 +262,47 @@ void FlatUIGallery::DrawItemBackground(wxDC& dc, const wxRect& rect, bool isHove
         bgColour = m_itemHoverBgColour;
     }
 
-    dc.SetBrush(wxBrush(bgColour));
-    dc.SetPen(*wxTRANSPARENT_PEN);
-
-    if (m_itemStyle == ItemStyle::ROUNDED || m_itemCornerRadius > 0) {
-        dc.DrawRoundedRectangle(rect, m_itemCornerRadius);
-    }
-    else {
-        dc.DrawRectangle(rect);
-    }
+    bool rounded = m_itemStyle == ItemStyle::ROUNDED || m_itemCornerRadius > 0;
+    out.FillRect(rect, bgColour, rounded ? m_itemCornerRadius : 0);
 }
 
-void FlatUIGallery::DrawItemBorder(wxDC& dc, const wxRect& rect, bool isHovered, bool isSelected)
+void FlatUIGallery::BuildItemBorder(FlatUIDisplayList::Builder& out, const wxRect& rect, bool isHovered, bool isSelected)
 {
     wxColour borderColour = m_itemBorderColour;
     if ((isHovered || isSelected) && m_hoverEffectsEnabled) {
         borderColour = borderColour.ChangeLightness(80);
     }
 
+    wxPenStyle penStyle = wxPENSTYLE_SOLID;
     switch (m_itemBorderStyle) {
-    case ItemBorderStyle::SOLID:
-        dc.SetPen(wxPen(borderColour, m_itemBorderWidth));
-        break;
     case ItemBorderStyle::DASHED:
-        dc.SetPen(wxPen(borderColour, m_itemBorderWidth, wxPENSTYLE_SHORT_DASH));
+        penStyle = wxPENSTYLE_SHORT_DASH;
         break;
     case ItemBorderStyle::DOTTED:
-        dc.SetPen(wxPen(borderColour, m_itemBorderWidth, wxPENSTYLE_DOT));
+        penStyle = wxPENSTYLE_DOT;
         break;
     case ItemBorderStyle::DOUBLE:
     {
         // Draw double border
-        dc.SetPen(wxPen(borderColour, 1));
-        dc.DrawRectangle(rect);
         wxRect innerRect = rect;
         innerRect.Deflate(2);
-        dc.DrawRectangle(innerRect);
+        out.StrokeRect(rect, borderColour);
+        out.StrokeRect(innerRect, borderColour);
         return;
     }
-    case ItemBorderStyle::ROUNDED:
-        dc.SetPen(wxPen(borderColour, m_itemBorderWidth));
+    default:
         break;
     }
 
-    dc.SetBrush(*wxTRANSPARENT_BRUSH);
-
-    if (m_itemStyle == ItemStyle::ROUNDED ||
+    bool rounded = m_itemStyle == ItemStyle::ROUNDED ||
         m_itemBorderStyle == ItemBorderStyle::ROUNDED ||
-        m_itemCornerRadius > 0) {
-        dc.DrawRoundedRectangle(rect, m_itemCornerRadius);
-    }
-    else {
-        dc.DrawRectangle(rect);
-    }
+        m_itemCornerRadius > 0;
+    out.StrokeRect(rect, borderColour, m_itemBorderWidth, penStyle, rounded ? m_itemCornerRadius : 0);
 }
 
 void FlatUIGallery::OnMouseDown(wxMouseEvent& evt)
 {
+    EnsureArranged();
     wxPoint pos = evt.GetPosition();
     LOG_INF("Mouse down event in FlatUIGallery at position: (" +
         std::to_string(pos.x) + ", " + std::to_string(pos.y) + ")", "FlatUIGallery");
@@ -312,6 +333,7 @@ void FlatUIGallery::OnMouseMove(wxMouseEvent& evt)
         return;
     }
 
+    EnsureArranged();
     wxPoint pos = evt.GetPosition();
     int oldHoveredItem = m_hoveredItem;
     m_hoveredItem = -1;
@@ -324,7 +346,10 @@ void FlatUIGallery::OnMouseMove(wxMouseEvent& evt)
     }
 
     if (oldHoveredItem != m_hoveredItem) {
-        Refresh();
+        m_displayList.Invalidate(oldHoveredItem);
+        m_displayList.Invalidate(m_hoveredItem);
+        RefreshItem(oldHoveredItem);
+        RefreshItem(m_hoveredItem);
     }
 
     evt.Skip();
@@ -333,8 +358,10 @@ void FlatUIGallery::OnMouseMove(wxMouseEvent& evt)
 void FlatUIGallery::OnMouseLeave(wxMouseEvent& evt)
 {
     if (m_hoveredItem != -1) {
+        int oldHoveredItem = m_hoveredItem;
         m_hoveredItem = -1;
-        Refresh();
+        m_displayList.Invalidate(oldHoveredItem);
+        RefreshItem(oldHoveredItem);
     }
     evt.Skip();
 }
@@ -344,7 +371,7 @@ void FlatUIGallery::SetItemStyle(ItemStyle style)
 {
     if (m_itemStyle != style) {
         m_itemStyle = style;
-        Refresh();
+        RefreshItems();
     }
 }
 
@@ -352,7 +379,7 @@ void FlatUIGallery::SetItemBorderStyle(ItemBorderStyle style)
 {
     if (m_itemBorderStyle != style) {
         m_itemBorderStyle = style;
-        Refresh();
+        RefreshItems();
     }
 }
 
@@ -367,64 +394,63 @@ void FlatUIGallery::SetLayoutStyle(LayoutStyle style)
 void FlatUIGallery::SetItemBackgroundColour(const wxColour& colour)
 {
     m_itemBgColour = colour;
-    Refresh();
+    RefreshItems();
 }
 
 void FlatUIGallery::SetItemHoverBackgroundColour(const wxColour& colour)
 {
     m_itemHoverBgColour = colour;
-    Refresh();
+    RefreshItems();
 }
 
 void FlatUIGallery::SetItemSelectedBackgroundColour(const wxColour& colour)
 {
     m_itemSelectedBgColour = colour;
-    Refresh();
+    RefreshItems();
 }
 
 void FlatUIGallery::SetItemBorderColour(const wxColour& colour)
 {
     m_itemBorderColour = colour;
-    Refresh();
+    RefreshItems();
 }
 
 void FlatUIGallery::SetItemBorderWidth(int width)
 {
     m_itemBorderWidth = width;
-    Refresh();
+    RefreshItems();
 }
 
 void FlatUIGallery::SetItemCornerRadius(int radius)
 {
     m_itemCornerRadius = radius;
-    Refresh();
+    RefreshItems();
 }
 
 void FlatUIGallery::SetItemPadding(int padding)
 {
     if (m_itemPadding != padding) {
         m_itemPadding = padding;
-        InvalidateBestSize();
-        RecalculateLayout();
+        InvalidateMeasure();
     }
 }
 
 void FlatUIGallery::SetGalleryBackgroundColour(const wxColour& colour)
 {
     m_galleryBgColour = colour;
-    Refresh();
+    RefreshItems();
 }
 
 void FlatUIGallery::SetGalleryBorderColour(const wxColour& colour)
 {
     m_galleryBorderColour = colour;
-    Refresh();
+    RefreshItems();
 }
 
 void FlatUIGallery::SetGalleryBorderWidth(int width)
 {
     m_galleryBorderWidth = width;
-    Refresh();
+    RefreshItems();
 }
 
 void FlatUIGallery::SetSelectedItem(int index)
@@ -437,15 +463,17 @@ void FlatUIGallery::SetSelectedItem(int index)
         // Clear old selection
         if (m_selectedItem >= 0 && m_selectedItem < static_cast<int>(m_items.size())) {
             m_items[m_selectedItem].selected = false;
+            m_displayList.Invalidate(m_selectedItem);
+            RefreshItem(m_selectedItem);
         }
 
         // Set new selection
         m_selectedItem = index;
         if (m_selectedItem >= 0) {
             m_items[m_selectedItem].selected = true;
+            m_displayList.Invalidate(m_selectedItem);
+            RefreshItem(m_selectedItem);
         }
-
-        Refresh();
     }
 }
 
@@ -454,7 +482,7 @@ void FlatUIGallery::SetHoverEffectsEnabled(bool enabled)
     if (m_hoverEffectsEnabled != enabled) {
         m_hoverEffectsEnabled = enabled;
         m_hoveredItem = -1;
-        Refresh();
+        RefreshItems();
     }
 }
 
@@ -468,6 +496,6 @@ void FlatUIGallery::SetSelectionEnabled(bool enabled)
                 item.selected = false;
             }
         }
-        Refresh();
+        RefreshItems();
     }
 }
\ No newline at end of file
@@ -314,6 +314,13 @@ void FlatUIHomeMenu::ShowThemeSubmenu(wxWindow* parentItem)
     std::vector<std::string> themes = themeManager.getAvailableThemes();
     std::string currentTheme = themeManager.getCurrentTheme();
     
+    // Render the other themes' icons in the background while the user is choosing
+    for (const auto& themeName : themes) {
+        if (themeName != currentTheme) {
+            SvgIconManager::GetInstance().PrewarmTheme(themeName);
+        }
+    }
+    
     // Add theme options to menu
     for (const auto& themeName : themes) {
         wxString displayName;
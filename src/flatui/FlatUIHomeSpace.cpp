@@ -17,7 +17,8 @@ FlatUIHomeSpace::FlatUIHomeSpace(wxWindow* parent, wxWindowID id)
     : wxControl(parent, id, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE | wxFULL_REPAINT_ON_RESIZE),
     m_hover(false),
     m_buttonWidth(CFG_INT("SystemButtonWidth")),
-    m_activeHomeMenu(nullptr) // Initialize m_activeHomeMenu
+    m_activeHomeMenu(nullptr), // Initialize m_activeHomeMenu
+    m_themeSubscription([this]() { Refresh(); })
 {
     SetBackgroundStyle(wxBG_STYLE_PAINT); // Important for custom painting
 }
@@ -45,6 +46,7 @@ void FlatUIHomeSpace::CalculateButtonRect(const wxSize& controlSize)
 
 void FlatUIHomeSpace::OnPaint(wxPaintEvent& evt)
 {
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
     wxAutoBufferedPaintDC dc(this);
     // dc.Clear(); // Clearing with default might not be what we want if aiming for transparency to parent.
                  // Instead, we will explicitly fill our buttonRect with appropriate color.
@@ -0,0 +1,155 @@
+#include "flatui/FlatUILayoutEngine.h"
+#include "logger/Logger.h"
+#include <algorithm>
+
+namespace {
+    // Arranging may invalidate again (a host resizing a page); bail out instead of looping forever
+    const int kMaxPassesPerFlush = 4;
+}
+
+FlatUILayoutNode::~FlatUILayoutNode()
+{
+    FlatUILayoutEngine::GetInstance().Cancel(this);
+}
+
+wxSize FlatUILayoutNode::Measure() const
+{
+    if (!m_measureValid) {
+        m_measured = MeasureOverride();
+        m_measureValid = true;
+        ++FlatUILayoutEngine::GetInstance().m_stats.measures;
+    }
+    return m_measured;
+}
+
+void FlatUILayoutNode::InvalidateMeasure()
+{
+    // A node with a stale measure and a queued pass already has dirty ancestors
+    FlatUILayoutNode* node = this;
+    while (node) {
+        bool alreadyDirty = node->m_layoutDirty && !node->m_measureValid;
+        node->m_measureValid = false;
+        node->m_layoutDirty = true;
+        node->m_window->InvalidateBestSize();
+        if (alreadyDirty) {
+            return;
+        }
+
+        FlatUILayoutNode* parent = node->GetLayoutParent();
+        if (!parent) {
+            FlatUILayoutEngine::GetInstance().Schedule(node);
+        }
+        node = parent;
+    }
+}
+
+void FlatUILayoutNode::EnsureArranged()
+{
+    if (m_layoutDirty) {
+        FlatUILayoutEngine::GetInstance().Flush();
+    }
+}
+
+FlatUILayoutNode* FlatUILayoutNode::GetLayoutParent() const
+{
+    wxWindow* parent = m_window->GetParent();
+    return parent ? dynamic_cast<FlatUILayoutNode*>(parent) : nullptr;
+}
+
+void FlatUILayoutNode::GetLayoutChildren(std::vector<FlatUILayoutNode*>& children) const
+{
+    for (wxWindow* child : m_window->GetChildren()) {
+        if (FlatUILayoutNode* node = dynamic_cast<FlatUILayoutNode*>(child)) {
+            children.push_back(node);
+        }
+    }
+}
+
+void FlatUILayoutNode::Arrange()
+{
+    if (!m_layoutDirty) {
+        return;
+    }
+
+    // Clean subtrees are skipped; dirty flags always reach the root
+    std::vector<FlatUILayoutNode*> children;
+    GetLayoutChildren(children);
+    for (FlatUILayoutNode* child : children) {
+        child->Arrange();
+    }
+
+    m_layoutDirty = false;
+    ArrangeOverride(Measure());
+    ++FlatUILayoutEngine::GetInstance().m_stats.arranges;
+}
+
+FlatUILayoutEngine& FlatUILayoutEngine::GetInstance()
+{
+    static FlatUILayoutEngine instance;
+    return instance;
+}
+
+void FlatUILayoutEngine::Schedule(FlatUILayoutNode* root)
+{
+    if (std::find(m_pending.begin(), m_pending.end(), root) == m_pending.end()) {
+        m_pending.push_back(root);
+    }
+    if (m_flushing || m_flushPosted) {
+        return;
+    }
+
+    if (wxTheApp) {
+        m_flushPosted = true;
+        wxTheApp->CallAfter([this]() {
+            m_flushPosted = false;
+            Flush();
+        });
+    }
+    else {
+        Flush();
+    }
+}
+
+void FlatUILayoutEngine::Cancel(FlatUILayoutNode* node)
+{
+    m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), node), m_pending.end());
+}
+
+void FlatUILayoutEngine::Flush()
+{
+    if (m_flushing) {
+        return;
+    }
+    m_flushing = true;
+
+    for (int pass = 0; pass < kMaxPassesPerFlush && !m_pending.empty(); ++pass) {
+        ++m_stats.passes;
+        // Roots queued while arranging wait for the next pass; cancelled roots drop out of m_pending
+        size_t queued = m_pending.size();
+        for (size_t i = 0; i < queued && !m_pending.empty(); ++i) {
+            FlatUILayoutNode* root = m_pending.front();
+            m_pending.erase(m_pending.begin());
+            root->Arrange();
+            root->OnLayoutRootArranged();
+        }
+    }
+
+    if (!m_pending.empty()) {
+        LOG_WRN("Layout did not settle; " + std::to_string(m_pending.size()) + " roots left for the next pass", "LayoutEngine");
+        if (wxTheApp && !m_flushPosted) {
+            m_flushPosted = true;
+            wxTheApp->CallAfter([this]() {
+                m_flushPosted = false;
+                Flush();
+            });
+        }
+    }
+    m_flushing = false;
+}
+
+void FlatUILayoutEngine::LogStats() const
+{
+    LOG_INF("Layout engine: " + std::to_string(m_stats.passes) + " passes, " +
+        std::to_string(m_stats.measures) + " measures, " +
+        std::to_string(m_stats.arranges) + " arranges", "LayoutEngine");
+}
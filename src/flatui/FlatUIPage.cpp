@@ -3,6 +3,7 @@
 #include "config/SvgIconManager.h"
 #include "flatui/FlatUIPanel.h"
 #include "flatui/FlatUIBar.h"
+#include "flatui/FlatUIFixPanel.h"
 #include "logger/Logger.h"
 #include <wx/dcbuffer.h>
 #include "config/ThemeManager.h"
@@ -11,8 +12,10 @@
 
 FlatUIPage::FlatUIPage(wxWindow* parent, const wxString& label)
     : wxControl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE), 
+    FlatUILayoutNode(this),
     m_label(label),
-    m_isActive(false)
+    m_isActive(false),
+    m_themeSubscription([this]() { Refresh(); })
 {
     SetFont(CFG_DEFAULTFONT());
     SetDoubleBuffered(true);
@@ -54,6 +57,7 @@ void FlatUIPage::UpdateLayout()
 
 void FlatUIPage::OnPaint(wxPaintEvent& evt)
 {
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
     wxAutoBufferedPaintDC dc(this);
     wxSize size = GetSize();
 
@@ -102,9 +106,9 @@ void FlatUIPage::OnSize(wxSizeEvent& evt)
     //     ", " + std::to_string(newSize.GetHeight()) + ")",
     //     "FlatUIPage::OnSize");
 
+    // Panel sizes are cached; a resize only runs the sizer again
     if (m_sizer) {
         wxEventBlocker blocker(this, wxEVT_SIZE);
-        RecalculatePageHeight();
         Layout();
     }
 
@@ -114,67 +118,59 @@ void FlatUIPage::OnSize(wxSizeEvent& evt)
 
 void FlatUIPage::RecalculatePageHeight()
 {
-    static bool isRecalculating = false;
-    if (isRecalculating)
-        return;
-
-    isRecalculating = true;
-
-    Freeze();
+    InvalidateMeasure();
+}
 
+wxSize FlatUIPage::MeasureOverride() const
+{
     if (m_panels.empty()) {
-        wxSize defaultSize(100, 60);
-        SetMinSize(defaultSize);
-        if (m_sizer) {
-            m_sizer->SetDimension(0, 0, defaultSize.GetWidth(), defaultSize.GetHeight());
-        }
-        //LOG_INF("RecalculatePageHeight: Empty page " + GetLabel().ToStdString() + ", Set default size: (100,100)", "FlatUIPage");
-        isRecalculating = false;
-        Thaw();
-        return;
+        return wxSize(100, 60);
     }
 
-    bool wasHidden = !IsShown();
-    if (wasHidden)
-        Show();
-
+    // Panels are added to the sizer with a one pixel border on every side
+    const int panelBorder = 1;
     int maxHeight = 0;
     int totalWidth = 0;
-
     for (auto panel : m_panels) {
         if (!panel) continue;
 
-        panel->UpdatePanelSize();
-        wxSize panelBestSize = panel->GetBestSize();
-        totalWidth += panelBestSize.GetWidth();
-        maxHeight = wxMax(maxHeight, panelBestSize.GetHeight());
-
-        LOG_DBG("Panel " + panel->GetLabel().ToStdString() +
-            " Best Size: (" + std::to_string(panelBestSize.GetWidth()) +
-            "," + std::to_string(panelBestSize.GetHeight()) + ")", "FlatUIPage");
+        wxSize panelSize = panel->Measure();
+        totalWidth += panelSize.GetWidth() + 2 * panelBorder;
+        maxHeight = wxMax(maxHeight, panelSize.GetHeight() + 2 * panelBorder);
     }
+    return wxSize(totalWidth, maxHeight);
+}
 
-    wxSize newMinSize(totalWidth, maxHeight);
-    SetMinSize(newMinSize);
-
+void FlatUIPage::ArrangeOverride(const wxSize& measured)
+{
+    SetMinSize(measured);
     if (m_sizer) {
-        m_sizer->SetDimension(0, 0, totalWidth, maxHeight);
+        wxEventBlocker blocker(this, wxEVT_SIZE);
+        m_sizer->SetDimension(0, 0, measured.GetWidth(), measured.GetHeight());
     }
 
-    LOG_INF("RecalculatePageHeight: Page " + GetLabel().ToStdString() +
-        ", Calculated size: (" + std::to_string(totalWidth) +
-        "," + std::to_string(maxHeight) + ")", "FlatUIPage");
-
-    if (wasHidden)
-        Hide();
+    LOG_DBG("Arranged page " + GetLabel().ToStdString() +
+        ", Measured size: (" + std::to_string(measured.GetWidth()) +
+        "," + std::to_string(measured.GetHeight()) + ")", "FlatUIPage");
+}
 
+void FlatUIPage::OnLayoutRootArranged()
+{
+    // Outside the fix panel (floating, or not yet docked) the host window lays the page out
     wxWindow* parent = GetParent();
     if (parent) {
         parent->Layout();
     }
+}
 
-    isRecalculating = false;
-    Thaw();
+FlatUILayoutNode* FlatUIPage::GetLayoutParent() const
+{
+    for (wxWindow* window = GetParent(); window && !window->IsTopLevel(); window = window->GetParent()) {
+        if (FlatUIFixPanel* fixPanel = dynamic_cast<FlatUIFixPanel*>(window)) {
+            return fixPanel;
+        }
+    }
+    return nullptr;
 }
 
 void FlatUIPage::AddPanel(FlatUIPanel* panel)
@@ -188,41 +184,26 @@ void FlatUIPage::AddPanel(FlatUIPanel* panel)
         SetSizer(boxSizer);
     }
 
-    panel->UpdatePanelSize();
-    wxSize minSize = panel->GetBestSize();
-    panel->SetMinSize(minSize);
-
     boxSizer->Add(panel, 0, wxALL, 1);
 
-    wxSize pageSizeForLog = GetSize();
-    wxSize panelSizeForLog = panel->GetSize();
-
     LOG_INF("Added panel: " + panel->GetLabel().ToStdString() +
-        " to page: " + GetLabel().ToStdString() +
-        ". Page Size: (" + std::to_string(pageSizeForLog.GetWidth()) +
-        ", " + std::to_string(pageSizeForLog.GetHeight()) + ")" +
-        ". Panel Size: (" + std::to_string(panelSizeForLog.GetWidth()) +
-        ", " + std::to_string(panelSizeForLog.GetHeight()) + ")",
-        "FlatUIPage");
+        " to page: " + GetLabel().ToStdString(), "FlatUIPage");
 
     panel->Show();
+    panel->UpdatePanelSize();
     RecalculatePageHeight();
-    Layout();
-    Refresh(false);
 
     Thaw();
 }
 
 void FlatUIPage::InitializeLayout()
 {
-    Freeze();
-    wxEventBlocker blocker(this, wxEVT_SIZE);
-    for (auto panel : m_panels) {
-        panel->UpdatePanelSize();
-    }
+    // Runs the pending pass now so callers see final sizes
     RecalculatePageHeight();
+    FlatUILayoutEngine::GetInstance().Flush();
+
+    wxEventBlocker blocker(this, wxEVT_SIZE);
     Layout();
-    Thaw();
 
     LOG_INF("Initialized layout for page: " + GetLabel().ToStdString() +
         ", Size: (" + std::to_string(GetSize().GetWidth()) +
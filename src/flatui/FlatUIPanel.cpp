@@ -8,6 +8,7 @@
 #include <wx/graphics.h>
 #include <wx/event.h>
 #include "config/ThemeManager.h"  
+#include "flatui/FlatUIResourcePool.h"
 
 
 enum {
@@ -17,6 +18,7 @@ enum {
 
 FlatUIPanel::FlatUIPanel(FlatUIPage* parent, const wxString& label, int orientation) 
     : wxControl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE),
+    FlatUILayoutNode(this),
     m_label(label),
     m_orientation(orientation),
     m_panelBorderTop(0),
@@ -24,17 +26,15 @@ FlatUIPanel::FlatUIPanel(FlatUIPage* parent, const wxString& label, int orientat
     m_panelBorderLeft(0),
     m_panelBorderRight(1),
     m_borderStyle(PanelBorderStyle::NONE),
-    m_resizeTimer(this, TIMER_RESIZE)
+    m_resizeTimer(this, TIMER_RESIZE),
+    m_themeSubscription([this]() { LoadThemeValues(); Refresh(); }),
+    m_layoutSubscription([this]() { InvalidateMeasure(); })
 {
     SetFont(CFG_DEFAULTFONT());
     SetDoubleBuffered(true);
 
     // Initialize theme-based configuration values
-    m_bgColour = CFG_COLOUR("ActBarBackgroundColour");
-    m_borderColour = CFG_COLOUR("PanelBorderColour");
-    m_headerColour = CFG_COLOUR("PanelHeaderColour");
-    m_headerTextColour = CFG_COLOUR("PanelHeaderTextColour");
-    m_headerBorderColour = CFG_COLOUR("PanelBorderColour");
+    LoadThemeValues();
 
     // int headerArea = CFG_INT("PanelDefaultHeaderAreaSize", FLATUI_PANEL_DEFAULT_HEADER_AREA_SIZE);
     // int padVertical = CFG_INT("PanelInternalVerticalPadding", FLATUI_PANEL_INTERNAL_VERTICAL_PADDING);
@@ -57,19 +57,28 @@ FlatUIPanel::FlatUIPanel(FlatUIPage* parent, const wxString& label, int orientat
 
     FlatUIEventManager::getInstance().bindPanelEvents(this);
 
+    // The measured size does not depend on the current size; only the children are placed again
     Bind(wxEVT_SIZE, [this](wxSizeEvent& event) {
-        Freeze();
-        wxEventBlocker blocker(this, wxEVT_SIZE);
-        RecalculateBestSize();
-        Layout();
+        wxSize size = GetSize();
+        ResizeChildControls(size.GetWidth(), size.GetHeight());
         Refresh(false);
-        Thaw();
         event.Skip();
         });
 
     Bind(wxEVT_TIMER, &FlatUIPanel::OnTimer, this);
 
-    RecalculateBestSize();
+    InvalidateMeasure();
+}
+
+void FlatUIPanel::LoadThemeValues()
+{
+    // Keys read here are recorded, so the subscription always matches what is cached
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
+    m_bgColour = CFG_COLOUR("ActBarBackgroundColour");
+    m_borderColour = CFG_COLOUR("PanelBorderColour");
+    m_headerColour = CFG_COLOUR("PanelHeaderColour");
+    m_headerTextColour = CFG_COLOUR("PanelHeaderTextColour");
+    m_headerBorderColour = CFG_COLOUR("PanelBorderColour");
 }
 
 void FlatUIPanel::OnTimer(wxTimerEvent& event)
@@ -81,34 +90,7 @@ void FlatUIPanel::OnTimer(wxTimerEvent& event)
 
 void FlatUIPanel::UpdatePanelSize()
 {
-    Freeze();
-    wxEventBlocker blocker(this, wxEVT_SIZE);
-
-    bool wasHidden = !IsShown();
-    if (wasHidden)
-        Show();
-
-    RecalculateBestSize();
-    Layout();
-
-    if (wasHidden)
-        Hide();
-
-    wxWindow* parent = GetParent();
-    if (parent) {
-        FlatUIPage* page = dynamic_cast<FlatUIPage*>(parent);
-        if (page) {
-            page->RecalculatePageHeight();
-        }
-        parent->Layout();
-    }
-
-    Refresh(false);
-    Thaw();
-
-    //LOG_INF("Updated panel: " + GetLabel().ToStdString() +
-    //    ", Size: (" + std::to_string(GetSize().GetWidth()) +
-    //    "," + std::to_string(GetSize().GetHeight()) + ")", "FlatUIPanel");
+    InvalidateMeasure();
 }
 
 void FlatUIPanel::ResizeChildControls(int width, int height)
@@ -149,7 +131,6 @@ void FlatUIPanel::ResizeChildControls(int width, int height)
         if (sizerHeight < 0) sizerHeight = 0;
 
         m_sizer->SetDimension(sizerX, sizerY, sizerWidth, sizerHeight);
-        Layout();
     }
 
     LOG_DBG("ResizeChildControls called for panel: " + GetLabel().ToStdString() +
@@ -157,16 +138,9 @@ void FlatUIPanel::ResizeChildControls(int width, int height)
         ", Height: " + std::to_string(height), "FlatUIPanel");
 }
 
-void FlatUIPanel::RecalculateBestSize()
+wxSize FlatUIPanel::MeasureOverride() const
 {
-    static bool isRecalculating = false;
-    if (isRecalculating)
-        return;
-
-    isRecalculating = true;
-
-    Freeze();
-
+    ThemeSubscription::Recorder layoutKeys(m_layoutSubscription);
     wxSize bestPanelSize(0, 0); // Renamed from bestSize for clarity with TARGET_PANEL_HEIGHT
     int headerOffsetWidth = 0, headerOffsetHeight = 0;
      
@@ -182,40 +156,29 @@ void FlatUIPanel::RecalculateBestSize()
     int childrenTotalHeight = 0;
     int childControlCount = 0;
 
+    // Children report cached sizes, so hidden children no longer need to be shown to be measured
+    auto addChild = [&](const wxSize& childSize) {
+        if (m_orientation == wxHORIZONTAL) {
+            childrenTotalWidth += childSize.GetWidth();
+            childControlCount++;
+            childrenTotalHeight = wxMax(childrenTotalHeight, childSize.GetHeight());
+        }
+        else {
+            childrenTotalWidth = wxMax(childrenTotalWidth, childSize.GetWidth());
+            childrenTotalHeight += childSize.GetHeight();
+        }
+    };
+
     if (m_buttonBars.size() + m_galleries.size() > 0) {
         for (auto buttonBar : m_buttonBars) {
             if (buttonBar) {
-                bool wasHidden = !buttonBar->IsShown();
-                if (wasHidden) buttonBar->Show();
-                wxSize barSize = buttonBar->GetBestSize();
-                if (m_orientation == wxHORIZONTAL) {
-                    childrenTotalWidth += barSize.GetWidth();
-                    childControlCount++;
-                    childrenTotalHeight = wxMax(childrenTotalHeight, barSize.GetHeight());
-                }
-                else {
-                    childrenTotalWidth = wxMax(childrenTotalWidth, barSize.GetWidth());
-                    childrenTotalHeight += barSize.GetHeight();
-                }
-                if (wasHidden) buttonBar->Hide();
+                addChild(buttonBar->Measure());
             }
         }
 
         for (auto gallery : m_galleries) {
             if (gallery) {
-                bool wasHidden = !gallery->IsShown();
-                if (wasHidden) gallery->Show();
-                wxSize gallerySize = gallery->GetBestSize();
-                if (m_orientation == wxHORIZONTAL) {
-                    childrenTotalWidth += gallerySize.GetWidth();
-                    childControlCount++;
-                    childrenTotalHeight = wxMax(childrenTotalHeight, gallerySize.GetHeight());
-                }
-                else {
-                    childrenTotalWidth = wxMax(childrenTotalWidth, gallerySize.GetWidth());
-                    childrenTotalHeight += gallerySize.GetHeight();
-                }
-                if (wasHidden) gallery->Hide();
+                addChild(gallery->Measure());
             }
         }
 
@@ -229,10 +192,7 @@ void FlatUIPanel::RecalculateBestSize()
         childrenTotalWidth = GetMinSize().GetWidth() > 0
             ? GetMinSize().GetWidth() - CFG_INT("PanelInternalPaddingTotal") - headerOffsetWidth
             : CFG_INT("PanelMargin");
-        // childrenTotalHeight calculation for empty panel needs to result in TARGET_PANEL_HEIGHT
-        // This part is tricky if we want an empty panel to also be TARGET_PANEL_HEIGHT.
-        // Let's assume childrenTotalHeight is 0 if no children, 
-        // and TARGET_PANEL_HEIGHT will handle the overall panel height.
+        // An empty panel gets its height from PanelTargetHeight below
         childrenTotalHeight = 0;
     }
 
@@ -249,64 +209,18 @@ void FlatUIPanel::RecalculateBestSize()
     int calculatedHeight = childrenTotalHeight + headerOffsetHeight + CFG_INT("PanelInternalVerticalPadding");
     int minHeight = (childrenTotalHeight > 0) ? calculatedHeight + 4 : CFG_INT("PanelTargetHeight");
     bestPanelSize.SetHeight(wxMax(calculatedHeight, minHeight));
+    return bestPanelSize;
+}
 
-    int targetHeight = CFG_INT("PanelTargetHeight");
-    int finalHeight = wxMax(calculatedHeight, targetHeight);
-
-    // Add debug logging 
-    // LOG_INF("Panel " + GetLabel().ToStdString() +
-    //     " - Children: " + std::to_string(childrenTotalHeight) +
-    //     ", Header: " + std::to_string(headerOffsetHeight) +
-    //     ", Padding: " + std::to_string(CFG_INT("PanelInternalVerticalPadding")) +
-    //     ", Calculated: " + std::to_string(calculatedHeight) +
-    //     ", Target: " + std::to_string(targetHeight) +
-    //     ", Final: " + std::to_string(finalHeight), "FlatUIPanel");
-
-    SetMinSize(bestPanelSize);
-    SetSize(bestPanelSize); // Keep this to enforce size, as in original
-
-    if (m_sizer) {
-        int sizerAreaX = 0;
-        int sizerAreaY = 0;
-        int sizerAreaWidth = bestPanelSize.GetWidth();
-        int sizerAreaHeight = bestPanelSize.GetHeight();  // Use actual panel height, not fixed target
-
-        // Adjust sizer area based on header style
-        switch (m_headerStyle) {
-        case PanelHeaderStyle::TOP:
-            sizerAreaY = CFG_INT("PanelDefaultHeaderAreaSize");
-            sizerAreaHeight -= CFG_INT("PanelDefaultHeaderAreaSize");
-            break;
-        case PanelHeaderStyle::LEFT:
-            sizerAreaX = CFG_INT("PanelDefaultHeaderAreaSize");
-            sizerAreaWidth -= CFG_INT("PanelDefaultHeaderAreaSize");
-            break;
-        case PanelHeaderStyle::BOTTOM_CENTERED:
-            sizerAreaHeight -= CFG_INT("PanelDefaultHeaderAreaSize");
-            break;
-        case PanelHeaderStyle::EMBEDDED:
-            // For embedded style, add top padding to avoid text overlap
-            if (!m_label.IsEmpty()) {
-                const int embeddedHeaderHeight = 20; // Space for embedded text
-                sizerAreaY = embeddedHeaderHeight;
-                sizerAreaHeight -= embeddedHeaderHeight;
-            }
-            break;
-        case PanelHeaderStyle::NONE:
-            // No adjustment needed
-            break;
-        }
-
-        if (sizerAreaWidth < 0) sizerAreaWidth = 0;
-        if (sizerAreaHeight < 0) sizerAreaHeight = 0;
-
-        m_sizer->SetDimension(sizerAreaX, sizerAreaY, sizerAreaWidth, sizerAreaHeight);
-    }
-
-    //LOG_INF("RecalculateBestSize for panel: " + GetLabel().ToStdString() + " Best Size: (" + std::to_string(bestPanelSize.GetWidth()) + ", " +  std::to_string(bestPanelSize.GetHeight()) + ")", "FlatUIPanel");
-
-    Thaw();
-    isRecalculating = false;
+void FlatUIPanel::ArrangeOverride(const wxSize& measured)
+{
+    ThemeSubscription::Recorder layoutKeys(m_layoutSubscription);
+    // Button bars and galleries already hold their final minimum sizes
+    wxEventBlocker blocker(this, wxEVT_SIZE);
+    SetMinSize(measured);
+    SetSize(measured); // Keep this to enforce size, as in original
+    ResizeChildControls(measured.GetWidth(), measured.GetHeight());
+    Refresh(false);
 }
 
 FlatUIPanel::~FlatUIPanel()
@@ -447,10 +361,11 @@ void FlatUIPanel::AddButtonBar(FlatUIButtonBar* buttonBar, int proportion, int f
 
     if (m_sizer) {
         m_sizer->Add(buttonBar, proportion, flag, border);
-        UpdatePanelSize();
     }
 
     buttonBar->Show();
+    buttonBar->InvalidateMeasure();
+    UpdatePanelSize();
     Thaw();
 }
 
@@ -463,22 +378,23 @@ void FlatUIPanel::AddGallery(FlatUIGallery* gallery, int proportion, int flag, i
         "x" + std::to_string(gallery->GetSize().GetHeight()), "FlatUIPanel");
     FlatUIEventManager::getInstance().bindGalleryEvents(gallery); 
 
-    gallery->SetMinSize(gallery->GetBestSize());
     flag = wxLEFT | wxRIGHT | wxTOP | wxALIGN_TOP;
     border = 2; // 4-pixel margin
     proportion = 0;
 
     if (m_sizer) { 
         m_sizer->Add(gallery, proportion, flag, border);
-        UpdatePanelSize();
     }
 
     gallery->Show();
+    gallery->InvalidateMeasure();
+    UpdatePanelSize();
     Thaw();
 }
 
 void FlatUIPanel::OnPaint(wxPaintEvent& evt)
 {
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
     wxAutoBufferedPaintDC dc(this);
     wxSize size = GetSize();
 
@@ -492,6 +408,8 @@ void FlatUIPanel::OnPaint(wxPaintEvent& evt)
         return;
     }
 
+    FlatUIResourcePool& pool = FlatUIResourcePool::GetInstance();
+
     //LOG_DBG("Panel: " + m_label.ToStdString() +
     //    " BorderStyle: " + std::to_string((int)m_borderStyle) +
     //    " BorderWidths: " + std::to_string(m_panelBorderTop) + "," +
@@ -505,7 +423,7 @@ void FlatUIPanel::OnPaint(wxPaintEvent& evt)
             int maxBorderWidth = wxMax(wxMax(m_panelBorderTop, m_panelBorderBottom),
                 wxMax(m_panelBorderLeft, m_panelBorderRight));
             if (maxBorderWidth > 0) {
-                gc->SetPen(wxPen(m_borderColour, maxBorderWidth));
+                gc->SetPen(pool.GetPen(m_borderColour, maxBorderWidth));
                 gc->SetAntialiasMode(wxANTIALIAS_DEFAULT);
                 wxGraphicsPath path = gc->CreatePath();
                 path.AddRoundedRectangle(maxBorderWidth / 2.0, maxBorderWidth / 2.0,
@@ -517,42 +435,42 @@ void FlatUIPanel::OnPaint(wxPaintEvent& evt)
         else {
             // Draw individual borders based on their widths
             if (m_panelBorderTop > 0) {
-                gc->SetPen(wxPen(m_borderColour, m_panelBorderTop));
+                gc->SetPen(pool.GetPen(m_borderColour, m_panelBorderTop));
                 gc->StrokeLine(0, m_panelBorderTop / 2.0, size.GetWidth(), m_panelBorderTop / 2.0);
             }
             if (m_panelBorderRight > 0) {
-                gc->SetPen(wxPen(m_borderColour, m_panelBorderRight));
+                gc->SetPen(pool.GetPen(m_borderColour, m_panelBorderRight));
                 gc->StrokeLine(size.GetWidth() - m_panelBorderRight / 2.0, 0,
                     size.GetWidth() - m_panelBorderRight / 2.0, size.GetHeight());
             }
             if (m_panelBorderBottom > 0) {
-                gc->SetPen(wxPen(m_borderColour, m_panelBorderBottom));
+                gc->SetPen(pool.GetPen(m_borderColour, m_panelBorderBottom));
                 gc->StrokeLine(0, size.GetHeight() - m_panelBorderBottom / 2.0,
                     size.GetWidth(), size.GetHeight() - m_panelBorderBottom / 2.0);
             }
             if (m_panelBorderLeft > 0) {
-                gc->SetPen(wxPen(m_borderColour, m_panelBorderLeft));
+                gc->SetPen(pool.GetPen(m_borderColour, m_panelBorderLeft));
                 gc->StrokeLine(m_panelBorderLeft / 2.0, 0, m_panelBorderLeft / 2.0, size.GetHeight());
             }
         }
     }
     else {
         if (m_panelBorderTop > 0) {
-            gc->SetPen(wxPen(m_borderColour, m_panelBorderTop));
+            gc->SetPen(pool.GetPen(m_borderColour, m_panelBorderTop));
             gc->StrokeLine(0, m_panelBorderTop / 2.0, size.GetWidth(), m_panelBorderTop / 2.0);
         }
         if (m_panelBorderRight > 0) {
-            gc->SetPen(wxPen(m_borderColour, m_panelBorderRight));
+            gc->SetPen(pool.GetPen(m_borderColour, m_panelBorderRight));
             gc->StrokeLine(size.GetWidth() - m_panelBorderRight / 2.0, 0,
                 size.GetWidth() - m_panelBorderRight / 2.0, size.GetHeight());
         }
         if (m_panelBorderBottom > 0) {
-            gc->SetPen(wxPen(m_borderColour, m_panelBorderBottom));
+            gc->SetPen(pool.GetPen(m_borderColour, m_panelBorderBottom));
             gc->StrokeLine(0, size.GetHeight() - m_panelBorderBottom / 2.0,
                 size.GetWidth(), size.GetHeight() - m_panelBorderBottom / 2.0);
         }
         if (m_panelBorderLeft > 0) {
-            gc->SetPen(wxPen(m_borderColour, m_panelBorderLeft));
+            gc->SetPen(pool.GetPen(m_borderColour, m_panelBorderLeft));
             gc->StrokeLine(m_panelBorderLeft / 2.0, 0, m_panelBorderLeft / 2.0, size.GetHeight());
         }
     }
@@ -564,32 +482,32 @@ void FlatUIPanel::OnPaint(wxPaintEvent& evt)
 
         switch (m_headerStyle) {
         case PanelHeaderStyle::TOP:
-            gc->SetBrush(wxBrush(m_headerColour));
+            gc->SetBrush(pool.GetBrush(m_headerColour));
             gc->SetPen(*wxTRANSPARENT_PEN);
             gc->DrawRectangle(0, 0, size.GetWidth(), CFG_INT("PanelDefaultHeaderAreaSize"));
             gc->DrawText(m_label, 0, (CFG_INT("PanelDefaultHeaderAreaSize") - textHeight) / 2);
 
             // Draw header borders
-            gc->SetPen(wxPen(m_headerBorderColour, 1));
+            gc->SetPen(pool.GetPen(m_headerBorderColour, 1));
             if (m_headerBorderTop > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderTop));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderTop));
                 gc->StrokeLine(0, 0, size.GetWidth(), 0);
             }
             if (m_headerBorderBottom > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderBottom));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderBottom));
                 gc->StrokeLine(0, CFG_INT("PanelDefaultHeaderAreaSize"), size.GetWidth(), CFG_INT("PanelDefaultHeaderAreaSize"));
             }
             if (m_headerBorderLeft > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderLeft));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderLeft));
                 gc->StrokeLine(0, 0, 0, CFG_INT("PanelDefaultHeaderAreaSize"));
             }
             if (m_headerBorderRight > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderRight));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderRight));
                 gc->StrokeLine(size.GetWidth(), 0, size.GetWidth(), CFG_INT("PanelDefaultHeaderAreaSize"));
             }
             break;
         case PanelHeaderStyle::LEFT:
-            gc->SetBrush(wxBrush(m_headerColour));
+            gc->SetBrush(pool.GetBrush(m_headerColour));
             gc->SetPen(*wxTRANSPARENT_PEN);
             gc->DrawRectangle(0, 0, CFG_INT("PanelDefaultHeaderAreaSize"), size.GetHeight());
             gc->PushState();
@@ -600,19 +518,19 @@ void FlatUIPanel::OnPaint(wxPaintEvent& evt)
 
             // Draw header borders
             if (m_headerBorderTop > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderTop));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderTop));
                 gc->StrokeLine(0, 0, CFG_INT("PanelDefaultHeaderAreaSize"), 0);
             }
             if (m_headerBorderBottom > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderBottom));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderBottom));
                 gc->StrokeLine(0, size.GetHeight(), CFG_INT("PanelDefaultHeaderAreaSize"), size.GetHeight());
             }
             if (m_headerBorderLeft > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderLeft));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderLeft));
                 gc->StrokeLine(0, 0, 0, size.GetHeight());
             }
             if (m_headerBorderRight > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderRight));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderRight));
                 gc->StrokeLine(CFG_INT("PanelDefaultHeaderAreaSize"), 0, CFG_INT("PanelDefaultHeaderAreaSize"), size.GetHeight());
             }
             break;
@@ -626,26 +544,26 @@ void FlatUIPanel::OnPaint(wxPaintEvent& evt)
             if (m_headerBorderTop > 0 || m_headerBorderBottom > 0 || m_headerBorderLeft > 0 || m_headerBorderRight > 0) {
                 const int embeddedHeaderHeight = 20;
                 if (m_headerBorderTop > 0) {
-                    gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderTop));
+                    gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderTop));
                     gc->StrokeLine(0, 0, size.GetWidth(), 0);
                 }
                 if (m_headerBorderBottom > 0) {
-                    gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderBottom));
+                    gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderBottom));
                     gc->StrokeLine(0, embeddedHeaderHeight, size.GetWidth(), embeddedHeaderHeight);
                 }
                 if (m_headerBorderLeft > 0) {
-                    gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderLeft));
+                    gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderLeft));
                     gc->StrokeLine(0, 0, 0, embeddedHeaderHeight);
                 }
                 if (m_headerBorderRight > 0) {
-                    gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderRight));
+                    gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderRight));
                     gc->StrokeLine(size.GetWidth(), 0, size.GetWidth(), embeddedHeaderHeight);
                 }
             }
         }
         break;
         case PanelHeaderStyle::BOTTOM_CENTERED:
-            gc->SetBrush(wxBrush(m_headerColour));
+            gc->SetBrush(pool.GetBrush(m_headerColour));
             gc->SetPen(*wxTRANSPARENT_PEN);
             // Draw header bar at the bottom
             gc->DrawRectangle(0, size.GetHeight() - CFG_INT("PanelDefaultHeaderAreaSize"), size.GetWidth(), CFG_INT("PanelDefaultHeaderAreaSize"));
@@ -658,27 +576,27 @@ void FlatUIPanel::OnPaint(wxPaintEvent& evt)
             // Draw header borders
             // LOG_INF("Drawing bottom header borders for panel: " + m_headerBorderColour.GetAsString().ToStdString(), "FlatUIPanel");
             if (m_headerBorderTop > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderTop));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderTop));
                 gc->StrokeLine(0,
                     size.GetHeight() - CFG_INT("PanelDefaultHeaderAreaSize"),
                     size.GetWidth(), 
                     size.GetHeight() - CFG_INT("PanelDefaultHeaderAreaSize"));
             }
             if (m_headerBorderBottom > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderBottom));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderBottom));
                 gc->StrokeLine(CFG_INT("PanelInnerBarBorderSpacing"),
                     size.GetHeight(),
                     size.GetWidth() - CFG_INT("PanelInnerBarBorderSpacing"), size.GetHeight());
             }
             if (m_headerBorderLeft > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderLeft));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderLeft));
                 gc->StrokeLine(0,
                     size.GetHeight() - CFG_INT("PanelDefaultHeaderAreaSize") - CFG_INT("PanelInnerBarBorderSpacing"),
                     0,
                     size.GetHeight() - CFG_INT("PanelInnerBarBorderSpacing"));
             }
             if (m_headerBorderRight > 0) {
-                gc->SetPen(wxPen(m_headerBorderColour, m_headerBorderRight));
+                gc->SetPen(pool.GetPen(m_headerBorderColour, m_headerBorderRight));
                 gc->StrokeLine(size.GetWidth(),
                     size.GetHeight() - CFG_INT("PanelDefaultHeaderAreaSize") - CFG_INT("PanelInnerBarBorderSpacing"),
                     size.GetWidth(),
@@ -5,7 +5,8 @@
 FlatUIProfileSpace::FlatUIProfileSpace(wxWindow* parent, wxWindowID id)
     : wxControl(parent, id, wxDefaultPosition, wxDefaultSize, wxTAB_TRAVERSAL | wxBORDER_NONE | wxFULL_REPAINT_ON_RESIZE),
     m_childControl(nullptr),
-    m_spaceWidth(CFG_INT("SpaceDefaulWidth"))
+    m_spaceWidth(CFG_INT("SpaceDefaulWidth")),
+    m_themeSubscription([this]() { Refresh(); })
 {
 
     Bind(wxEVT_SIZE, &FlatUIProfileSpace::OnSize, this);
@@ -69,6 +70,7 @@ void FlatUIProfileSpace::OnSize(wxSizeEvent& evt)
 
 void FlatUIProfileSpace::OnPaint(wxPaintEvent& evt)
 {
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
     wxPaintDC dc(this);
     
     // Fill background with theme color
@@ -0,0 +1,121 @@
+#include "flatui/FlatUIResourcePool.h"
+#include "config/ThemeManager.h"
+#include "logger/Logger.h"
+
+FlatUIResourcePool& FlatUIResourcePool::GetInstance()
+{
+    static FlatUIResourcePool instance;
+    return instance;
+}
+
+FlatUIResourcePool::FlatUIResourcePool()
+{
+    // Theme colours change wholesale on a switch, so drop everything rather than
+    // letting the previous theme's objects linger
+    ThemeManager::getInstance().addThemeChangeListener(this, [this]() {
+        Clear();
+    });
+}
+
+FlatUIResourcePool::~FlatUIResourcePool()
+{
+    ThemeManager::getInstance().removeThemeChangeListener(this);
+}
+
+uint64_t FlatUIResourcePool::MakeKey(const wxColour& colour, int width, int style)
+{
+    // RGBA in the low 32 bits, width and style packed above it
+    uint64_t rgba = (static_cast<uint64_t>(colour.Red()) << 24) |
+                    (static_cast<uint64_t>(colour.Green()) << 16) |
+                    (static_cast<uint64_t>(colour.Blue()) << 8) |
+                    static_cast<uint64_t>(colour.Alpha());
+    return rgba |
+           (static_cast<uint64_t>(static_cast<uint16_t>(width)) << 32) |
+           (static_cast<uint64_t>(static_cast<uint16_t>(style)) << 48);
+}
+
+uint64_t FlatUIResourcePool::MakeFontKey(int pointSize, wxFontFamily family, wxFontStyle style, wxFontWeight weight)
+{
+    // Point size in the low 32 bits, then family, style and weight (up to 1000)
+    return static_cast<uint64_t>(static_cast<uint32_t>(pointSize)) |
+           (static_cast<uint64_t>(static_cast<uint8_t>(family)) << 32) |
+           (static_cast<uint64_t>(static_cast<uint8_t>(style)) << 40) |
+           (static_cast<uint64_t>(static_cast<uint16_t>(weight)) << 48);
+}
+
+const wxPen& FlatUIResourcePool::GetPen(const wxColour& colour, int width, wxPenStyle style)
+{
+    uint64_t key = MakeKey(colour, width, style);
+    auto it = m_pens.find(key);
+    if (it != m_pens.end()) {
+        ++m_stats.penHits;
+        return it->second;
+    }
+
+    ++m_stats.penMisses;
+    return m_pens.emplace(key, wxPen(colour, width, style)).first->second;
+}
+
+const wxBrush& FlatUIResourcePool::GetBrush(const wxColour& colour, wxBrushStyle style)
+{
+    uint64_t key = MakeKey(colour, 0, style);
+    auto it = m_brushes.find(key);
+    if (it != m_brushes.end()) {
+        ++m_stats.brushHits;
+        return it->second;
+    }
+
+    ++m_stats.brushMisses;
+    return m_brushes.emplace(key, wxBrush(colour, style)).first->second;
+}
+
+const wxFont& FlatUIResourcePool::GetFont(int pointSize, wxFontFamily family, wxFontStyle style,
+                                          wxFontWeight weight, const wxString& faceName)
+{
+    // Called on every paint, so a hit must not allocate; the face name is only compared
+    std::vector<FontEntry>& entries = m_fonts[MakeFontKey(pointSize, family, style, weight)];
+    for (const FontEntry& entry : entries) {
+        if (entry.faceName == faceName) {
+            ++m_stats.fontHits;
+            return entry.font;
+        }
+    }
+
+    ++m_stats.fontMisses;
+    entries.push_back({ faceName, wxFont(pointSize, family, style, weight, false, faceName) });
+    return entries.back().font;
+}
+
+void FlatUIResourcePool::Clear()
+{
+    m_pens.clear();
+    m_brushes.clear();
+    m_fonts.clear();
+}
+
+FlatUIResourcePool::Stats FlatUIResourcePool::GetStats() const
+{
+    Stats stats = m_stats;
+    stats.penCount = m_pens.size();
+    stats.brushCount = m_brushes.size();
+    for (const auto& entries : m_fonts) {
+        stats.fontCount += entries.second.size();
+    }
+    return stats;
+}
+
+void FlatUIResourcePool::ResetStats()
+{
+    m_stats = Stats();
+}
+
+void FlatUIResourcePool::LogStats() const
+{
+    Stats stats = GetStats();
+    LOG_INF("Resource pool: pens " + std::to_string(stats.penHits) + " hits/" +
+            std::to_string(stats.penMisses) + " misses (" + std::to_string(stats.penCount) + " live)" +
+            ", brushes " + std::to_string(stats.brushHits) + "/" + std::to_string(stats.brushMisses) +
+            " (" + std::to_string(stats.brushCount) + ")" +
+            ", fonts " + std::to_string(stats.fontHits) + "/" + std::to_string(stats.fontMisses) +
+            " (" + std::to_string(stats.fontCount) + ")", "ResourcePool");
+}
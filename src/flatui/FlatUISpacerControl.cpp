@@ -9,7 +9,8 @@ FlatUISpacerControl::FlatUISpacerControl(wxWindow* parent, int width, wxWindowID
     m_width(width),
     m_drawSeparator(false),
     m_autoExpand(false),
-    m_canDragWindow(false), m_dragging(false)
+    m_canDragWindow(false), m_dragging(false),
+    m_themeSubscription([this]() { Refresh(); })
 {
     SetBackgroundStyle(wxBG_STYLE_PAINT);
     
@@ -72,6 +73,7 @@ int FlatUISpacerControl::CalculateAutoWidth(int availableWidth) const
 
 void FlatUISpacerControl::OnPaint(wxPaintEvent& evt)
 {
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
     wxAutoBufferedPaintDC dc(this);
     wxSize size = GetSize();
     wxColour bgColor = CFG_COLOUR("BarBgColour");
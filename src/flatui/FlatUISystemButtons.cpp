@@ -10,7 +10,8 @@ FlatUISystemButtons::FlatUISystemButtons(wxWindow* parent, wxWindowID id)
       m_maximizeButtonHover(false),
       m_closeButtonHover(false),
       m_buttonWidth(CFG_INT("SystemButtonWidth")),
-      m_buttonSpacing(CFG_INT("SystemButtonSpacing"))
+      m_buttonSpacing(CFG_INT("SystemButtonSpacing")),
+      m_themeSubscription([this]() { Refresh(); })
 {
     SetBackgroundStyle(wxBG_STYLE_PAINT);
     
@@ -123,6 +124,7 @@ void FlatUISystemButtons::PaintButton(wxDC& dc, const wxRect& rect, const wxStri
 
 void FlatUISystemButtons::OnPaint(wxPaintEvent& evt)
 {
+    ThemeSubscription::Recorder themeKeys(m_themeSubscription);
     wxAutoBufferedPaintDC dc(this);
     dc.SetBackground(CFG_COLOUR("BarBgColour"));
     dc.Clear();
@@ -0,0 +1,115 @@
+#include "flatui/FlatUITextExtentCache.h"
+#include "config/ThemeManager.h"
+#include "logger/Logger.h"
+#include <algorithm>
+#include <functional>
+
+namespace {
+    size_t TextExtentCacheEntries()
+    {
+        int entries = ConfigManager::getInstance().getInt("Font", "TextExtentCacheEntries", 4096);
+        return static_cast<size_t>(std::max(entries, 16));
+    }
+
+    uint64_t Fnv1a(const wxString& text, uint64_t hash = 1469598103934665603ULL)
+    {
+        const wxScopedCharBuffer utf8 = text.utf8_str();
+        for (size_t i = 0; i < utf8.length(); ++i) {
+            hash ^= static_cast<uint8_t>(utf8.data()[i]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+}
+
+FlatUITextExtentCache& FlatUITextExtentCache::GetInstance()
+{
+    static FlatUITextExtentCache instance;
+    return instance;
+}
+
+FlatUITextExtentCache::FlatUITextExtentCache()
+    : m_extents(TextExtentCacheEntries())
+{
+    // The default font and sizes come from the theme
+    ThemeManager::getInstance().addThemeChangeListener(this, [this]() {
+        Clear();
+    });
+}
+
+FlatUITextExtentCache::~FlatUITextExtentCache()
+{
+    ThemeManager::getInstance().removeThemeChangeListener(this);
+}
+
+size_t FlatUITextExtentCache::KeyHash::operator()(const Key& key) const
+{
+    size_t hash = std::hash<wxString>()(key.text);
+    return hash ^ (std::hash<uint64_t>()(key.font) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+}
+
+uint64_t FlatUITextExtentCache::GetFontIdentity(const wxFont& font, const wxSize& ppi)
+{
+    // Paint code measures many strings in a row with the same font object
+    if (m_lastFontId != 0 && font.IsSameAs(m_lastFont) && ppi == m_lastPpi) {
+        return m_lastFontId;
+    }
+
+    uint64_t id = Fnv1a(font.GetNativeFontInfoDesc());
+    id = (id ^ static_cast<uint32_t>(ppi.GetWidth())) * 1099511628211ULL;
+    id = (id ^ static_cast<uint32_t>(ppi.GetHeight())) * 1099511628211ULL;
+    m_lastFont = font;
+    m_lastPpi = ppi;
+    m_lastFontId = id != 0 ? id : 1;
+    return m_lastFontId;
+}
+
+wxSize FlatUITextExtentCache::GetTextExtent(wxDC& dc, const wxString& text)
+{
+    const wxFont& font = dc.GetFont();
+    if (!font.IsOk()) {
+        return dc.GetTextExtent(text);
+    }
+
+    Key key{ GetFontIdentity(font, dc.GetPPI()), text };
+    if (const wxSize* cached = m_extents.Find(key)) {
+        return *cached;
+    }
+
+    wxSize extent = dc.GetTextExtent(text);
+    m_extents.Put(key, extent);
+    return extent;
+}
+
+void FlatUITextExtentCache::Clear()
+{
+    m_extents.Clear();
+    m_lastFont = wxNullFont;
+    m_lastPpi = wxSize();
+    m_lastFontId = 0;
+}
+
+FlatUITextExtentCache::Stats FlatUITextExtentCache::GetStats() const
+{
+    auto cacheStats = m_extents.GetStats();
+    Stats stats;
+    stats.hits = cacheStats.hits;
+    stats.misses = cacheStats.misses;
+    stats.evictions = cacheStats.evictions;
+    stats.entries = cacheStats.entries;
+    stats.capacity = cacheStats.budget;
+    return stats;
+}
+
+void FlatUITextExtentCache::ResetStats()
+{
+    m_extents.ResetStats();
+}
+
+void FlatUITextExtentCache::LogStats() const
+{
+    Stats stats = GetStats();
+    LOG_INF(wxString::Format("Text extent cache: %zu/%zu entries, %llu hits, %llu misses (%.1f%% hit ratio), %llu evictions",
+        stats.entries, stats.capacity, (unsigned long long)stats.hits, (unsigned long long)stats.misses,
+        stats.HitRatio() * 100.0, (unsigned long long)stats.evictions), "TextExtentCache");
+}
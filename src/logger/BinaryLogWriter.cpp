@@ -0,0 +1,118 @@
+#include "logger/BinaryLogWriter.h"
+
+namespace {
+    // Buffered bytes are handed to the stream once they pass this size
+    const size_t kBufferHighWater = 64 * 1024;
+}
+
+BinaryLogWriter::~BinaryLogWriter() {
+    Close();
+}
+
+bool BinaryLogWriter::Open(const std::string& path) {
+    Close();
+
+    m_out.open(path, std::ios::out | std::ios::binary | std::ios::app);
+    if (!m_out.is_open()) {
+        return false;
+    }
+
+    m_path = path;
+    m_buffer.clear();
+    m_contextIds.clear();
+    m_siteIds.clear();
+
+    // Header only for a fresh file; appended sessions start with a marker that resets the tables
+    m_out.seekp(0, std::ios::end);
+    std::streamoff existing = m_out.tellp();
+    m_bytesWritten = existing > 0 ? static_cast<uint64_t>(existing) : 0;
+    if (m_bytesWritten == 0) {
+        m_buffer.append(BinaryLog::Magic, sizeof(BinaryLog::Magic));
+        BinaryLog::PutU32(m_buffer, BinaryLog::Version);
+    }
+    BinaryLog::PutU8(m_buffer, static_cast<uint8_t>(BinaryLog::RecordType::SessionStart));
+    Flush();
+    return true;
+}
+
+void BinaryLogWriter::Close() {
+    if (m_out.is_open()) {
+        Flush();
+        m_out.close();
+    }
+}
+
+uint32_t BinaryLogWriter::InternContext(const std::string& context) {
+    if (context.empty()) {
+        return BinaryLog::NoId;
+    }
+
+    auto it = m_contextIds.find(context);
+    if (it != m_contextIds.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(m_contextIds.size());
+    m_contextIds.emplace(context, id);
+    BinaryLog::PutU8(m_buffer, static_cast<uint8_t>(BinaryLog::RecordType::ContextDef));
+    BinaryLog::PutU32(m_buffer, id);
+    BinaryLog::PutBytes(m_buffer, context);
+    return id;
+}
+
+uint32_t BinaryLogWriter::InternSite(const std::string& file, int line) {
+    if (file.empty()) {
+        return BinaryLog::NoId;
+    }
+
+    std::string key = file;
+    key += ':';
+    key += std::to_string(line);
+    auto it = m_siteIds.find(key);
+    if (it != m_siteIds.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(m_siteIds.size());
+    m_siteIds.emplace(std::move(key), id);
+    BinaryLog::PutU8(m_buffer, static_cast<uint8_t>(BinaryLog::RecordType::SiteDef));
+    BinaryLog::PutU32(m_buffer, id);
+    BinaryLog::PutU32(m_buffer, static_cast<uint32_t>(line));
+    BinaryLog::PutBytes(m_buffer, file);
+    return id;
+}
+
+void BinaryLogWriter::Write(uint8_t level, uint64_t timestampNs, const std::string& context,
+                            const std::string& file, int line, const std::string& message) {
+    if (!m_out.is_open()) {
+        return;
+    }
+
+    size_t sizeBefore = m_buffer.size();
+    uint32_t contextId = InternContext(context);
+    uint32_t siteId = InternSite(file, line);
+
+    BinaryLog::PutU8(m_buffer, static_cast<uint8_t>(BinaryLog::RecordType::Entry));
+    BinaryLog::PutU64(m_buffer, timestampNs);
+    BinaryLog::PutU8(m_buffer, level);
+    BinaryLog::PutU32(m_buffer, contextId);
+    BinaryLog::PutU32(m_buffer, siteId);
+    BinaryLog::PutBytes(m_buffer, message);
+    m_bytesWritten += m_buffer.size() - sizeBefore;
+
+    if (m_buffer.size() >= kBufferHighWater) {
+        m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+}
+
+void BinaryLogWriter::Flush() {
+    if (!m_out.is_open()) {
+        return;
+    }
+    if (!m_buffer.empty()) {
+        m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+    m_out.flush();
+}
@@ -1,11 +1,63 @@
 #include "logger/Logger.h"
+#include <wx/filename.h>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
+#include <vector>
+
+namespace {
+    // Upper bound on records formatted per batch so a flood cannot starve the flush timer
+    const size_t kMaxBatchRecords = 512;
+
+    const char* LevelToString(Logger::LogLevel level) {
+        switch (level) {
+        case Logger::LogLevel::INF: return "INF";
+        case Logger::LogLevel::DBG: return "DBG";
+        case Logger::LogLevel::WRN: return "WRN";
+        case Logger::LogLevel::ERR: return "ERR";
+        }
+        return "INF";
+    }
+
+    // Cheaper than std::filesystem::path(file).filename() for __FILE__ strings
+    std::string FileNameOf(const std::string& file) {
+        size_t pos = file.find_last_of("/\\");
+        return pos == std::string::npos ? file : file.substr(pos + 1);
+    }
+
+    // app.log -> app-20240101-120000.log, with a numeric suffix if that name is taken
+    std::filesystem::path ArchiveNameFor(const std::filesystem::path& active, const char* stamp) {
+        std::filesystem::path dir = active.parent_path();
+        std::string stem = active.stem().string();
+        std::string ext = active.extension().string();
+        std::filesystem::path candidate = dir / (stem + "-" + stamp + ext);
+        std::error_code ec;
+        for (int i = 1; std::filesystem::exists(candidate, ec); ++i) {
+            candidate = dir / (stem + "-" + stamp + "-" + std::to_string(i) + ext);
+        }
+        return candidate;
+    }
+
+    // Start of the segment already in an existing log file: its creation time where the
+    // platform records one (the inode change time on Unix), otherwise its last write
+    std::chrono::system_clock::time_point SegmentStartOf(const std::string& path) {
+        wxDateTime modified;
+        wxDateTime created;
+        if (!wxFileName(wxString::FromUTF8(path)).GetTimes(nullptr, &modified, &created)) {
+            return std::chrono::system_clock::now();
+        }
+        const wxDateTime& start = created.IsValid() ? created : modified;
+        if (!start.IsValid()) {
+            return std::chrono::system_clock::now();
+        }
+        return std::chrono::system_clock::from_time_t(start.GetTicks());
+    }
+}
 
 Logger::Logger() : logCtrl(nullptr) {
-    logFile.open("app.log", std::ios::out | std::ios::app);
+    logFile.open(logFilePath, std::ios::out | std::ios::app);
     if (!logFile.is_open()) {
         std::cerr << "Error: Failed to open log file 'app.log'" << std::endl;
         throw std::runtime_error("Failed to open log file");
@@ -22,6 +74,14 @@ Logger::Logger() : logCtrl(nullptr) {
 }
 
 Logger::~Logger() {
+    StopAsync();
+    if (rolloverThread.joinable()) {
+        rolloverThread.join();
+    }
+    if (pruneThread.joinable()) {
+        pruneThread.join();
+    }
+    binaryWriter.Close();
     if (logFile.is_open()) {
         logFile.close();
     }
@@ -58,6 +118,12 @@ void Logger::SetLogLevels(const std::set<LogLevel>& levels, bool isSingleLevel)
         allowedLogLevels.insert(LogLevel::ERR);
     }
 
+    uint32_t mask = 0;
+    for (const auto& lvl : allowedLogLevels) {
+        mask |= 1u << static_cast<unsigned>(lvl);
+    }
+    levelMask.store(mask, std::memory_order_relaxed);
+
     // Log final allowed levels
     std::string levelsStr;
     for (const auto& lvl : allowedLogLevels) {
@@ -72,48 +138,115 @@ void Logger::SetLogLevels(const std::set<LogLevel>& levels, bool isSingleLevel)
 }
 
 bool Logger::ShouldLog(LogLevel level) const {
-    return allowedLogLevels.find(level) != allowedLogLevels.end();
+    return IsLevelEnabled(level);
 }
 
 void Logger::Log(LogLevel level, const std::string& message, const std::string& context, 
                  const std::string& file, int line) {
     if (!ShouldLog(level)) return; // Skip if level is not allowed
 
-    if (!logFile.is_open()) {
-        logFile.open("app.log", std::ios::out | std::ios::app);
-        if (!logFile.is_open()) {
-            std::cerr << "Error: Failed to open log file for writing" << std::endl;
-            return;
+    auto now = std::chrono::system_clock::now();
+    LogRecord record;
+    record.level = level;
+    record.time = std::chrono::system_clock::to_time_t(now);
+    record.timestampNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count());
+    record.message = message;
+    record.context = context;
+    record.file = file;
+    record.line = line;
+
+    if (!EnqueueAsync(record)) {
+        WriteSync(record);
+    }
+}
+
+bool Logger::EnqueueAsync(LogRecord& record) {
+    // Counted so StopAsync() can wait out producers that still saw async mode running.
+    // Both this count and asyncRunning are sequentially consistent: either the producer
+    // sees the stop, or StopAsync() sees the producer.
+    struct ProducerScope {
+        std::atomic<int>& count;
+        explicit ProducerScope(std::atomic<int>& c) : count(c) { count.fetch_add(1); }
+        ~ProducerScope() { count.fetch_sub(1); }
+    } scope(asyncProducers);
+
+    if (!asyncRunning.load()) {
+        return false;
+    }
+
+    uint64_t seenPops = popGeneration.load(std::memory_order_acquire);
+    while (!asyncQueue->TryPush(std::move(record))) {
+        if (overflowPolicy == OverflowPolicy::Drop) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
         }
+        // Block: wake the writer and sleep until it has popped a batch
+        wakeCv.notify_one();
+        {
+            std::unique_lock<std::mutex> lock(spaceMutex);
+            spaceCv.wait(lock, [this, seenPops]() {
+                return popGeneration.load(std::memory_order_acquire) != seenPops || !asyncRunning.load();
+            });
+        }
+        if (!asyncRunning.load()) {
+            return false;
+        }
+        seenPops = popGeneration.load(std::memory_order_acquire);
     }
 
-    std::time_t now = std::time(nullptr);
-    std::tm* timeinfo = std::localtime(&now);
-    char timestamp[20];
-    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", timeinfo);
+    // The writer polls on its flush interval anyway; only nudge it when it is parked
+    if (writerIdle.load(std::memory_order_relaxed)) {
+        wakeCv.notify_one();
+    }
+    return true;
+}
 
-    std::string levelStr;
-    switch (level) {
-    case LogLevel::INF: levelStr = "INF"; break;
-    case LogLevel::DBG: levelStr = "DBG"; break;
-    case LogLevel::WRN: levelStr = "WRN"; break;
-    case LogLevel::ERR: levelStr = "ERR"; break;
+std::string Logger::FormatRecord(const LogRecord& record) {
+    // Timestamps only change once per second, so reuse the last strftime result
+    if (record.time != cachedSecond) {
+        cachedSecond = record.time;
+        std::tm* timeinfo = std::localtime(&record.time);
+        std::strftime(cachedTimestamp, sizeof(cachedTimestamp), "%Y-%m-%d %H:%M:%S", timeinfo);
     }
 
-    std::string contextStr = context.empty() ? "" : "[" + context + "] ";
-    
-    std::string fileInfo;
-    if (!file.empty()) {
-        std::string filename = std::filesystem::path(file).filename().string();
-        fileInfo = " (" + filename + ":" + std::to_string(line) + ")";
+    std::string logMessage;
+    logMessage.reserve(48 + record.context.size() + record.message.size() + record.file.size());
+    logMessage += "[";
+    logMessage += cachedTimestamp;
+    logMessage += "] [";
+    logMessage += LevelToString(record.level);
+    logMessage += "] ";
+    if (!record.context.empty()) {
+        logMessage += "[" + record.context + "] ";
     }
+    logMessage += record.message;
+    if (!record.file.empty()) {
+        logMessage += " (" + FileNameOf(record.file) + ":" + std::to_string(record.line) + ")";
+    }
+    return logMessage;
+}
 
-    std::string logMessage = "[" + std::string(timestamp) + "] [" + levelStr + "] " + 
-                             contextStr + message + fileInfo;
-    
-    logFile << logMessage << std::endl;
-    std::cout << "Logger: " << logMessage << std::endl;
-    logFile.flush();
+void Logger::WriteSync(const LogRecord& record) {
+    std::string logMessage;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        logMessage = FormatRecord(record);
+        if (EnsureTextLogOpen()) {
+            logFile << logMessage << std::endl;
+            logFile.flush();
+            segmentBytes += logMessage.size() + 1;
+        }
+        std::cout << "Logger: " << logMessage << std::endl;
+        if (binaryWriter.IsOpen()) {
+            WriteBinary(record);
+            binaryWriter.Flush();
+        }
+        // The caller is usually the UI thread, so the close/rename/reopen is handed off
+        if (RotationDue() && !rolloverPending) {
+            StartBackgroundRollover();
+        }
+    }
 
     if (isShuttingDown || !logCtrl || !logCtrl->IsShown()) {
         return;
@@ -121,7 +254,358 @@ void Logger::Log(LogLevel level, const std::string& message, const std::string&
     logCtrl->AppendText(logMessage + "\n");
 }
 
+void Logger::WriteBinary(const LogRecord& record) {
+    binaryWriter.Write(static_cast<uint8_t>(record.level), record.timestampNs, record.context,
+                       FileNameOf(record.file), record.line, record.message);
+}
+
+bool Logger::EnableBinarySink(const std::string& path, bool keepTextLog) {
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (!binaryWriter.Open(path)) {
+            std::cerr << "Error: Failed to open binary log file '" << path << "'" << std::endl;
+            return false;
+        }
+        textLogEnabled = keepTextLog;
+    }
+    Log(LogLevel::INF, "Binary log sink enabled, output file: " + path +
+        (keepTextLog ? " (text log kept)" : " (text log disabled)"), "Logger");
+    return true;
+}
+
+bool Logger::EnsureTextLogOpen() {
+    if (!textLogEnabled) {
+        return false;
+    }
+    if (logFile.is_open()) {
+        return true;
+    }
+    if (textLogOpenFailed) {
+        return false;
+    }
+
+    logFile.open(logFilePath, std::ios::out | std::ios::app);
+    if (!logFile.is_open()) {
+        std::cerr << "Error: Failed to open log file for writing" << std::endl;
+        textLogOpenFailed = true;
+        return false;
+    }
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(logFilePath, ec);
+    segmentBytes = ec ? 0 : static_cast<uint64_t>(size);
+    // An empty file is a fresh segment; checking the size also sidesteps Windows file
+    // tunneling, which gives a file re-created under a just-renamed name the old creation time
+    segmentOpenedAt = segmentBytes > 0 ? SegmentStartOf(logFilePath) : std::chrono::system_clock::now();
+    return true;
+}
+
+void Logger::EnableRotation(uint64_t maxBytes, int maxCount, int intervalHours) {
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        maxSegmentBytes = maxBytes;
+        maxSegments = maxCount;
+        rotateInterval = std::chrono::hours(intervalHours > 0 ? intervalHours : 0);
+        rotationEnabled = maxSegmentBytes > 0 || rotateInterval.count() > 0;
+
+        // app.log is appended to across runs, so its age counts from the file, not from startup
+        std::error_code ec;
+        uintmax_t size = std::filesystem::file_size(logFilePath, ec);
+        segmentBytes = ec ? 0 : static_cast<uint64_t>(size);
+        segmentOpenedAt = segmentBytes > 0 ? SegmentStartOf(logFilePath) : std::chrono::system_clock::now();
+    }
+
+    if (rotationEnabled) {
+        Log(LogLevel::INF, "Log rotation enabled, max segment: " + std::to_string(maxBytes) +
+            " bytes, interval: " + std::to_string(intervalHours) + "h, keep: " + std::to_string(maxCount),
+            "Logger");
+    }
+}
+
+bool Logger::RotationDue() const {
+    if (!rotationEnabled) {
+        return false;
+    }
+
+    bool sizeExceeded = maxSegmentBytes > 0 &&
+        (segmentBytes >= maxSegmentBytes ||
+         (binaryWriter.IsOpen() && binaryWriter.GetBytesWritten() >= maxSegmentBytes));
+    bool expired = rotateInterval.count() > 0 &&
+        std::chrono::system_clock::now() - segmentOpenedAt >= rotateInterval;
+    return sizeExceeded || expired;
+}
+
+void Logger::StartBackgroundRollover() {
+    // Nothing may outlive Shutdown(), so the last records roll over in place
+    if (isShuttingDown) {
+        RollOver();
+        return;
+    }
+
+    // A finished rollover has already cleared rolloverPending under writeMutex
+    if (rolloverThread.joinable()) {
+        rolloverThread.join();
+    }
+    rolloverPending = true;
+    rolloverThread = std::thread([this]() {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        RollOver();
+        rolloverPending = false;
+    });
+}
+
+void Logger::RollOver() {
+    std::time_t now = std::time(nullptr);
+    char stamp[20];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+
+    std::error_code ec;
+    if (textLogEnabled) {
+        if (logFile.is_open()) {
+            logFile.flush();
+            logFile.close();
+        }
+        std::filesystem::rename(logFilePath, ArchiveNameFor(logFilePath, stamp), ec);
+        if (ec) {
+            std::cerr << "Error: Failed to archive log segment: " << ec.message() << std::endl;
+        }
+        // Open the next segment right away so the following write does not pay for it
+        textLogOpenFailed = false;
+        EnsureTextLogOpen();
+        segmentBytes = 0;
+    }
+
+    if (binaryWriter.IsOpen()) {
+        std::string binaryPath = binaryWriter.GetPath();
+        binaryWriter.Close();
+        std::filesystem::rename(binaryPath, ArchiveNameFor(binaryPath, stamp), ec);
+        binaryWriter.Open(binaryPath);
+    }
+
+    segmentOpenedAt = std::chrono::system_clock::now();
+
+    if (maxSegments > 0) {
+        // Directory scans and deletes are slow on large log folders; keep them off the caller
+        if (pruneThread.joinable()) {
+            pruneThread.join();
+        }
+        std::vector<std::string> activePaths{ logFilePath };
+        if (binaryWriter.IsOpen()) {
+            activePaths.push_back(binaryWriter.GetPath());
+        }
+        int keep = maxSegments;
+        pruneThread = std::thread([activePaths, keep]() {
+            for (const auto& path : activePaths) {
+                PruneSegments(path, keep);
+            }
+        });
+    }
+}
+
+void Logger::PruneSegments(const std::string& activePath, int keep) {
+    std::filesystem::path active(activePath);
+    std::filesystem::path dir = active.parent_path().empty() ? std::filesystem::path(".") : active.parent_path();
+    std::string prefix = active.stem().string() + "-";
+    std::string ext = active.extension().string();
+
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> segments;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() > prefix.size() + ext.size() &&
+            name.compare(0, prefix.size(), prefix) == 0 &&
+            name.compare(name.size() - ext.size(), ext.size(), ext) == 0) {
+            segments.emplace_back(entry.last_write_time(ec), entry.path());
+        }
+    }
+    if (segments.size() <= static_cast<size_t>(keep)) {
+        return;
+    }
+
+    // Oldest first; names break ties between segments closed within the same tick
+    std::sort(segments.begin(), segments.end());
+    size_t excess = segments.size() - static_cast<size_t>(keep);
+    for (size_t i = 0; i < excess; ++i) {
+        std::filesystem::remove(segments[i].second, ec);
+    }
+}
+
+void Logger::AppendToCtrl(const std::string& text) {
+    // Called from the writer thread; the control may only be touched on the UI thread
+    if (isShuttingDown || !logCtrl || !wxTheApp) {
+        return;
+    }
+    wxTheApp->CallAfter([this, text]() {
+        if (isShuttingDown || !logCtrl || !logCtrl->IsShown()) {
+            return;
+        }
+        logCtrl->AppendText(text);
+    });
+}
+
+void Logger::EnableAsync(size_t queueCapacity, int flushIntervalMs, OverflowPolicy policy) {
+    if (asyncRunning.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    asyncQueue.reset(new LogRingBuffer<LogRecord>(queueCapacity));
+    flushInterval = std::chrono::milliseconds(flushIntervalMs > 0 ? flushIntervalMs : 1);
+    overflowPolicy = policy;
+    droppedCount.store(0, std::memory_order_relaxed);
+    asyncRunning.store(true, std::memory_order_release);
+    writerThread = std::thread(&Logger::WriterLoop, this);
+
+    Log(LogLevel::INF, "Async logging enabled, queue capacity: " + std::to_string(asyncQueue->Capacity()) +
+        ", flush interval: " + std::to_string(flushInterval.count()) + "ms, overflow: " +
+        (policy == OverflowPolicy::Drop ? "drop" : "block"), "Logger");
+}
+
+void Logger::WriterLoop() {
+    std::string fileBatch;
+    std::string consoleBatch;
+    LogRecord record;
+    auto lastFlush = std::chrono::steady_clock::now();
+
+    for (;;) {
+        size_t count = 0;
+        bool needsFlush = false;
+        fileBatch.clear();
+        consoleBatch.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            while (count < kMaxBatchRecords && asyncQueue->TryPop(record)) {
+                std::string line = FormatRecord(record);
+                fileBatch += line;
+                fileBatch += '\n';
+                consoleBatch += "Logger: ";
+                consoleBatch += line;
+                consoleBatch += '\n';
+                if (binaryWriter.IsOpen()) {
+                    WriteBinary(record);
+                }
+                needsFlush = needsFlush || record.level == LogLevel::ERR;
+                ++count;
+            }
+
+            // Producers blocked on a full queue wait for this instead of spinning
+            if (count > 0 && overflowPolicy == OverflowPolicy::Block) {
+                {
+                    std::lock_guard<std::mutex> spaceLock(spaceMutex);
+                    popGeneration.fetch_add(1, std::memory_order_release);
+                }
+                spaceCv.notify_all();
+            }
+
+            uint64_t dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+            if (dropped > 0) {
+                LogRecord notice;
+                notice.level = LogLevel::WRN;
+                auto now = std::chrono::system_clock::now();
+                notice.time = std::chrono::system_clock::to_time_t(now);
+                notice.timestampNs = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count());
+                notice.message = std::to_string(dropped) + " log messages dropped, queue full";
+                notice.context = "Logger";
+                std::string line = FormatRecord(notice);
+                fileBatch += line + "\n";
+                consoleBatch += "Logger: " + line + "\n";
+                if (binaryWriter.IsOpen()) {
+                    WriteBinary(notice);
+                }
+            }
+
+            if (!fileBatch.empty() && EnsureTextLogOpen()) {
+                logFile.write(fileBatch.data(), static_cast<std::streamsize>(fileBatch.size()));
+                segmentBytes += fileBatch.size();
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (needsFlush || now - lastFlush >= flushInterval) {
+                if (logFile.is_open()) {
+                    logFile.flush();
+                }
+                binaryWriter.Flush();
+                lastFlush = now;
+            }
+
+            // Rollover happens here, on the writer thread, when async mode is on
+            if (RotationDue()) {
+                RollOver();
+            }
+        }
+
+        if (!consoleBatch.empty()) {
+            std::cout << consoleBatch;
+            AppendToCtrl(fileBatch);
+        }
+
+        if (count > 0) {
+            continue;
+        }
+        if (!asyncRunning.load(std::memory_order_acquire) && asyncQueue->IsEmpty()) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        writerIdle.store(true, std::memory_order_relaxed);
+        wakeCv.wait_for(lock, flushInterval, [this]() {
+            return !asyncQueue->IsEmpty() || !asyncRunning.load(std::memory_order_acquire);
+        });
+        writerIdle.store(false, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (logFile.is_open()) {
+        logFile.flush();
+    }
+    binaryWriter.Flush();
+    std::cout.flush();
+}
+
+void Logger::StopAsync() {
+    if (!asyncRunning.exchange(false)) {
+        return;
+    }
+    {
+        // Blocked producers re-check asyncRunning and fall back to synchronous writes
+        std::lock_guard<std::mutex> lock(spaceMutex);
+    }
+    spaceCv.notify_all();
+    wakeCv.notify_one();
+
+    // A producer that loaded asyncRunning == true may not have pushed yet; once the count
+    // drops to zero nothing more can enter the queue
+    while (asyncProducers.load() > 0) {
+        std::this_thread::yield();
+    }
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+
+    // Records pushed after the writer's last pass are written here
+    LogRecord record;
+    while (asyncQueue->TryPop(record)) {
+        WriteSync(record);
+    }
+}
+
 void Logger::Shutdown() {
     isShuttingDown = true;
     logCtrl = nullptr;
-}
\ No newline at end of file
+    StopAsync();
+
+    // The rollover thread takes writeMutex itself, so it is joined outside the lock
+    std::thread rollover;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        rollover = std::move(rolloverThread);
+    }
+    if (rollover.joinable()) {
+        rollover.join();
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (pruneThread.joinable()) {
+        pruneThread.join();
+    }
+}
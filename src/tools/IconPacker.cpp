@@ -0,0 +1,93 @@
+// IconPacker: packs every SVG in a directory into a single IconArchive so the
+// application can memory-map its icons with one open at startup. Optional
+// --theme colours add pre-themed variants of every icon for that primary
+// icon colour (same output as SvgColorTemplate::Apply).
+//
+// Usage: IconPacker <svg_dir> <output.pack> [--theme #rrggbb]...
+
+#include "config/IconArchive.h"
+#include "config/SvgColorTemplate.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+    bool NormalizeColour(std::string colour, std::string& normalized) {
+        std::transform(colour.begin(), colour.end(), colour.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (colour.size() != 7 || colour[0] != '#' ||
+            !std::all_of(colour.begin() + 1, colour.end(), [](unsigned char c) { return std::isxdigit(c) != 0; })) {
+            return false;
+        }
+        normalized = colour;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <svg_dir> <output.pack> [--theme #rrggbb]..." << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> themeColours;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string colour;
+        if (arg != "--theme" || i + 1 >= argc || !NormalizeColour(argv[++i], colour)) {
+            std::cerr << "Error: expected --theme #rrggbb, got " << arg << std::endl;
+            return 1;
+        }
+        themeColours.push_back(colour);
+    }
+
+    std::filesystem::path svgDir = std::filesystem::u8path(argv[1]);
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(svgDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".svg") {
+            files.push_back(entry.path());
+        }
+    }
+    if (ec || files.empty()) {
+        std::cerr << "Error: no SVG icons found in " << argv[1] << std::endl;
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    IconArchiveWriter writer;
+    size_t sourceBytes = 0;
+    for (const auto& file : files) {
+        std::ifstream in(file, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (!in.good() && !in.eof()) {
+            std::cerr << "Error: cannot read " << file.u8string() << std::endl;
+            return 1;
+        }
+        sourceBytes += content.size();
+
+        std::string name = file.stem().u8string();
+        if (!themeColours.empty()) {
+            SvgColorTemplate compiled(content);
+            for (const std::string& colour : themeColours) {
+                writer.Add(name, colour, compiled.Apply(colour));
+            }
+        }
+        writer.Add(name, std::string(), std::move(content));
+    }
+
+    std::string error;
+    if (!writer.Write(argv[2], &error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << files.size() << " icons (" << sourceBytes << " bytes of SVG, "
+              << themeColours.size() << " pre-themed variants each) into " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+// LogDecoder: converts a binary log produced by Logger's binary sink back into
+// the same text layout as app.log.
+//
+// Usage: LogDecoder <input.blog> [output.log]
+
+#include "logger/BinaryLogFormat.h"
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    std::string FormatTimestamp(uint64_t timestampNs) {
+        std::time_t seconds = static_cast<std::time_t>(timestampNs / 1000000000ull);
+        unsigned millis = static_cast<unsigned>((timestampNs / 1000000ull) % 1000ull);
+        char buffer[32];
+        std::tm* timeinfo = std::localtime(&seconds);
+        if (!timeinfo || std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo) == 0) {
+            return std::to_string(timestampNs);
+        }
+        char withMillis[40];
+        std::snprintf(withMillis, sizeof(withMillis), "%s.%03u", buffer, millis);
+        return withMillis;
+    }
+
+    struct Site {
+        std::string file;
+        uint32_t line = 0;
+    };
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <input.blog> [output.log]" << std::endl;
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "Error: cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::ofstream outFile;
+    if (argc >= 3) {
+        outFile.open(argv[2], std::ios::out | std::ios::trunc);
+        if (!outFile) {
+            std::cerr << "Error: cannot open " << argv[2] << " for writing" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outFile.is_open() ? static_cast<std::ostream&>(outFile) : std::cout;
+
+    BinaryLog::Reader reader(data.data(), data.size());
+    uint32_t version = 0;
+    if (!reader.ReadMagic() || !reader.ReadU32(version)) {
+        std::cerr << "Error: " << argv[1] << " is not a binary log file" << std::endl;
+        return 1;
+    }
+    if (version != BinaryLog::Version) {
+        std::cerr << "Error: unsupported binary log version " << version << std::endl;
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, std::string> contexts;
+    std::unordered_map<uint32_t, Site> sites;
+    size_t entries = 0;
+    size_t sessions = 0;
+
+    while (!reader.AtEnd()) {
+        size_t recordStart = reader.Position();
+        uint8_t type = 0;
+        bool ok = reader.ReadU8(type);
+
+        switch (static_cast<BinaryLog::RecordType>(type)) {
+        case BinaryLog::RecordType::SessionStart:
+            contexts.clear();
+            sites.clear();
+            ++sessions;
+            break;
+        case BinaryLog::RecordType::ContextDef: {
+            uint32_t id = 0;
+            std::string name;
+            ok = ok && reader.ReadU32(id) && reader.ReadBytes(name);
+            if (ok) contexts[id] = name;
+            break;
+        }
+        case BinaryLog::RecordType::SiteDef: {
+            uint32_t id = 0;
+            Site site;
+            ok = ok && reader.ReadU32(id) && reader.ReadU32(site.line) && reader.ReadBytes(site.file);
+            if (ok) sites[id] = site;
+            break;
+        }
+        case BinaryLog::RecordType::Entry: {
+            uint64_t timestampNs = 0;
+            uint8_t level = 0;
+            uint32_t contextId = 0;
+            uint32_t siteId = 0;
+            std::string message;
+            ok = ok && reader.ReadU64(timestampNs) && reader.ReadU8(level) &&
+                 reader.ReadU32(contextId) && reader.ReadU32(siteId) && reader.ReadBytes(message);
+            if (!ok) break;
+
+            out << "[" << FormatTimestamp(timestampNs) << "] [" << BinaryLog::LevelName(level) << "] ";
+            if (contextId != BinaryLog::NoId) {
+                auto it = contexts.find(contextId);
+                out << "[" << (it != contexts.end() ? it->second : "ctx#" + std::to_string(contextId)) << "] ";
+            }
+            out << message;
+            if (siteId != BinaryLog::NoId) {
+                auto it = sites.find(siteId);
+                if (it != sites.end()) {
+                    out << " (" << it->second.file << ":" << it->second.line << ")";
+                }
+                else {
+                    out << " (site#" << siteId << ")";
+                }
+            }
+            out << '\n';
+            ++entries;
+            break;
+        }
+        default:
+            std::cerr << "Error: unknown record type " << static_cast<int>(type)
+                      << " at offset " << recordStart << std::endl;
+            return 2;
+        }
+
+        if (!ok) {
+            // A crash can leave a partially written tail; everything before it is still valid
+            std::cerr << "Warning: truncated record at offset " << recordStart << ", stopping" << std::endl;
+            break;
+        }
+    }
+
+    std::cerr << "Decoded " << entries << " entries from " << sessions << " session(s)" << std::endl;
+    return 0;
+}
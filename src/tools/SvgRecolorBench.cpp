@@ -0,0 +1,337 @@
+// SvgRecolorBench: compares SvgColorRewriter against the regex passes it replaced
+// in SvgIconManager (ReplaceNonLightColors x2, ReplaceNonLightColorsInStyles,
+// AddDefaultFillToElements/NormalizeSvgStructure) and against pre-compiled
+// SvgColorTemplate slots, checks that all produce the same output for every
+// icon, and reports the time per theme switch.
+//
+// Usage: SvgRecolorBench [icon_dir] [iterations]
+//        icon_dir defaults to config/icons/svg, iterations to 20
+
+#include "config/SvgColorRewriter.h"
+#include "config/SvgColorTemplate.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ---- Legacy regex implementation, kept verbatim apart from wxString -> std::string ----
+
+int LegacyCalculateColorBrightness(const std::string& colorValue)
+{
+    std::string color = colorValue;
+    std::transform(color.begin(), color.end(), color.begin(), ::tolower);
+    color.erase(std::remove_if(color.begin(), color.end(), ::isspace), color.end());
+
+    if (!color.empty() && color[0] == '#') {
+        std::string hex = color.substr(1);
+        if (hex.length() == 3) {
+            hex = std::string(1, hex[0]) + hex[0] + hex[1] + hex[1] + hex[2] + hex[2];
+        }
+        if (hex.length() == 6) {
+            try {
+                int r = std::stoi(hex.substr(0, 2), nullptr, 16);
+                int g = std::stoi(hex.substr(2, 2), nullptr, 16);
+                int b = std::stoi(hex.substr(4, 2), nullptr, 16);
+                return static_cast<int>(0.299 * r + 0.587 * g + 0.114 * b);
+            } catch (...) {
+                return -1;
+            }
+        }
+    }
+
+    std::regex rgbRegex("rgba?\\((\\d+),(\\d+),(\\d+)(?:,[\\d.]+)?\\)");
+    std::smatch match;
+    if (std::regex_match(color, match, rgbRegex)) {
+        try {
+            int r = std::stoi(match[1].str());
+            int g = std::stoi(match[2].str());
+            int b = std::stoi(match[3].str());
+            return static_cast<int>(0.299 * r + 0.587 * g + 0.114 * b);
+        } catch (...) {
+            return -1;
+        }
+    }
+
+    if (color == "white") return 255;
+    if (color == "black") return 0;
+    if (color == "gray" || color == "grey") return 128;
+    if (color == "lightgray" || color == "lightgrey" || color == "silver") return 192;
+    if (color == "darkgray" || color == "darkgrey") return 64;
+    return -1;
+}
+
+bool LegacyShouldReplaceColor(const std::string& colorValue)
+{
+    int brightness = LegacyCalculateColorBrightness(colorValue);
+    if (brightness < 0) {
+        std::string lowerColor = colorValue;
+        std::transform(lowerColor.begin(), lowerColor.end(), lowerColor.begin(), ::tolower);
+        if (lowerColor == "white" || lowerColor == "#fff" || lowerColor == "#ffffff" ||
+            lowerColor == "transparent" || lowerColor == "none" ||
+            lowerColor.find("lightgray") != std::string::npos || lowerColor.find("lightgrey") != std::string::npos ||
+            lowerColor.find("silver") != std::string::npos) {
+            return false;
+        }
+        return true;
+    }
+    return brightness <= 180;
+}
+
+std::string LegacyReplaceNonLightColors(const std::string& contentStr, const std::string& attribute, const std::string& targetColor)
+{
+    std::regex attrRegex(attribute + "=\"([^\"]+)\"", std::regex_constants::icase);
+    std::string resultStr;
+    std::sregex_iterator iter(contentStr.begin(), contentStr.end(), attrRegex);
+    std::sregex_iterator end;
+    size_t lastPos = 0;
+    while (iter != end) {
+        std::smatch match = *iter;
+        resultStr += contentStr.substr(lastPos, match.position() - lastPos);
+        if (LegacyShouldReplaceColor(match[1].str())) {
+            resultStr += attribute + "=\"" + targetColor + "\"";
+        } else {
+            resultStr += match.str();
+        }
+        lastPos = match.position() + match.length();
+        ++iter;
+    }
+    resultStr += contentStr.substr(lastPos);
+    return resultStr;
+}
+
+std::string LegacyReplaceNonLightColorsInStyles(const std::string& contentStr, const std::string& targetColor)
+{
+    std::regex styleRegex("style=\"([^\"]*)\"", std::regex_constants::icase);
+    std::string resultStr;
+    std::sregex_iterator iter(contentStr.begin(), contentStr.end(), styleRegex);
+    std::sregex_iterator end;
+    size_t lastPos = 0;
+    while (iter != end) {
+        std::smatch match = *iter;
+        std::string styleValue = match[1].str();
+
+        std::regex fillRegex("fill\\s*:\\s*([^;]+)", std::regex_constants::icase);
+        std::smatch fillMatch;
+        if (std::regex_search(styleValue, fillMatch, fillRegex) && LegacyShouldReplaceColor(fillMatch[1].str())) {
+            styleValue = std::regex_replace(styleValue, fillRegex, "fill:" + targetColor);
+        }
+
+        std::regex strokeRegex("stroke\\s*:\\s*([^;]+)", std::regex_constants::icase);
+        std::smatch strokeMatch;
+        if (std::regex_search(styleValue, strokeMatch, strokeRegex) && LegacyShouldReplaceColor(strokeMatch[1].str())) {
+            styleValue = std::regex_replace(styleValue, strokeRegex, "stroke:" + targetColor);
+        }
+
+        resultStr += contentStr.substr(lastPos, match.position() - lastPos);
+        resultStr += "style=\"" + styleValue + "\"";
+        lastPos = match.position() + match.length();
+        ++iter;
+    }
+    resultStr += contentStr.substr(lastPos);
+    return resultStr;
+}
+
+std::string LegacyNormalizeSvgStructure(const std::string& content)
+{
+    std::regex directPathRegex("<svg[^>]*>\\s*<path", std::regex_constants::icase);
+    if (!std::regex_search(content, directPathRegex)) {
+        return content;
+    }
+    std::regex svgOpenRegex("<svg([^>]*)>", std::regex_constants::icase);
+    std::smatch svgMatch;
+    if (!std::regex_search(content, svgMatch, svgOpenRegex)) {
+        return content;
+    }
+    size_t svgEndPos = svgMatch.position() + svgMatch.length();
+    std::regex svgCloseRegex("</svg>", std::regex_constants::icase);
+    std::smatch closeMatch;
+    std::string remaining = content.substr(svgEndPos);
+    if (!std::regex_search(remaining, closeMatch, svgCloseRegex)) {
+        return content;
+    }
+    size_t closeStartPos = svgEndPos + closeMatch.position();
+    std::string svgInnerContent = content.substr(svgEndPos, closeMatch.position());
+    std::regex unwrappedPathRegex("(?!.*<g[^>]*>.*)<path[^>]*>", std::regex_constants::icase);
+    if (!std::regex_search(svgInnerContent, unwrappedPathRegex)) {
+        return content;
+    }
+    return content.substr(0, svgEndPos) + "<g>" + svgInnerContent + "</g>" + content.substr(closeStartPos);
+}
+
+std::string LegacyAddDefaultFillToElements(const std::string& svgContent, const std::string& defaultColor)
+{
+    std::string content = LegacyNormalizeSvgStructure(svgContent);
+    std::regex groupRegex("<g(\\s+[^>]*?)?>", std::regex_constants::icase);
+    std::string result;
+    std::sregex_iterator iter(content.begin(), content.end(), groupRegex);
+    std::sregex_iterator end;
+    size_t lastPos = 0;
+    while (iter != end) {
+        std::smatch match = *iter;
+        std::string groupTag = match.str();
+        if (groupTag.find("fill=") == std::string::npos && groupTag.find("stroke=") == std::string::npos) {
+            size_t insertPos = groupTag.find_last_of('>');
+            if (insertPos != std::string::npos) {
+                groupTag.insert(insertPos, " fill=\"" + defaultColor + "\"");
+            }
+        }
+        result += content.substr(lastPos, match.position() - lastPos);
+        result += groupTag;
+        lastPos = match.position() + match.length();
+        ++iter;
+    }
+    result += content.substr(lastPos);
+    return result;
+}
+
+std::string LegacyApplyDirectThemeColors(const std::string& svgContent, const std::string& primaryIconColor)
+{
+    std::string themedContent = LegacyReplaceNonLightColors(svgContent, "fill", primaryIconColor);
+    themedContent = LegacyReplaceNonLightColors(themedContent, "stroke", primaryIconColor);
+    themedContent = LegacyReplaceNonLightColorsInStyles(themedContent, primaryIconColor);
+    return LegacyAddDefaultFillToElements(themedContent, primaryIconColor);
+}
+
+// ---- Benchmark driver ----
+
+struct Icon {
+    std::string name;
+    std::string content;
+};
+
+std::vector<Icon> LoadIcons(const std::filesystem::path& dir)
+{
+    std::vector<Icon> icons;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (entry.path().extension() != ".svg") continue;
+        std::ifstream in(entry.path(), std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        icons.push_back({ entry.path().stem().string(), std::move(content) });
+    }
+    std::sort(icons.begin(), icons.end(), [](const Icon& a, const Icon& b) { return a.name < b.name; });
+    return icons;
+}
+
+// The regex path inserts the default fill after the '/' of a self-closing <g .../>,
+// producing "/ fill=\"c\">". The rewriter emits the well-formed " fill=\"c\"/>",
+// so fold the legacy defect before comparing.
+std::string FixLegacySelfClosingGroups(std::string content, const std::string& colour)
+{
+    const std::string broken = "/ fill=\"" + colour + "\">";
+    const std::string fixed = " fill=\"" + colour + "\"/>";
+    for (size_t pos = content.find(broken); pos != std::string::npos; pos = content.find(broken, pos + fixed.size())) {
+        content.replace(pos, broken.size(), fixed);
+    }
+    return content;
+}
+
+template <typename Fn>
+double TimeMs(int iterations, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::filesystem::path iconDir = argc > 1 ? argv[1] : "config/icons/svg";
+    int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 20;
+
+    std::vector<Icon> icons = LoadIcons(iconDir);
+    if (icons.empty()) {
+        std::cerr << "Error: no SVG icons found in " << iconDir.string() << std::endl;
+        return 1;
+    }
+
+    // Primary icon colours of the default, dark and blue themes in config.ini
+    const std::vector<std::string> themeColours = { "#646464", "#f0f0f0", "#46465a" };
+
+    std::vector<SvgColorTemplate> templates;
+    double compileMs = TimeMs(1, [&]() {
+        for (const Icon& icon : icons) {
+            templates.emplace_back(icon.content);
+        }
+    });
+
+    // Equivalence check over every icon and theme
+    size_t mismatches = 0;
+    for (const std::string& colour : themeColours) {
+        SvgColorRewriter rewriter(colour);
+        for (size_t index = 0; index < icons.size(); ++index) {
+            const Icon& icon = icons[index];
+            std::string legacy = FixLegacySelfClosingGroups(LegacyApplyDirectThemeColors(icon.content, colour), colour);
+            std::string rewritten = rewriter.Rewrite(icon.content);
+            if (legacy != rewritten) {
+                ++mismatches;
+                size_t diff = 0;
+                while (diff < legacy.size() && diff < rewritten.size() && legacy[diff] == rewritten[diff]) ++diff;
+                size_t from = diff > 40 ? diff - 40 : 0;
+                std::cout << "MISMATCH " << icon.name << " (" << colour << ") at byte " << diff << "\n"
+                          << "  legacy:    " << legacy.substr(from, 100) << "\n"
+                          << "  rewritten: " << rewritten.substr(from, 100) << "\n";
+            }
+            if (templates[index].Apply(colour) != rewritten) {
+                ++mismatches;
+                std::cout << "MISMATCH " << icon.name << " (" << colour << ") between template and rewriter\n";
+            }
+        }
+    }
+
+    // One "theme switch" recolours every icon once for one theme
+    size_t sink = 0;
+    double legacyMs = TimeMs(iterations, [&]() {
+        for (const std::string& colour : themeColours) {
+            for (const Icon& icon : icons) {
+                sink += LegacyApplyDirectThemeColors(icon.content, colour).size();
+            }
+        }
+    }) / themeColours.size();
+
+    double rewriterMs = TimeMs(iterations, [&]() {
+        for (const std::string& colour : themeColours) {
+            SvgColorRewriter rewriter(colour);
+            for (const Icon& icon : icons) {
+                sink += rewriter.Rewrite(icon.content).size();
+            }
+        }
+    }) / themeColours.size();
+
+    double templateMs = TimeMs(iterations, [&]() {
+        for (const std::string& colour : themeColours) {
+            for (const SvgColorTemplate& compiled : templates) {
+                sink += compiled.Apply(colour).size();
+            }
+        }
+    }) / themeColours.size();
+
+    std::ostringstream report;
+    report.setf(std::ios::fixed);
+    report.precision(3);
+    report << "Icons: " << icons.size() << ", themes: " << themeColours.size()
+           << ", iterations: " << iterations << "\n"
+           << "Regex passes:     " << legacyMs << " ms per theme switch\n"
+           << "SvgColorRewriter: " << rewriterMs << " ms per theme switch\n"
+           << "SvgColorTemplate: " << templateMs << " ms per theme switch ("
+           << templateMs * 1000.0 / icons.size() << " us per icon, one-time compile " << compileMs << " ms)\n"
+           << "Speedup:          " << (rewriterMs > 0.0 ? legacyMs / rewriterMs : 0.0) << "x rewriter, "
+           << (templateMs > 0.0 ? legacyMs / templateMs : 0.0) << "x template\n"
+           << "Output mismatches: " << mismatches << " (checksum " << sink % 997 << ")\n";
+    std::cout << report.str();
+
+    return mismatches == 0 ? 0 : 2;
+}
@@ -0,0 +1,275 @@
+// ThemeParseBench: compares the ThemeValueParser based theme loading against the
+// istringstream splitString/parseColour code it replaced in ThemeManager. Theme
+// sections of config.ini are replicated until the requested key count is
+// reached, both parsers are checked for identical results, and the time per
+// full theme load is reported.
+//
+// Usage: ThemeParseBench [config.ini] [keys] [iterations]
+//        config.ini defaults to config/config.ini, keys to 10000, iterations to 20
+
+#include "config/ThemeValueParser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+struct Entry {
+    std::string section;
+    std::string key;
+    std::string value;
+};
+
+struct Rgb {
+    int r;
+    int g;
+    int b;
+
+    bool operator==(const Rgb& other) const { return r == other.r && g == other.g && b == other.b; }
+};
+
+// Per-theme result of one load: colours and ints keyed by entry index
+struct LoadResult {
+    std::vector<std::map<size_t, Rgb>> colours = std::vector<std::map<size_t, Rgb>>(3);
+    std::map<size_t, int> integers;
+
+    bool operator==(const LoadResult& other) const { return colours == other.colours && integers == other.integers; }
+};
+
+const char* const kColourSections[] = { "ThemeColors", "SvgTheme" };
+const char* const kSizeSections[] = {
+    "BarSizes", "ButtonBarSizes", "Separators", "Icons",
+    "GallerySizes", "PanelSizes", "HomeSpace", "HomeMenu"
+};
+
+bool IsColourSection(const std::string& section)
+{
+    return std::find(std::begin(kColourSections), std::end(kColourSections), section) != std::end(kColourSections);
+}
+
+bool IsSizeSection(const std::string& section)
+{
+    return std::find(std::begin(kSizeSections), std::end(kSizeSections), section) != std::end(kSizeSections);
+}
+
+// Minimal INI reader for the theme sections; wxFileConfig is not needed to time the value parsing
+std::vector<Entry> LoadThemeEntries(const std::string& path)
+{
+    std::vector<Entry> entries;
+    std::ifstream in(path);
+    std::string line;
+    std::string section;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::string_view trimmed = ThemeValueParser::Trim(line);
+        if (trimmed.empty() || trimmed[0] == '#' || trimmed[0] == ';') {
+            continue;
+        }
+        if (trimmed.front() == '[' && trimmed.back() == ']') {
+            section = std::string(trimmed.substr(1, trimmed.size() - 2));
+            continue;
+        }
+        size_t equals = trimmed.find('=');
+        if (equals == std::string_view::npos || !(IsColourSection(section) || IsSizeSection(section))) {
+            continue;
+        }
+        entries.push_back({ section, std::string(ThemeValueParser::Trim(trimmed.substr(0, equals))),
+                            std::string(ThemeValueParser::Trim(trimmed.substr(equals + 1))) });
+    }
+    return entries;
+}
+
+// ---- Legacy istringstream implementation from ThemeManager ----
+
+std::vector<std::string> LegacySplitString(const std::string& str, char delimiter)
+{
+    std::vector<std::string> tokens;
+    std::string token;
+    std::istringstream tokenStream(str);
+
+    while (std::getline(tokenStream, token, delimiter)) {
+        token.erase(0, token.find_first_not_of(" \t"));
+        token.erase(token.find_last_not_of(" \t") + 1);
+        tokens.push_back(token);
+    }
+
+    return tokens;
+}
+
+bool LegacyParseColour(const std::string& value, Rgb& rgb)
+{
+    if (value.empty()) return false;
+
+    std::istringstream ss(value);
+    int r, g, b;
+    char comma;
+
+    if (ss >> r >> comma >> g >> comma >> b) {
+        if (r >= 0 && r <= 255 && g >= 0 && g <= 255 && b >= 0 && b <= 255) {
+            rgb = { r, g, b };
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LegacyParseInt(const std::string& value, int& result)
+{
+    std::istringstream ss(value);
+    int parsed;
+    if (!(ss >> parsed) || !(ss >> std::ws).eof()) {
+        return false;
+    }
+    result = parsed;
+    return true;
+}
+
+LoadResult LegacyLoad(const std::vector<Entry>& entries)
+{
+    LoadResult result;
+    for (size_t index = 0; index < entries.size(); ++index) {
+        const Entry& entry = entries[index];
+        if (IsSizeSection(entry.section)) {
+            int value;
+            if (LegacyParseInt(entry.value, value) && value != 0) {
+                result.integers[index] = value;
+            }
+            continue;
+        }
+        std::vector<std::string> themeValues = LegacySplitString(entry.value, ';');
+        if (themeValues.size() < 3) {
+            continue;
+        }
+        for (int theme = 0; theme < 3; ++theme) {
+            Rgb rgb;
+            if (LegacyParseColour(themeValues[theme], rgb)) {
+                result.colours[theme][index] = rgb;
+            }
+        }
+    }
+    return result;
+}
+
+// ---- ThemeValueParser, as used by ThemeManager::loadBuiltinThemes ----
+
+LoadResult ParserLoad(const std::vector<Entry>& entries)
+{
+    LoadResult result;
+    for (size_t index = 0; index < entries.size(); ++index) {
+        const Entry& entry = entries[index];
+        if (IsSizeSection(entry.section)) {
+            int value = 0;
+            if (ThemeValueParser::ParseInt(entry.value, value) && value != 0) {
+                result.integers[index] = value;
+            }
+            continue;
+        }
+        std::string_view themeValues[3];
+        if (ThemeValueParser::Split(entry.value, ';', themeValues, 3) < 3) {
+            continue;
+        }
+        for (int theme = 0; theme < 3; ++theme) {
+            ThemeValueParser::Rgb rgb;
+            if (ThemeValueParser::ParseRgb(themeValues[theme], rgb)) {
+                result.colours[theme][index] = { rgb.r, rgb.g, rgb.b };
+            }
+        }
+    }
+    return result;
+}
+
+template <typename Fn>
+double TimeMs(int iterations, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string configPath = argc > 1 ? argv[1] : "config/config.ini";
+    size_t keyCount = argc > 2 ? static_cast<size_t>(std::max(1, std::atoi(argv[2]))) : 10000;
+    int iterations = argc > 3 ? std::max(1, std::atoi(argv[3])) : 20;
+
+    std::vector<Entry> original = LoadThemeEntries(configPath);
+    if (original.empty()) {
+        std::cerr << "Error: no theme entries found in " << configPath << std::endl;
+        return 1;
+    }
+
+    // Scale up by cloning the real entries under suffixed keys, so the value mix stays realistic
+    std::vector<Entry> entries;
+    entries.reserve(keyCount);
+    for (size_t copy = 0; entries.size() < keyCount; ++copy) {
+        for (const Entry& entry : original) {
+            if (entries.size() == keyCount) {
+                break;
+            }
+            entries.push_back({ entry.section, copy == 0 ? entry.key : entry.key + "_" + std::to_string(copy), entry.value });
+        }
+    }
+
+    // Edge cases the two parsers must agree on, checked once
+    const std::vector<Entry> edgeCases = {
+        { "ThemeColors", "Spaces", " 1 , 2 , 3 ; 4,5,6 ;7,8,9 " },
+        { "ThemeColors", "TrailingDelimiter", "1,2,3;4,5,6;7,8,9;" },
+        { "ThemeColors", "TooFew", "1,2,3;4,5,6" },
+        { "ThemeColors", "OutOfRange", "256,0,0;-1,0,0;0,0,255" },
+        { "ThemeColors", "Signs", "+1,+2,+3;+-1,2,3;1;2;3" },
+        { "ThemeColors", "Garbage", "abc;1 2 3;1,2,3x" },
+        { "ThemeColors", "Overflow", "99999999999,0,0;0,0,0;0,0,0" },
+        { "BarSizes", "Padded", "  42  " },
+        { "BarSizes", "Suffix", "42px" },
+        { "BarSizes", "Negative", "-7" },
+        { "BarSizes", "Empty", "" }
+    };
+    size_t mismatches = 0;
+    if (!(LegacyLoad(edgeCases) == ParserLoad(edgeCases))) {
+        ++mismatches;
+        std::cout << "MISMATCH in edge cases\n";
+    }
+    if (!(LegacyLoad(entries) == ParserLoad(entries))) {
+        ++mismatches;
+        std::cout << "MISMATCH in scaled config entries\n";
+    }
+
+    size_t sink = 0;
+    double legacyMs = TimeMs(iterations, [&]() {
+        LoadResult result = LegacyLoad(entries);
+        sink += result.integers.size() + result.colours[0].size();
+    });
+    double parserMs = TimeMs(iterations, [&]() {
+        LoadResult result = ParserLoad(entries);
+        sink += result.integers.size() + result.colours[0].size();
+    });
+
+    std::ostringstream report;
+    report.setf(std::ios::fixed);
+    report.precision(3);
+    report << "Config: " << configPath << ", source entries: " << original.size()
+           << ", scaled keys: " << entries.size() << ", iterations: " << iterations << "\n"
+           << "istringstream:    " << legacyMs << " ms per theme load ("
+           << legacyMs * 1000.0 / entries.size() << " us per key)\n"
+           << "ThemeValueParser: " << parserMs << " ms per theme load ("
+           << parserMs * 1000.0 / entries.size() << " us per key)\n"
+           << "Speedup:          " << (parserMs > 0.0 ? legacyMs / parserMs : 0.0) << "x\n"
+           << "Result mismatches: " << mismatches << " (checksum " << sink % 997 << ")\n";
+    std::cout << report.str();
+
+    return mismatches == 0 ? 0 : 2;
+}